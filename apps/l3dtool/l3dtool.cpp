@@ -10,8 +10,12 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <stack>
 #include <string>
 
@@ -581,6 +585,7 @@ struct Arguments
 		ExtraMetrics,
 		Write,
 		Extract,
+		Benchmark,
 	};
 	Mode mode;
 	struct Read
@@ -597,6 +602,11 @@ struct Arguments
 		std::filesystem::path inFilename;
 		std::filesystem::path gltfFile;
 	} extract;
+	struct Benchmark
+	{
+		std::vector<std::filesystem::path> filenames;
+		uint32_t iterations;
+	} benchmark;
 };
 
 namespace details
@@ -1252,6 +1262,58 @@ int ExtractFile(const Arguments::Extract& args) noexcept
 	return EXIT_SUCCESS;
 }
 
+int Benchmark(const Arguments::Benchmark& args) noexcept
+{
+	int returnCode = EXIT_SUCCESS;
+	for (const auto& filename : args.filenames)
+	{
+		try
+		{
+			std::ifstream stream(filename, std::ios::binary);
+			if (!stream.is_open())
+			{
+				throw std::runtime_error("Could not open file " + filename.string());
+			}
+			const std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+			// Time each reader over the same buffer, already in memory like a pack block
+			bool isView = false;
+			const auto time = [&args, &buffer, &isView](bool view) {
+				const auto start = std::chrono::steady_clock::now();
+				for (uint32_t i = 0; i < args.iterations; ++i)
+				{
+					openblack::l3d::L3DFile l3d;
+					if (view)
+					{
+						l3d.OpenView(buffer);
+						isView = l3d.IsView();
+					}
+					else
+					{
+						l3d.Open(buffer);
+					}
+				}
+				const std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+				return duration.count() / std::max(args.iterations, 1u);
+			};
+			const auto streamTime = time(false);
+			const auto viewTime = time(true);
+
+			std::printf("file: %s (%zu bytes, %u iterations)\n", filename.string().c_str(), buffer.size(), args.iterations);
+			std::printf("  stream: %10.3f us\n", streamTime);
+			std::printf("  view:   %10.3f us%s\n", viewTime, isView ? "" : " (not contiguous, copied)");
+			std::printf("  speedup: %.2fx\n", viewTime > 0.0 ? streamTime / viewTime : 0.0);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << e.what() << '\n';
+			returnCode |= EXIT_FAILURE;
+		}
+	}
+
+	return returnCode;
+}
+
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
 	cxxopts::Options options("l3dtool", "Inspect and extract files from LionHead L3D files.");
@@ -1262,7 +1324,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		    ("h,help", "Display this help message.")                     //
 		    ("subcommand", "Subcommand.", cxxopts::value<std::string>()) //
 		    ;
-		options.positional_help("[read|write|extract] [OPTION...]");
+		options.positional_help("[read|write|extract|benchmark] [OPTION...]");
 		options.add_options("read")                                                                                       //
 		    ("H,header", "Print Header Contents.", cxxopts::value<std::vector<std::filesystem::path>>())                  //
 		    ("m,mesh-header", "Print Mesh Headers.", cxxopts::value<std::vector<std::filesystem::path>>())                //
@@ -1283,6 +1345,10 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		    ("o,output", "Output file (required).", cxxopts::value<std::filesystem::path>())    //
 		    ("i,input-mesh", "Input file (required).", cxxopts::value<std::filesystem::path>()) //
 		    ;
+		options.add_options("benchmark the stream and view readers")                                       //
+		    ("files", "Files to parse.", cxxopts::value<std::vector<std::filesystem::path>>())             //
+		    ("iterations", "Times each file is parsed.", cxxopts::value<uint32_t>()->default_value("100")) //
+		    ;
 
 		options.parse_positional({"subcommand"});
 	}
@@ -1423,6 +1489,16 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 				return true;
 			}
 		}
+		else if (result["subcommand"].as<std::string>() == "benchmark")
+		{
+			if (result["files"].count() > 0)
+			{
+				args.mode = Arguments::Mode::Benchmark;
+				args.benchmark.filenames = result["files"].as<std::vector<std::filesystem::path>>();
+				args.benchmark.iterations = result["iterations"].as<uint32_t>();
+				return true;
+			}
+		}
 	}
 	catch (const std::exception& err)
 	{
@@ -1453,6 +1529,11 @@ int main(int argc, char* argv[]) noexcept
 		return ExtractFile(args.extract);
 	}
 
+	if (args.mode == Arguments::Mode::Benchmark)
+	{
+		return Benchmark(args.benchmark);
+	}
+
 	for (auto& filename : args.read.filenames)
 	{
 		openblack::l3d::L3DFile l3d;
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <string>
 
+#include <LNDCompressedMaterialFile.h>
 #include <LNDFile.h>
 #include <cxxopts.hpp>
 
@@ -28,6 +29,7 @@ struct Arguments
 		Extra,
 		Unaccounted,
 		Write,
+		Compress,
 	};
 	Mode mode;
 	struct Read
@@ -42,6 +44,11 @@ struct Arguments
 		std::filesystem::path bumpMapFile;
 		std::vector<std::filesystem::path> materialArray;
 	} write;
+	struct Compress
+	{
+		std::filesystem::path inFilename;
+		std::filesystem::path outFilename;
+	} compress;
 };
 
 int PrintRawBytes(const void* data, std::size_t size)
@@ -508,6 +515,33 @@ int WriteFile(const Arguments::Write& args) noexcept
 	return EXIT_SUCCESS;
 }
 
+int CompressFile(const Arguments::Compress& args) noexcept
+{
+	try
+	{
+		openblack::lnd::LNDFile lnd;
+		lnd.Open(args.inFilename);
+
+		openblack::lnd::LNDCompressedMaterialFile compressed;
+		compressed.Compress(lnd.GetMaterials());
+		compressed.Write(args.outFilename);
+
+		std::printf("file: %s\n", args.outFilename.string().c_str());
+		std::printf("materials: %u\n", compressed.GetHeader().materialCount);
+		std::printf("mips: %u\n", compressed.GetHeader().mipCount);
+		std::printf("source hash: 0x%016llX\n", static_cast<unsigned long long>(compressed.GetHeader().sourceHash));
+		std::printf("size: %zu bytes (from %zu)\n", compressed.GetBlocks().size(),
+		            lnd.GetMaterials().size() * sizeof(lnd.GetMaterials()[0].texels));
+	}
+	catch (std::exception& err)
+	{
+		std::cerr << err.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
 	cxxopts::Options options("lndtool", "Inspect and extract files from LionHead LND files.");
@@ -518,7 +552,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		    ("h,help", "Display this help message.")                     //
 		    ("subcommand", "Subcommand.", cxxopts::value<std::string>()) //
 		    ;
-		options.positional_help("[read|write] [OPTION...]");
+		options.positional_help("[read|write|compress] [OPTION...]");
 		options.add_options("read")                                                                                     //
 		    ("H,header", "Print Header Contents.", cxxopts::value<std::vector<std::filesystem::path>>())                //
 		    ("l,low-resolution-textures", "Print Low Resolution Texture Contents.",                                     //
@@ -537,6 +571,12 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		    ("material-array", "Files with BGBRA1 bytes for material array (comma-separated).",         //
 		     cxxopts::value<std::vector<std::filesystem::path>>())                                      //
 		    ;
+		options.add_options("compress")                                                                          //
+		    ("i,input", "LND file whose materials are compressed (required).",                                   //
+		     cxxopts::value<std::filesystem::path>())                                                            //
+		    ("compressed-output", "Output file, defaults to the input with a .lndc extension.",                  //
+		     cxxopts::value<std::filesystem::path>())                                                            //
+		    ;
 
 		options.parse_positional({"subcommand"});
 	}
@@ -630,6 +670,21 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 				return true;
 			}
 		}
+		else if (result["subcommand"].as<std::string>() == "compress")
+		{
+			if (result["input"].count() > 0)
+			{
+				args.mode = Arguments::Mode::Compress;
+				args.compress.inFilename = result["input"].as<std::filesystem::path>();
+				args.compress.outFilename = args.compress.inFilename;
+				args.compress.outFilename.replace_extension(".lndc");
+				if (result["compressed-output"].count() > 0)
+				{
+					args.compress.outFilename = result["compressed-output"].as<std::filesystem::path>();
+				}
+				return true;
+			}
+		}
 	}
 	catch (const std::exception& err)
 	{
@@ -654,6 +709,10 @@ int main(int argc, char* argv[]) noexcept
 	{
 		return WriteFile(args.write);
 	}
+	if (args.mode == Arguments::Mode::Compress)
+	{
+		return CompressFile(args.compress);
+	}
 
 	for (auto& filename : args.read.filenames)
 	{
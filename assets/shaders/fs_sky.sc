@@ -3,34 +3,31 @@ $input v_position, v_texcoord0, v_normal
 #include <bgfx_shader.sh>
 
 SAMPLER2DARRAY(s_diffuse, 0);
+// x: time of day type, y: alignment, relative to the first layer
+// z: number of types, w: number of alignments in the texture array
 uniform vec4 u_typeAlignment;
 
 void main()
 {
-	// constants
-	const float nightIndex = 0.0f;
-	const float duskIndex = 1.0f;
-	const float dayIndex = 2.0f;
-	const float evilIndex = 0.0f;
-	const float neutralIndex = 1.0f;
-	const float goodIndex = 2.0f;
-
 	// unpack uniform
-	float textureType = clamp(u_typeAlignment.x, nightIndex, dayIndex);
-	float alignment = clamp(u_typeAlignment.y, evilIndex, goodIndex);
+	float typeCount = u_typeAlignment.z;
+	float lastType = typeCount - 1.0f;
+	float lastAlignment = u_typeAlignment.w - 1.0f;
+	float textureType = clamp(u_typeAlignment.x, 0.0f, lastType);
+	float alignment = clamp(u_typeAlignment.y, 0.0f, lastAlignment);
 
 	float alignT = mod(alignment, 1.0f);
 	float alignA = alignment - alignT;
-	float alignB = min(alignA + 1.0f, goodIndex);
+	float alignB = min(alignA + 1.0f, lastAlignment);
 
 	float typeT = mod(textureType, 1.0f);
 	float typeA = textureType - typeT;
-	float typeB = min(typeA + 1.0f, dayIndex);
+	float typeB = min(typeA + 1.0f, lastType);
 
-	float indexAA = 3.0f * alignA + typeA;
-	float indexAB = 3.0f * alignA + typeB;
-	float indexBA = 3.0f * alignB + typeA;
-	float indexBB = 3.0f * alignB + typeB;
+	float indexAA = typeCount * alignA + typeA;
+	float indexAB = typeCount * alignA + typeB;
+	float indexBA = typeCount * alignB + typeA;
+	float indexBB = typeCount * alignB + typeB;
 
 	vec4 colorAA = texture2DArray(s_diffuse, vec3(v_texcoord0.xy, indexAA));
 	vec4 colorAB = texture2DArray(s_diffuse, vec3(v_texcoord0.xy, indexAB));
@@ -291,22 +291,52 @@ class L3DFile
 	std::vector<L3DVertexGroup> _vertexGroups;
 	std::vector<L3DBlend> _blends;
 	std::vector<L3DBone> _bones;
-	std::vector<std::span<L3DPrimitiveHeader>> _primitiveSpans;
-	std::vector<std::span<L3DVertex>> _vertexSpans;
-	std::vector<std::span<uint16_t>> _indexSpans;
-	std::vector<std::span<L3DVertexGroup>> _vertexGroupSpans;
-	std::vector<std::span<L3DBone>> _boneSpans;
+	std::vector<std::span<const L3DPrimitiveHeader>> _primitiveSpans;
+	std::vector<std::span<const L3DVertex>> _vertexSpans;
+	std::vector<std::span<const uint16_t>> _indexSpans;
+	std::vector<std::span<const L3DVertexGroup>> _vertexGroupSpans;
+	std::vector<std::span<const L3DBone>> _boneSpans;
 	std::optional<L3DFootprint> _footprint;
 	std::vector<uint8_t> _uv2Data;
 	std::string _nameData;
 	std::vector<std::array<float, 3 * 4>> _extraMetrics;
 
+	/// True when the sections point into a borrowed buffer instead of the vectors above
+	bool _isView {false};
+	struct Views
+	{
+		std::span<const L3DSubmeshHeader> submeshHeaders;
+		std::span<const L3DTexture> skins;
+		std::span<const L3DPoint> extraPoints;
+		std::span<const L3DPrimitiveHeader> primitiveHeaders;
+		std::span<const L3DVertex> vertices;
+		std::span<const uint16_t> indices;
+		std::span<const L3DVertexGroup> vertexGroups;
+		std::span<const L3DBlend> blends;
+		std::span<const L3DBone> bones;
+	} _views;
+
 	/// Error handling
 	void Fail(const std::string& msg);
 
 	/// Read file from the input source
 	virtual void ReadFile(std::istream& stream);
 
+	/// Point the sections into the buffer, returns false if they aren't laid out contiguously and aligned
+	bool ReadView(std::span<const uint8_t> buffer);
+
+	/// Read the footprint, uv2, name and extra metrics blocks which follow the sections
+	void ReadAdditionalData(std::istream& stream);
+
+	/// Split the sections by submesh
+	void CreateSubmeshSpans();
+
+	template <typename T>
+	[[nodiscard]] std::span<const T> GetSection(std::span<const T> view, const std::vector<T>& items) const
+	{
+		return _isView ? view : std::span<const T>(items);
+	}
+
 	/// Write file to the input source
 	virtual void WriteFile(std::ostream& stream) const;
 
@@ -320,20 +350,36 @@ class L3DFile
 	/// Read l3d file from a buffer
 	void Open(const std::vector<uint8_t>& buffer);
 
+	/// Read l3d file in place from a buffer which must outlive the file, such as a pack block or a mapped file.
+	///
+	/// Only the header and offset tables are validated, the sections are then referenced without copying. Files whose
+	/// sections aren't contiguous or aligned are copied like with \ref Open.
+	void OpenView(std::span<const uint8_t> buffer);
+
 	/// Write l3d file to path on the filesystem
 	void Write(const std::filesystem::path& filepath);
 
 	[[nodiscard]] std::string GetFilename() const { return _filename.string(); }
 	[[nodiscard]] const L3DHeader& GetHeader() const { return _header; }
-	[[nodiscard]] const std::vector<L3DSubmeshHeader>& GetSubmeshHeaders() const { return _submeshHeaders; }
-	[[nodiscard]] const std::vector<L3DTexture>& GetSkins() const { return _skins; }
-	[[nodiscard]] const std::vector<L3DPoint>& GetExtraPoints() const { return _extraPoints; }
-	[[nodiscard]] const std::vector<L3DPrimitiveHeader>& GetPrimitiveHeaders() const { return _primitiveHeaders; }
-	[[nodiscard]] const std::vector<L3DVertex>& GetVertices() const { return _vertices; }
-	[[nodiscard]] const std::vector<uint16_t>& GetIndices() const { return _indices; }
-	[[nodiscard]] const std::vector<L3DVertexGroup>& GetLookUpTableData() const { return _vertexGroups; }
-	[[nodiscard]] const std::vector<L3DBlend>& GetBlends() const { return _blends; }
-	[[nodiscard]] const std::vector<L3DBone>& GetBones() const { return _bones; }
+	[[nodiscard]] bool IsView() const { return _isView; }
+	[[nodiscard]] std::span<const L3DSubmeshHeader> GetSubmeshHeaders() const
+	{
+		return GetSection(_views.submeshHeaders, _submeshHeaders);
+	}
+	[[nodiscard]] std::span<const L3DTexture> GetSkins() const { return GetSection(_views.skins, _skins); }
+	[[nodiscard]] std::span<const L3DPoint> GetExtraPoints() const { return GetSection(_views.extraPoints, _extraPoints); }
+	[[nodiscard]] std::span<const L3DPrimitiveHeader> GetPrimitiveHeaders() const
+	{
+		return GetSection(_views.primitiveHeaders, _primitiveHeaders);
+	}
+	[[nodiscard]] std::span<const L3DVertex> GetVertices() const { return GetSection(_views.vertices, _vertices); }
+	[[nodiscard]] std::span<const uint16_t> GetIndices() const { return GetSection(_views.indices, _indices); }
+	[[nodiscard]] std::span<const L3DVertexGroup> GetLookUpTableData() const
+	{
+		return GetSection(_views.vertexGroups, _vertexGroups);
+	}
+	[[nodiscard]] std::span<const L3DBlend> GetBlends() const { return GetSection(_views.blends, _blends); }
+	[[nodiscard]] std::span<const L3DBone> GetBones() const { return GetSection(_views.bones, _bones); }
 	[[nodiscard]] const std::optional<L3DFootprint>& GetFootprint() const { return _footprint; }
 	[[nodiscard]] const std::vector<std::array<float, 3 * 4>>& GetExtraMetrics() const { return _extraMetrics; }
 	[[nodiscard]] const std::vector<uint8_t>& GetUv2Data() const { return _uv2Data; }
@@ -342,14 +388,14 @@ class L3DFile
 	void SetUv2Data(std::vector<uint8_t>& uv2Data) { _uv2Data = uv2Data; }
 	void SetNameData(std::string& nameData) { _nameData = nameData; }
 	[[nodiscard]] const std::string& GetNameData() const { return _nameData; }
-	[[nodiscard]] const std::span<L3DPrimitiveHeader>& GetPrimitiveSpan(uint32_t submeshIndex) const
+	[[nodiscard]] std::span<const L3DPrimitiveHeader> GetPrimitiveSpan(uint32_t submeshIndex) const
 	{
 		return _primitiveSpans[submeshIndex];
 	}
-	[[nodiscard]] const std::span<L3DBone>& GetBoneSpan(uint32_t submeshIndex) const { return _boneSpans[submeshIndex]; }
-	[[nodiscard]] const std::span<L3DVertex>& GetVertexSpan(uint32_t submeshIndex) const { return _vertexSpans[submeshIndex]; }
-	[[nodiscard]] const std::span<uint16_t>& GetIndexSpan(uint32_t submeshIndex) const { return _indexSpans[submeshIndex]; }
-	[[nodiscard]] const std::span<L3DVertexGroup>& GetVertexGroupSpan(uint32_t submeshIndex) const
+	[[nodiscard]] std::span<const L3DBone> GetBoneSpan(uint32_t submeshIndex) const { return _boneSpans[submeshIndex]; }
+	[[nodiscard]] std::span<const L3DVertex> GetVertexSpan(uint32_t submeshIndex) const { return _vertexSpans[submeshIndex]; }
+	[[nodiscard]] std::span<const uint16_t> GetIndexSpan(uint32_t submeshIndex) const { return _indexSpans[submeshIndex]; }
+	[[nodiscard]] std::span<const L3DVertexGroup> GetVertexGroupSpan(uint32_t submeshIndex) const
 	{
 		return _vertexGroupSpans[submeshIndex];
 	}
@@ -172,6 +172,7 @@
 
 #include <fstream>
 #include <limits>
+#include <optional>
 #include <vector>
 
 using namespace openblack::l3d;
@@ -217,14 +218,84 @@ struct imemstream: virtual membuf, std::istream
 	{
 	}
 };
+
+/// Bounds checked typed views into a borrowed buffer
+class BufferView
+{
+public:
+	explicit BufferView(std::span<const uint8_t> buffer)
+	    : _buffer(buffer)
+	{
+	}
+
+	/// The \p count items at \p offset, nothing if they go beyond the buffer or are misaligned for \p T
+	template <typename T>
+	[[nodiscard]] std::optional<std::span<const T>> Get(uint64_t offset, uint64_t count) const
+	{
+		if (count == 0)
+		{
+			return std::span<const T>();
+		}
+		if (offset > _buffer.size() || count > (_buffer.size() - offset) / sizeof(T))
+		{
+			return std::nullopt;
+		}
+		const auto* data = _buffer.data() + offset;
+		if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0)
+		{
+			return std::nullopt;
+		}
+		return std::span<const T>(reinterpret_cast<const T*>(data), static_cast<size_t>(count));
+	}
+
+private:
+	std::span<const uint8_t> _buffer;
+};
+
+/// Joins the runs of items of each header into a single section, which only works if each run follows the previous one
+template <typename T>
+class Section
+{
+public:
+	void Append(uint64_t offset, uint64_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if (_count == 0)
+		{
+			_offset = offset;
+		}
+		else if (offset != _offset + _count * sizeof(T))
+		{
+			_contiguous = false;
+		}
+		_count += count;
+	}
+
+	[[nodiscard]] std::optional<std::span<const T>> View(const BufferView& buffer) const
+	{
+		if (!_contiguous)
+		{
+			return std::nullopt;
+		}
+		return buffer.Get<T>(_offset, _count);
+	}
+
+private:
+	uint64_t _offset {0};
+	uint64_t _count {0};
+	bool _contiguous {true};
+};
 } // namespace
 
 template <typename Item>
-void add_span(std::vector<std::span<Item>>& container, typename std::vector<Item>& items, size_t offset, size_t length)
+void add_span(std::vector<std::span<const Item>>& container, std::span<const Item> items, size_t offset, size_t length)
 {
 	if (length > 0)
 	{
-		container.emplace_back(&items[offset], length);
+		container.emplace_back(items.subspan(offset, length));
 	}
 	else
 	{
@@ -520,6 +591,98 @@ void L3DFile::ReadFile(std::istream& stream)
 		}
 	}
 
+	ReadAdditionalData(stream);
+	CreateSubmeshSpans();
+
+	_isLoaded = true;
+}
+
+bool L3DFile::ReadView(std::span<const uint8_t> buffer)
+{
+	const BufferView file(buffer);
+
+	const auto headerView = file.Get<L3DHeader>(0, 1);
+	if (!headerView.has_value() || headerView->front().magic != k_Magic)
+	{
+		return false;
+	}
+	const auto& header = headerView->front();
+
+	const auto submeshOffsets = file.Get<uint32_t>(header.submeshOffsetsOffset, header.submeshCount);
+	const auto skinOffsets = file.Get<uint32_t>(header.skinOffsetsOffset, header.skinCount);
+	const auto extraPoints = file.Get<L3DPoint>(header.extraDataOffset, header.extraDataCount);
+	if (!submeshOffsets.has_value() || !skinOffsets.has_value() || !extraPoints.has_value())
+	{
+		return false;
+	}
+
+	Section<L3DSubmeshHeader> submeshSection;
+	for (auto offset : *submeshOffsets)
+	{
+		submeshSection.Append(offset, 1);
+	}
+	Section<L3DTexture> skinSection;
+	for (auto offset : *skinOffsets)
+	{
+		skinSection.Append(offset, 1);
+	}
+	const auto submeshHeaders = submeshSection.View(file);
+	const auto skins = skinSection.View(file);
+	if (!submeshHeaders.has_value() || !skins.has_value())
+	{
+		return false;
+	}
+
+	Section<L3DPrimitiveHeader> primitiveSection;
+	Section<L3DBone> boneSection;
+	for (const auto& submeshHeader : *submeshHeaders)
+	{
+		const auto primitiveOffsets = file.Get<uint32_t>(submeshHeader.primitivesOffset, submeshHeader.numPrimitives);
+		if (!primitiveOffsets.has_value())
+		{
+			return false;
+		}
+		for (auto offset : *primitiveOffsets)
+		{
+			primitiveSection.Append(offset, 1);
+		}
+		boneSection.Append(submeshHeader.bonesOffset, submeshHeader.numBones);
+	}
+	const auto primitiveHeaders = primitiveSection.View(file);
+	const auto bones = boneSection.View(file);
+	if (!primitiveHeaders.has_value() || !bones.has_value())
+	{
+		return false;
+	}
+
+	Section<L3DVertex> vertexSection;
+	Section<uint16_t> indexSection;
+	Section<L3DVertexGroup> vertexGroupSection;
+	Section<L3DBlend> blendSection;
+	for (const auto& primitiveHeader : *primitiveHeaders)
+	{
+		vertexSection.Append(primitiveHeader.verticesOffset, primitiveHeader.numVertices);
+		indexSection.Append(primitiveHeader.trianglesOffset, primitiveHeader.numTriangles * 3ULL);
+		vertexGroupSection.Append(primitiveHeader.groupsOffset, primitiveHeader.numGroups);
+		blendSection.Append(primitiveHeader.vertexBlendsOffset, primitiveHeader.numVertexBlends);
+	}
+	const auto vertices = vertexSection.View(file);
+	const auto indices = indexSection.View(file);
+	const auto vertexGroups = vertexGroupSection.View(file);
+	const auto blends = blendSection.View(file);
+	if (!vertices.has_value() || !indices.has_value() || !vertexGroups.has_value() || !blends.has_value())
+	{
+		return false;
+	}
+
+	_header = header;
+	_views = {*submeshHeaders, *skins, *extraPoints, *primitiveHeaders, *vertices, *indices, *vertexGroups, *blends, *bones};
+	_isView = true;
+	return true;
+}
+
+void L3DFile::ReadAdditionalData(std::istream& stream)
+{
 	// Get additional data. Strictly in this order
 	// Footprint data
 	const auto headerFlags = static_cast<uint32_t>(_header.flags);
@@ -642,52 +805,53 @@ void L3DFile::ReadFile(std::istream& stream)
 			stream.read(reinterpret_cast<char*>(_extraMetrics.data()), sizeof(_extraMetrics[0]) * _extraMetrics.size());
 		}
 	}
+}
 
+void L3DFile::CreateSubmeshSpans()
+{
 	// Create spans per submesh
-	_primitiveSpans.reserve(_submeshHeaders.size());
-	_boneSpans.reserve(_submeshHeaders.size());
+	_primitiveSpans.reserve(GetSubmeshHeaders().size());
+	_boneSpans.reserve(GetSubmeshHeaders().size());
 	{
 		uint32_t primitiveStart = 0;
 		uint32_t boneStart = 0;
-		for (auto& submeshHeader : _submeshHeaders)
+		for (const auto& submeshHeader : GetSubmeshHeaders())
 		{
-			add_span(_primitiveSpans, _primitiveHeaders, primitiveStart, submeshHeader.numPrimitives);
-			add_span(_boneSpans, _bones, boneStart, submeshHeader.numBones);
+			add_span(_primitiveSpans, GetPrimitiveHeaders(), primitiveStart, submeshHeader.numPrimitives);
+			add_span(_boneSpans, GetBones(), boneStart, submeshHeader.numBones);
 			primitiveStart += submeshHeader.numPrimitives;
 			boneStart += submeshHeader.numBones;
 		}
 	}
 
 	// Create Primitive spans per submesh
-	_vertexSpans.reserve(_submeshHeaders.size());
-	_indexSpans.reserve(_submeshHeaders.size());
-	_vertexGroupSpans.reserve(_submeshHeaders.size());
+	_vertexSpans.reserve(GetSubmeshHeaders().size());
+	_indexSpans.reserve(GetSubmeshHeaders().size());
+	_vertexGroupSpans.reserve(GetSubmeshHeaders().size());
 	{
 		uint32_t vertexStart = 0;
 		uint32_t indexStart = 0;
 		uint32_t vertexGroupStart = 0;
-		for (uint32_t i = 0; i < _submeshHeaders.size(); ++i)
+		for (uint32_t i = 0; i < GetSubmeshHeaders().size(); ++i)
 		{
 			uint32_t vertexLength = 0;
 			uint32_t indexLength = 0;
 			uint32_t vertexGroupLength = 0;
-			for (auto& primitive : GetPrimitiveSpan(i))
+			for (const auto& primitive : GetPrimitiveSpan(i))
 			{
 				vertexLength += primitive.numVertices;
 				indexLength += primitive.numTriangles * 3;
 				vertexGroupLength += primitive.numGroups;
 			}
 
-			add_span(_vertexSpans, _vertices, vertexStart, vertexLength);
-			add_span(_indexSpans, _indices, indexStart, indexLength);
-			add_span(_vertexGroupSpans, _vertexGroups, vertexGroupStart, vertexGroupLength);
+			add_span(_vertexSpans, GetVertices(), vertexStart, vertexLength);
+			add_span(_indexSpans, GetIndices(), indexStart, indexLength);
+			add_span(_vertexGroupSpans, GetLookUpTableData(), vertexGroupStart, vertexGroupLength);
 			vertexStart += vertexLength;
 			indexStart += indexLength;
 			vertexGroupStart += vertexGroupLength;
 		}
 	}
-
-	_isLoaded = true;
 }
 
 void L3DFile::WriteFile(std::ostream& stream) const
@@ -817,6 +981,27 @@ void L3DFile::Open(const std::vector<uint8_t>& buffer)
 	ReadFile(stream);
 }
 
+void L3DFile::OpenView(std::span<const uint8_t> buffer)
+{
+	assert(!_isLoaded);
+
+	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
+	_filename = std::filesystem::path("buffer");
+
+	// Invalid files are rejected by the stream reader with a detailed error
+	if (!ReadView(buffer))
+	{
+		ReadFile(stream);
+		return;
+	}
+
+	ReadAdditionalData(stream);
+	CreateSubmeshSpans();
+
+	_isLoaded = true;
+}
+
 void L3DFile::Write(const std::filesystem::path& filepath)
 {
 	assert(!_isLoaded);
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "LNDFile.h"
+
+namespace openblack::lnd
+{
+
+struct LNDCompressedMaterialHeader
+{
+	static constexpr std::array<char, 4> k_Magic = {'L', 'N', 'D', 'C'};
+	static constexpr uint32_t k_Version = 1;
+
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint32_t materialCount;
+	uint32_t mipCount;
+	/// Hash of the source material texels, used to detect a cache made from a different lnd
+	uint64_t sourceHash;
+};
+static_assert(sizeof(LNDCompressedMaterialHeader) == 24);
+
+/// BC1 (DXT1) encoded copy of the materials of an lnd file with a full mip chain per material
+class LNDCompressedMaterialFile
+{
+protected:
+	/// True when a file has been loaded
+	bool _isLoaded {false};
+
+	std::filesystem::path _filename;
+
+	LNDCompressedMaterialHeader _header {};
+	/// Each material with all of its mips one after the other, largest first
+	std::vector<uint8_t> _blocks;
+
+	/// Error handling
+	void Fail(const std::string& msg);
+
+	/// Read file from the input source
+	virtual void ReadFile(std::istream& stream);
+
+	/// Write file to the input source
+	virtual void WriteFile(std::ostream& stream) const;
+
+	/// Encode the mip chain of one 256x256 material into \p out
+	static void CompressMaterial(std::span<const LNDMaterial::R5G5B5A1> texels, uint8_t* out);
+
+public:
+	static constexpr uint32_t k_BlockSize = 8;
+	static constexpr uint32_t k_MipCount = 9; ///< 256x256 down to 1x1
+
+	LNDCompressedMaterialFile();
+	virtual ~LNDCompressedMaterialFile();
+
+	/// Read compressed material file from the filesystem
+	void Open(const std::filesystem::path& filepath);
+
+	/// Read compressed material file from a buffer
+	void Open(const std::vector<uint8_t>& buffer);
+
+	/// Write compressed material file to path on the filesystem
+	void Write(const std::filesystem::path& filepath);
+
+	/// Encode the materials, replacing any loaded content
+	void Compress(const std::vector<LNDMaterial>& materials);
+
+	/// Encode consecutive layers of material sized texels, such as the sky textures
+	void Compress(std::span<const LNDMaterial::R5G5B5A1> texels);
+
+	/// FNV-1a hash of the material texels, stored in the header for cache validation
+	[[nodiscard]] static uint64_t HashMaterials(const std::vector<LNDMaterial>& materials);
+
+	/// Same as \ref HashMaterials for layers of texels
+	[[nodiscard]] static uint64_t HashTexels(std::span<const LNDMaterial::R5G5B5A1> texels);
+
+	/// Size in bytes of one mip level of one material
+	[[nodiscard]] static uint32_t GetMipSize(uint32_t mip);
+
+	/// Size in bytes of one material with all of its mips
+	[[nodiscard]] static uint32_t GetMaterialSize();
+
+	[[nodiscard]] std::string GetFilename() const { return _filename.string(); }
+	[[nodiscard]] const auto& GetHeader() const { return _header; }
+	[[nodiscard]] const auto& GetBlocks() const { return _blocks; }
+};
+
+} // namespace openblack::lnd
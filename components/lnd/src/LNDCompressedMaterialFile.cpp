@@ -0,0 +1,424 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+/*
+ *
+ * The layout of a compressed material file is as follows:
+ *
+ * - 24 byte header, containing:
+ *         magic - "LNDC"
+ *         version - currently 1
+ *         material count - number of materials in the source lnd
+ *         mip count - number of mips of each material, always 9 (256 to 1)
+ *         source hash - FNV-1a hash of the texels of the source materials
+ *
+ * ------------------------ start of material block ----------------------------
+ *
+ * - for each material, for each mip from largest to smallest:
+ *         BC1 blocks of 8 bytes in row order, at least one block per mip
+ *
+ * ------------------------ end of file ----------------------------------------
+ *
+ * This matches the memory layout bgfx expects for a texture array with mips.
+ */
+
+#include "LNDCompressedMaterialFile.h"
+
+#include <cassert>
+#include <cstring>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+using namespace openblack::lnd;
+
+namespace
+{
+using Rgb = std::array<int32_t, 3>;
+
+Rgb Expand(LNDMaterial::R5G5B5A1 texel)
+{
+	return {
+	    (texel.r << 3) | (texel.r >> 2),
+	    (texel.g << 3) | (texel.g >> 2),
+	    (texel.b << 3) | (texel.b >> 2),
+	};
+}
+
+uint16_t PackRgb565(const Rgb& color)
+{
+	return static_cast<uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+}
+
+Rgb UnpackRgb565(uint16_t color)
+{
+	const int32_t r = (color >> 11) & 0x1F;
+	const int32_t g = (color >> 5) & 0x3F;
+	const int32_t b = color & 0x1F;
+	return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// Range fit encoder: the end points are the inset bounding box of the block,
+/// with the box diagonal flipped per channel to follow the correlation with red.
+void EncodeBlock(const std::array<Rgb, 16>& texels, uint8_t* out)
+{
+	Rgb mean {};
+	Rgb minColor {255, 255, 255};
+	Rgb maxColor {0, 0, 0};
+	for (const auto& texel : texels)
+	{
+		for (size_t c = 0; c < 3; ++c)
+		{
+			mean[c] += texel[c];
+			minColor[c] = std::min(minColor[c], texel[c]);
+			maxColor[c] = std::max(maxColor[c], texel[c]);
+		}
+	}
+	for (auto& c : mean)
+	{
+		c /= static_cast<int32_t>(texels.size());
+	}
+
+	std::array<int32_t, 2> covariance {};
+	for (const auto& texel : texels)
+	{
+		covariance[0] += (texel[0] - mean[0]) * (texel[1] - mean[1]);
+		covariance[1] += (texel[0] - mean[0]) * (texel[2] - mean[2]);
+	}
+	for (size_t c = 0; c < 3; ++c)
+	{
+		const auto inset = (maxColor[c] - minColor[c]) / 16;
+		maxColor[c] -= inset;
+		minColor[c] += inset;
+	}
+
+	for (size_t c = 1; c < 3; ++c)
+	{
+		if (covariance[c - 1] < 0)
+		{
+			std::swap(minColor[c], maxColor[c]);
+		}
+	}
+
+	auto color0 = PackRgb565(maxColor);
+	auto color1 = PackRgb565(minColor);
+	// color0 > color1 selects the opaque four color mode
+	if (color0 < color1)
+	{
+		std::swap(color0, color1);
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1)
+	{
+		const auto end0 = UnpackRgb565(color0);
+		const auto end1 = UnpackRgb565(color1);
+		std::array<Rgb, 4> palette {end0, end1};
+		for (size_t c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * end0[c] + end1[c]) / 3;
+			palette[3][c] = (end0[c] + 2 * end1[c]) / 3;
+		}
+
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			uint32_t best = 0;
+			int32_t bestDistance = std::numeric_limits<int32_t>::max();
+			for (uint32_t p = 0; p < palette.size(); ++p)
+			{
+				int32_t distance = 0;
+				for (size_t c = 0; c < 3; ++c)
+				{
+					const auto d = texels[i][c] - palette[p][c];
+					distance += d * d;
+				}
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= best << (2 * i);
+		}
+	}
+
+	out[0] = static_cast<uint8_t>(color0 & 0xFF);
+	out[1] = static_cast<uint8_t>(color0 >> 8);
+	out[2] = static_cast<uint8_t>(color1 & 0xFF);
+	out[3] = static_cast<uint8_t>(color1 >> 8);
+	for (size_t i = 0; i < 4; ++i)
+	{
+		out[4 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xFF);
+	}
+}
+
+/// Encode a square mip level, smaller than a block mips repeat their edge texels
+void EncodeMip(const std::vector<Rgb>& mip, uint32_t size, uint8_t* out)
+{
+	const auto blockCount = std::max(1u, size / 4);
+	for (uint32_t by = 0; by < blockCount; ++by)
+	{
+		for (uint32_t bx = 0; bx < blockCount; ++bx)
+		{
+			std::array<Rgb, 16> texels;
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				for (uint32_t x = 0; x < 4; ++x)
+				{
+					const auto sx = std::min(bx * 4 + x, size - 1);
+					const auto sy = std::min(by * 4 + y, size - 1);
+					texels[y * 4 + x] = mip[sy * size + sx];
+				}
+			}
+			EncodeBlock(texels, out);
+			out += LNDCompressedMaterialFile::k_BlockSize;
+		}
+	}
+}
+
+std::vector<Rgb> Downsample(const std::vector<Rgb>& mip, uint32_t size)
+{
+	const auto half = size / 2;
+	std::vector<Rgb> result(half * half);
+	for (uint32_t y = 0; y < half; ++y)
+	{
+		for (uint32_t x = 0; x < half; ++x)
+		{
+			const auto& a = mip[(2 * y) * size + 2 * x];
+			const auto& b = mip[(2 * y) * size + 2 * x + 1];
+			const auto& c = mip[(2 * y + 1) * size + 2 * x];
+			const auto& d = mip[(2 * y + 1) * size + 2 * x + 1];
+			for (size_t i = 0; i < 3; ++i)
+			{
+				result[y * half + x][i] = (a[i] + b[i] + c[i] + d[i] + 2) / 4;
+			}
+		}
+	}
+	return result;
+}
+
+constexpr uint64_t k_HashBasis = 0xcbf29ce484222325;
+
+uint64_t Hash(uint64_t hash, std::span<const LNDMaterial::R5G5B5A1> texels)
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(texels.data());
+	for (size_t i = 0; i < texels.size_bytes(); ++i)
+	{
+		hash = (hash ^ bytes[i]) * 0x100000001b3;
+	}
+	return hash;
+}
+} // namespace
+
+LNDCompressedMaterialFile::LNDCompressedMaterialFile() = default;
+LNDCompressedMaterialFile::~LNDCompressedMaterialFile() = default;
+
+/// Error handling
+void LNDCompressedMaterialFile::Fail(const std::string& msg)
+{
+	throw std::runtime_error("LND Compressed Material Error: " + msg + "\nFilename: " + _filename.string());
+}
+
+uint32_t LNDCompressedMaterialFile::GetMipSize(uint32_t mip)
+{
+	const auto blockCount = std::max(1u, (static_cast<uint32_t>(LNDMaterial::k_Width) >> mip) / 4);
+	return blockCount * blockCount * k_BlockSize;
+}
+
+uint32_t LNDCompressedMaterialFile::GetMaterialSize()
+{
+	uint32_t size = 0;
+	for (uint32_t mip = 0; mip < k_MipCount; ++mip)
+	{
+		size += GetMipSize(mip);
+	}
+	return size;
+}
+
+uint64_t LNDCompressedMaterialFile::HashMaterials(const std::vector<LNDMaterial>& materials)
+{
+	uint64_t hash = k_HashBasis;
+	for (const auto& material : materials)
+	{
+		hash = Hash(hash, material.texels);
+	}
+	return hash;
+}
+
+uint64_t LNDCompressedMaterialFile::HashTexels(std::span<const LNDMaterial::R5G5B5A1> texels)
+{
+	return Hash(k_HashBasis, texels);
+}
+
+void LNDCompressedMaterialFile::ReadFile(std::istream& stream)
+{
+	assert(!_isLoaded);
+
+	// Total file size
+	std::size_t fsize = 0;
+	if (stream.seekg(0, std::ios_base::end))
+	{
+		fsize = static_cast<std::size_t>(stream.tellg());
+		stream.seekg(0);
+	}
+
+	if (fsize < sizeof(LNDCompressedMaterialHeader))
+	{
+		Fail("File too small to be a valid compressed material file.");
+	}
+
+	stream.read(reinterpret_cast<char*>(&_header), sizeof(_header));
+
+	if (_header.magic != LNDCompressedMaterialHeader::k_Magic)
+	{
+		Fail("Unrecognized file magic");
+	}
+	if (_header.version != LNDCompressedMaterialHeader::k_Version)
+	{
+		Fail("Unsupported version " + std::to_string(_header.version) + " expected " +
+		     std::to_string(LNDCompressedMaterialHeader::k_Version));
+	}
+	if (_header.mipCount != k_MipCount)
+	{
+		Fail("File has non standard mip count got " + std::to_string(_header.mipCount) + " expected " +
+		     std::to_string(k_MipCount));
+	}
+
+	_blocks.resize(static_cast<size_t>(_header.materialCount) * GetMaterialSize());
+	if (sizeof(_header) + _blocks.size() != fsize)
+	{
+		Fail("Material blocks do not match the size of the file");
+	}
+	stream.read(reinterpret_cast<char*>(_blocks.data()), static_cast<std::streamsize>(_blocks.size()));
+
+	_isLoaded = true;
+}
+
+void LNDCompressedMaterialFile::WriteFile(std::ostream& stream) const
+{
+	stream.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+	stream.write(reinterpret_cast<const char*>(_blocks.data()), static_cast<std::streamsize>(_blocks.size()));
+}
+
+void LNDCompressedMaterialFile::Open(const std::filesystem::path& filepath)
+{
+	assert(!_isLoaded);
+
+	_filename = filepath;
+
+	std::ifstream stream(_filename, std::ios::binary);
+
+	if (!stream.is_open())
+	{
+		Fail("Could not open file.");
+	}
+
+	ReadFile(stream);
+}
+
+void LNDCompressedMaterialFile::Open(const std::vector<uint8_t>& buffer)
+{
+	assert(!_isLoaded);
+
+	_filename = std::filesystem::path("buffer");
+
+	// Parsed in place, going through a stream would copy the whole block payload once more
+	if (buffer.size() < sizeof(LNDCompressedMaterialHeader))
+	{
+		Fail("File too small to be a valid compressed material file.");
+	}
+	std::memcpy(&_header, buffer.data(), sizeof(_header));
+	if (_header.magic != LNDCompressedMaterialHeader::k_Magic)
+	{
+		Fail("Unrecognized file magic");
+	}
+	if (_header.version != LNDCompressedMaterialHeader::k_Version || _header.mipCount != k_MipCount)
+	{
+		Fail("Unsupported version or mip count");
+	}
+	const auto size = static_cast<size_t>(_header.materialCount) * GetMaterialSize();
+	if (sizeof(_header) + size != buffer.size())
+	{
+		Fail("Material blocks do not match the size of the file");
+	}
+	_blocks.assign(buffer.begin() + sizeof(_header), buffer.end());
+
+	_isLoaded = true;
+}
+
+void LNDCompressedMaterialFile::Write(const std::filesystem::path& filepath)
+{
+	_filename = filepath;
+
+	std::ofstream stream(_filename, std::ios::binary);
+
+	if (!stream.is_open())
+	{
+		Fail("Could not open file.");
+	}
+
+	WriteFile(stream);
+}
+
+void LNDCompressedMaterialFile::Compress(const std::vector<LNDMaterial>& materials)
+{
+	_header.magic = LNDCompressedMaterialHeader::k_Magic;
+	_header.version = LNDCompressedMaterialHeader::k_Version;
+	_header.materialCount = static_cast<uint32_t>(materials.size());
+	_header.mipCount = k_MipCount;
+	_header.sourceHash = HashMaterials(materials);
+
+	_blocks.resize(materials.size() * GetMaterialSize());
+	for (size_t i = 0; i < materials.size(); ++i)
+	{
+		CompressMaterial(materials[i].texels, &_blocks[i * GetMaterialSize()]);
+	}
+
+	_isLoaded = true;
+}
+
+void LNDCompressedMaterialFile::Compress(std::span<const LNDMaterial::R5G5B5A1> texels)
+{
+	constexpr size_t k_MaterialTexels = LNDMaterial::k_Width * LNDMaterial::k_Height;
+	assert(texels.size() % k_MaterialTexels == 0);
+	const auto materialCount = texels.size() / k_MaterialTexels;
+
+	_header.magic = LNDCompressedMaterialHeader::k_Magic;
+	_header.version = LNDCompressedMaterialHeader::k_Version;
+	_header.materialCount = static_cast<uint32_t>(materialCount);
+	_header.mipCount = k_MipCount;
+	_header.sourceHash = HashTexels(texels);
+
+	_blocks.resize(materialCount * GetMaterialSize());
+	for (size_t i = 0; i < materialCount; ++i)
+	{
+		CompressMaterial(texels.subspan(i * k_MaterialTexels, k_MaterialTexels), &_blocks[i * GetMaterialSize()]);
+	}
+
+	_isLoaded = true;
+}
+
+void LNDCompressedMaterialFile::CompressMaterial(std::span<const LNDMaterial::R5G5B5A1> texels, uint8_t* out)
+{
+	std::vector<Rgb> mip(texels.size());
+	std::transform(texels.begin(), texels.end(), mip.begin(), Expand);
+	uint32_t size = LNDMaterial::k_Width;
+	for (uint32_t level = 0; level < k_MipCount; ++level)
+	{
+		EncodeMip(mip, size, out);
+		out += GetMipSize(level);
+		if (size > 1)
+		{
+			mip = Downsample(mip, size);
+			size /= 2;
+		}
+	}
+}
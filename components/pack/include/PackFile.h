@@ -165,6 +165,8 @@ class PackFile
 	std::filesystem::path _filename;
 
 	std::map<std::string, std::vector<uint8_t>> _blocks;
+	/// Offsets of the blocks' data from the start of the file they were read from
+	std::map<std::string, uint64_t> _blockOffsets;
 	std::vector<InfoBlockLookup> _infoBlockLookup;
 	std::vector<BodyBlockLookup> _bodyBlockLookup;
 	/// Metadata and DDS formatted texture data
@@ -246,6 +248,7 @@ class PackFile
 	[[nodiscard]] const std::map<std::string, std::vector<uint8_t>>& GetBlocks() const { return _blocks; }
 	[[nodiscard]] bool HasBlock(const std::string& name) const { return _blocks.contains(name); }
 	[[nodiscard]] const std::vector<uint8_t>& GetBlock(const std::string& name) const { return _blocks.at(name); }
+	[[nodiscard]] uint64_t GetBlockOffset(const std::string& name) const { return _blockOffsets.at(name); }
 	[[nodiscard]] std::unique_ptr<std::istream> GetBlockAsStream(const std::string& name) const;
 	[[nodiscard]] const std::vector<InfoBlockLookup>& GetInfoBlockLookup() const { return _infoBlockLookup; }
 	[[nodiscard]] const std::vector<BodyBlockLookup>& GetBodyBlockLookup() const { return _bodyBlockLookup; }
@@ -229,6 +229,7 @@ void PackFile::ReadBlocks(std::istream& stream)
 			Fail(std::string("Duplicate block name: ") + header.blockName.data());
 		}
 
+		_blockOffsets[std::string(header.blockName.data())] = static_cast<uint64_t>(stream.tellg());
 		_blocks[std::string(header.blockName.data())] = std::vector<uint8_t>(header.blockSize);
 		stream.read(reinterpret_cast<char*>(_blocks[header.blockName.data()].data()), header.blockSize);
 	}
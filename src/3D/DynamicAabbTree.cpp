@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "DynamicAabbTree.h"
+
+#include <cassert>
+
+#include <algorithm>
+
+using namespace openblack;
+
+namespace
+{
+AxisAlignedBoundingBox Combine(const AxisAlignedBoundingBox& a, const AxisAlignedBoundingBox& b)
+{
+	return {glm::min(a.minima, b.minima), glm::max(a.maxima, b.maxima)};
+}
+
+float SurfaceArea(const AxisAlignedBoundingBox& box)
+{
+	const auto size = box.Size();
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool Encloses(const AxisAlignedBoundingBox& outer, const AxisAlignedBoundingBox& inner)
+{
+	return glm::all(glm::lessThanEqual(outer.minima, inner.minima)) &&
+	       glm::all(glm::greaterThanEqual(outer.maxima, inner.maxima));
+}
+} // namespace
+
+DynamicAabbTree::DynamicAabbTree(float margin)
+    : _margin(margin)
+{
+}
+
+int32_t DynamicAabbTree::AllocateNode()
+{
+	if (_freeList == k_NullNode)
+	{
+		_nodes.emplace_back();
+		_nodes.back().parent = k_NullNode;
+		_nodes.back().height = -1;
+		_freeList = static_cast<int32_t>(_nodes.size() - 1);
+	}
+
+	const auto nodeId = _freeList;
+	auto& node = _nodes[nodeId];
+	_freeList = node.parent;
+	node.parent = k_NullNode;
+	node.child1 = k_NullNode;
+	node.child2 = k_NullNode;
+	node.height = 0;
+	node.userData = 0;
+	return nodeId;
+}
+
+void DynamicAabbTree::FreeNode(int32_t nodeId)
+{
+	auto& node = _nodes[nodeId];
+	node.parent = _freeList;
+	node.height = -1;
+	_freeList = nodeId;
+}
+
+int32_t DynamicAabbTree::CreateProxy(const AxisAlignedBoundingBox& box, uint32_t userData)
+{
+	const auto proxy = AllocateNode();
+	_nodes[proxy].box = {box.minima - _margin, box.maxima + _margin};
+	_nodes[proxy].userData = userData;
+	InsertLeaf(proxy);
+	++_proxyCount;
+	return proxy;
+}
+
+void DynamicAabbTree::DestroyProxy(int32_t proxy)
+{
+	assert(_nodes[proxy].IsLeaf() && _nodes[proxy].height == 0);
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--_proxyCount;
+}
+
+bool DynamicAabbTree::MoveProxy(int32_t proxy, const AxisAlignedBoundingBox& box)
+{
+	assert(_nodes[proxy].IsLeaf() && _nodes[proxy].height == 0);
+	if (Encloses(_nodes[proxy].box, box))
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+	_nodes[proxy].box = {box.minima - _margin, box.maxima + _margin};
+	InsertLeaf(proxy);
+	return true;
+}
+
+void DynamicAabbTree::Clear()
+{
+	_nodes.clear();
+	_root = k_NullNode;
+	_freeList = k_NullNode;
+	_proxyCount = 0;
+}
+
+void DynamicAabbTree::InsertLeaf(int32_t leaf)
+{
+	if (_root == k_NullNode)
+	{
+		_root = leaf;
+		_nodes[_root].parent = k_NullNode;
+		return;
+	}
+
+	// Descend towards the sibling with the lowest surface area heuristic cost
+	const auto leafBox = _nodes[leaf].box;
+	auto index = _root;
+	while (!_nodes[index].IsLeaf())
+	{
+		const auto& node = _nodes[index];
+		const auto area = SurfaceArea(node.box);
+		const auto combinedArea = SurfaceArea(Combine(node.box, leafBox));
+
+		// Cost of making a new parent for this node and the leaf
+		const auto cost = 2.0f * combinedArea;
+		// Minimum cost of pushing the leaf further down the tree
+		const auto inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [this, &leafBox, inheritanceCost](int32_t child) {
+			const auto& childBox = _nodes[child].box;
+			const auto combined = SurfaceArea(Combine(leafBox, childBox));
+			if (_nodes[child].IsLeaf())
+			{
+				return combined + inheritanceCost;
+			}
+			return combined - SurfaceArea(childBox) + inheritanceCost;
+		};
+		const auto cost1 = descendCost(node.child1);
+		const auto cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+	const auto sibling = index;
+
+	const auto oldParent = _nodes[sibling].parent;
+	const auto newParent = AllocateNode();
+	_nodes[newParent].parent = oldParent;
+	_nodes[newParent].box = Combine(leafBox, _nodes[sibling].box);
+	_nodes[newParent].height = _nodes[sibling].height + 1;
+	_nodes[newParent].child1 = sibling;
+	_nodes[newParent].child2 = leaf;
+	_nodes[sibling].parent = newParent;
+	_nodes[leaf].parent = newParent;
+
+	if (oldParent == k_NullNode)
+	{
+		_root = newParent;
+	}
+	else if (_nodes[oldParent].child1 == sibling)
+	{
+		_nodes[oldParent].child1 = newParent;
+	}
+	else
+	{
+		_nodes[oldParent].child2 = newParent;
+	}
+
+	Refit(_nodes[leaf].parent);
+}
+
+void DynamicAabbTree::RemoveLeaf(int32_t leaf)
+{
+	if (leaf == _root)
+	{
+		_root = k_NullNode;
+		return;
+	}
+
+	const auto parent = _nodes[leaf].parent;
+	const auto grandParent = _nodes[parent].parent;
+	const auto sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+	// The sibling takes the place of the parent
+	_nodes[sibling].parent = grandParent;
+	FreeNode(parent);
+	if (grandParent == k_NullNode)
+	{
+		_root = sibling;
+		return;
+	}
+
+	if (_nodes[grandParent].child1 == parent)
+	{
+		_nodes[grandParent].child1 = sibling;
+	}
+	else
+	{
+		_nodes[grandParent].child2 = sibling;
+	}
+	Refit(grandParent);
+}
+
+void DynamicAabbTree::Refit(int32_t nodeId)
+{
+	auto index = nodeId;
+	while (index != k_NullNode)
+	{
+		index = Balance(index);
+
+		auto& node = _nodes[index];
+		const auto& child1 = _nodes[node.child1];
+		const auto& child2 = _nodes[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.box = Combine(child1.box, child2.box);
+
+		index = node.parent;
+	}
+}
+
+int32_t DynamicAabbTree::Balance(int32_t a)
+{
+	// With children b and c of a, and f and g of c: when c is taller than b by more than one level, c is rotated up
+	// in place of a, a takes the shorter of f and g and c keeps the taller one. Symmetric when b is the tall child.
+	auto& nodeA = _nodes[a];
+	if (nodeA.IsLeaf() || nodeA.height < 2)
+	{
+		return a;
+	}
+
+	const auto b = nodeA.child1;
+	const auto c = nodeA.child2;
+	const auto balance = _nodes[c].height - _nodes[b].height;
+
+	auto rotate = [this, a](int32_t shortChild, int32_t tallChild) {
+		auto& oldRoot = _nodes[a];
+		auto& nodeTall = _nodes[tallChild];
+		const auto f = nodeTall.child1;
+		const auto g = nodeTall.child2;
+
+		// Swap a and the tall child
+		nodeTall.child1 = a;
+		nodeTall.parent = oldRoot.parent;
+		oldRoot.parent = tallChild;
+		if (nodeTall.parent == k_NullNode)
+		{
+			_root = tallChild;
+		}
+		else if (_nodes[nodeTall.parent].child1 == a)
+		{
+			_nodes[nodeTall.parent].child1 = tallChild;
+		}
+		else
+		{
+			_nodes[nodeTall.parent].child2 = tallChild;
+		}
+
+		// The taller grandchild stays under the rotated node, the other replaces it under a
+		const auto keep = _nodes[f].height > _nodes[g].height ? f : g;
+		const auto move = keep == f ? g : f;
+		nodeTall.child2 = keep;
+		if (oldRoot.child1 == tallChild)
+		{
+			oldRoot.child1 = move;
+		}
+		else
+		{
+			oldRoot.child2 = move;
+		}
+		_nodes[move].parent = a;
+
+		oldRoot.box = Combine(_nodes[shortChild].box, _nodes[move].box);
+		oldRoot.height = 1 + std::max(_nodes[shortChild].height, _nodes[move].height);
+		nodeTall.box = Combine(oldRoot.box, _nodes[keep].box);
+		nodeTall.height = 1 + std::max(oldRoot.height, _nodes[keep].height);
+		return tallChild;
+	};
+
+	if (balance > 1)
+	{
+		return rotate(b, c);
+	}
+	if (balance < -1)
+	{
+		return rotate(c, b);
+	}
+	return a;
+}
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+
+namespace openblack
+{
+
+/// Bounding volume hierarchy of fattened boxes which is updated incrementally.
+/// Leaves are only reinserted when their box escapes the fat box, the tree is kept balanced with rotations.
+class DynamicAabbTree
+{
+public:
+	static constexpr int32_t k_NullNode = -1;
+
+	explicit DynamicAabbTree(float margin = 1.0f);
+
+	/// Insert a box and return a proxy id which stays valid until it is destroyed
+	int32_t CreateProxy(const AxisAlignedBoundingBox& box, uint32_t userData);
+	void DestroyProxy(int32_t proxy);
+	/// Returns true if the proxy had to be reinserted because the box left its fat box
+	bool MoveProxy(int32_t proxy, const AxisAlignedBoundingBox& box);
+	void Clear();
+
+	[[nodiscard]] uint32_t GetUserData(int32_t proxy) const { return _nodes[proxy].userData; }
+	[[nodiscard]] const AxisAlignedBoundingBox& GetFatBox(int32_t proxy) const { return _nodes[proxy].box; }
+	[[nodiscard]] size_t GetProxyCount() const { return _proxyCount; }
+	[[nodiscard]] int32_t GetHeight() const { return _root == k_NullNode ? 0 : _nodes[_root].height; }
+
+	[[nodiscard]] static bool Overlaps(const AxisAlignedBoundingBox& a, const AxisAlignedBoundingBox& b)
+	{
+		return glm::all(glm::lessThanEqual(a.minima, b.maxima)) && glm::all(glm::lessThanEqual(b.minima, a.maxima));
+	}
+
+	/// Slab test, writes the entry distance when the ray enters the box before tMax
+	[[nodiscard]] static bool RayIntersects(const AxisAlignedBoundingBox& box, const glm::vec3& origin,
+	                                        const glm::vec3& inverseDirection, float tMax, float& tEnter)
+	{
+		const auto t0 = (box.minima - origin) * inverseDirection;
+		const auto t1 = (box.maxima - origin) * inverseDirection;
+		const auto tNear = glm::min(t0, t1);
+		const auto tFar = glm::max(t0, t1);
+		tEnter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+		const auto tExit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, tMax));
+		return tEnter <= tExit;
+	}
+
+	/// False when the box is entirely behind one of the planes, given as normal and offset with normals facing inward
+	[[nodiscard]] static bool InFrontOfPlanes(const AxisAlignedBoundingBox& box, const std::array<glm::vec4, 6>& planes)
+	{
+		for (const auto& plane : planes)
+		{
+			const glm::vec3 normal(plane);
+			// Corner furthest along the normal
+			const auto corner = glm::mix(box.minima, box.maxima, glm::greaterThanEqual(normal, glm::vec3(0.0f)));
+			if (glm::dot(normal, corner) + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Visit the proxies of every leaf whose fat box passes \p test, which is also applied to internal nodes.
+	/// The callback receives the proxy id and returns false to stop the query.
+	/// The traversal stack is passed in so that batched queries can share its allocation.
+	template <typename NodeTest, typename Callback>
+	void Query(NodeTest&& test, Callback&& callback, std::vector<int32_t>& stack) const
+	{
+		if (_root == k_NullNode)
+		{
+			return;
+		}
+		stack.clear();
+		stack.push_back(_root);
+		while (!stack.empty())
+		{
+			const auto nodeId = stack.back();
+			stack.pop_back();
+			const auto& node = _nodes[nodeId];
+			if (!test(node.box))
+			{
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				if (!callback(nodeId))
+				{
+					return;
+				}
+			}
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	template <typename NodeTest, typename Callback>
+	void Query(NodeTest&& test, Callback&& callback) const
+	{
+		std::vector<int32_t> stack;
+		stack.reserve(64);
+		Query(std::forward<NodeTest>(test), std::forward<Callback>(callback), stack);
+	}
+
+	/// Visit the leaves along a ray in no particular order.
+	/// The callback receives the proxy id and the current tMax and returns the new tMax, which lets closest hit queries
+	/// prune anything further than their best hit. Returning 0 stops the query.
+	template <typename Callback>
+	void RayCast(const glm::vec3& origin, const glm::vec3& direction, float tMax, Callback&& callback,
+	             std::vector<int32_t>& stack) const
+	{
+		if (_root == k_NullNode)
+		{
+			return;
+		}
+		const auto inverseDirection = 1.0f / direction;
+		stack.clear();
+		stack.push_back(_root);
+		while (!stack.empty())
+		{
+			const auto nodeId = stack.back();
+			stack.pop_back();
+			const auto& node = _nodes[nodeId];
+			float tEnter;
+			if (!RayIntersects(node.box, origin, inverseDirection, tMax, tEnter))
+			{
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				tMax = callback(nodeId, tMax);
+				if (tMax <= 0.0f)
+				{
+					return;
+				}
+			}
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	template <typename Callback>
+	void RayCast(const glm::vec3& origin, const glm::vec3& direction, float tMax, Callback&& callback) const
+	{
+		std::vector<int32_t> stack;
+		stack.reserve(64);
+		RayCast(origin, direction, tMax, std::forward<Callback>(callback), stack);
+	}
+
+private:
+	struct Node
+	{
+		AxisAlignedBoundingBox box;
+		/// Parent when allocated, next free node when in the free list
+		int32_t parent;
+		int32_t child1;
+		int32_t child2;
+		/// Leaves are 0, free nodes are -1
+		int32_t height;
+		uint32_t userData;
+
+		[[nodiscard]] bool IsLeaf() const { return child1 == k_NullNode; }
+	};
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t nodeId);
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf);
+	/// Rotate the subtree at \p a if its children heights differ by more than one, returns the new subtree root
+	int32_t Balance(int32_t a);
+	/// Recompute boxes and heights from \p nodeId up to the root, balancing on the way
+	void Refit(int32_t nodeId);
+
+	std::vector<Node> _nodes;
+	int32_t _root {k_NullNode};
+	int32_t _freeList {k_NullNode};
+	size_t _proxyCount {0};
+	float _margin;
+};
+
+} // namespace openblack
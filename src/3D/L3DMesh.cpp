@@ -9,6 +9,7 @@
 
 #include "L3DMesh.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
@@ -132,6 +133,8 @@ void L3DMesh::Load(const l3d::L3DFile& l3d)
 	}
 
 	auto submeshCount = l3d.GetSubmeshHeaders().size();
+	std::optional<uint32_t> occluderSubMeshIndex;
+	const L3DSubMesh* occluderSubMesh = nullptr;
 	for (uint32_t i = 0; i < submeshCount; ++i)
 	{
 		auto subMesh = std::make_unique<L3DSubMesh>(*this);
@@ -140,6 +143,10 @@ void L3DMesh::Load(const l3d::L3DFile& l3d)
 			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open L3DSubMesh from file: {}", l3d.GetFilename());
 			continue;
 		}
+		if (!subMesh->GetFlags().isPhysics && !occluderSubMeshIndex.has_value())
+		{
+			occluderSubMeshIndex = i;
+		}
 		if (subMesh->GetFlags().isPhysics)
 		{
 			const auto& verticesSpan = l3d.GetVertexSpan(i);
@@ -155,11 +162,53 @@ void L3DMesh::Load(const l3d::L3DFile& l3d)
 		_boundingBox.maxima = glm::max(_boundingBox.maxima, bb.maxima);
 
 		_subMeshes.emplace_back(std::move(subMesh));
+		if (occluderSubMeshIndex == i)
+		{
+			occluderSubMesh = _subMeshes.back().get();
+		}
 	}
 	// TODO(bwrsandman): if no physics mesh was found, make physics mesh the bounding box
 
+	// Only meshes at least this big on every axis are worth rasterising as occluders
+	constexpr float k_OccluderMinimumSize = 10.0f;
+	const auto size = _boundingBox.Size();
+	if (occluderSubMesh != nullptr && !IsBoned() && std::min({size.x, size.y, size.z}) >= k_OccluderMinimumSize)
+	{
+		LoadOccluder(l3d, *occluderSubMeshIndex, *occluderSubMesh);
+	}
+
 	// TODO(bwrsandman): store vertex and index buffers at mesh level
-	bgfx::frame();
+}
+
+void L3DMesh::LoadOccluder(const l3d::L3DFile& l3d, uint32_t subMeshIndex, const L3DSubMesh& subMesh)
+{
+	const auto primitiveSpan = l3d.GetPrimitiveSpan(subMeshIndex);
+	const auto& verticesSpan = l3d.GetVertexSpan(subMeshIndex);
+	const auto& indexSpan = l3d.GetIndexSpan(subMeshIndex);
+	const auto& primitives = subMesh.GetPrimitives();
+
+	// Indices are relative to their primitive, rebase them like the sub-mesh index buffer
+	uint32_t startVertex = 0;
+	for (size_t i = 0; i < primitives.size(); ++i)
+	{
+		if (primitives[i].IsOpaque())
+		{
+			for (uint32_t j = 0; j < primitives[i].indicesCount; ++j)
+			{
+				_occluderIndices.push_back(static_cast<uint16_t>(indexSpan[primitives[i].indicesOffset + j] + startVertex));
+			}
+		}
+		startVertex += primitiveSpan[i].numVertices;
+	}
+
+	if (!_occluderIndices.empty())
+	{
+		_occluderVertices.reserve(verticesSpan.size());
+		for (const auto& vertex : verticesSpan)
+		{
+			_occluderVertices.push_back(glm::make_vec3(&vertex.position.x));
+		}
+	}
 }
 
 bool L3DMesh::LoadFromFile(const std::filesystem::path& path)
@@ -182,13 +231,14 @@ bool L3DMesh::LoadFromFile(const std::filesystem::path& path)
 	return true;
 }
 
-bool L3DMesh::LoadFromBuffer(const std::vector<uint8_t>& data)
+bool L3DMesh::LoadFromBuffer(std::span<const uint8_t> data)
 {
 	l3d::L3DFile l3d;
 
+	// The sections are only read while loading, they can stay in the buffer
 	try
 	{
-		l3d.Open(data);
+		l3d.OpenView(data);
 	}
 	catch (std::runtime_error& err)
 	{
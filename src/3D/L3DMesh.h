@@ -12,6 +12,7 @@
 #include <filesystem>
 #include <limits>
 #include <optional>
+#include <span>
 #include <unordered_map>
 
 #include <glm/gtc/quaternion.hpp>
@@ -87,7 +88,7 @@ class L3DMesh
 
 	void Load(const l3d::L3DFile& l3d);
 	bool LoadFromFile(const std::filesystem::path& path);
-	bool LoadFromBuffer(const std::vector<uint8_t>& data);
+	bool LoadFromBuffer(std::span<const uint8_t> data);
 
 	[[nodiscard]] uint8_t GetNumSubMeshes() const { return static_cast<uint8_t>(_subMeshes.size()); }
 	[[nodiscard]] const std::vector<std::unique_ptr<L3DSubMesh>>& GetSubMeshes() const { return _subMeshes; }
@@ -102,8 +103,13 @@ class L3DMesh
 	[[nodiscard]] const btConvexShape& GetPhysicsMesh() const { return *_physicsMesh; }
 	[[nodiscard]] float GetMass() const { return _physicsMass; }
 	[[nodiscard]] AxisAlignedBoundingBox GetBoundingBox() const { return _boundingBox; }
+	[[nodiscard]] bool HasOccluder() const { return !_occluderIndices.empty(); }
+	[[nodiscard]] const std::vector<glm::vec3>& GetOccluderVertices() const { return _occluderVertices; }
+	[[nodiscard]] const std::vector<uint16_t>& GetOccluderIndices() const { return _occluderIndices; }
 
 private:
+	void LoadOccluder(const l3d::L3DFile& l3d, uint32_t subMeshIndex, const L3DSubMesh& subMesh);
+
 	l3d::L3DMeshFlags _flags;
 	std::string _debugName;
 
@@ -122,6 +128,9 @@ class L3DMesh
 	    {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()},
 	};
 	std::string _nameData;
+	/// CPU copy of the opaque triangles of large static meshes, rasterised to hide what is behind them
+	std::vector<glm::vec3> _occluderVertices;
+	std::vector<uint16_t> _occluderIndices;
 
 public:
 	[[nodiscard]] const std::string& GetDebugName() const { return _debugName; }
@@ -53,6 +53,9 @@ class L3DSubMesh
 		bool modulateAlpha;  ///< Multiply ouput alpha by a uniform
 		bool thresholdAlpha; ///< Dismiss fragments below a certain threshold
 		float alphaCutoutThreshold;
+
+		/// Written to depth and nothing behind shows through
+		[[nodiscard]] bool IsOpaque() const { return depthWrite && !alphaTest && blend == BlendMode::Disabled; }
 	};
 
 public:
@@ -33,13 +33,10 @@ LandVertex::LandVertex(const glm::vec3& position, const glm::vec3& weight, const
 {
 }
 
-void LandBlock::BuildMesh(LandIslandInterface& island)
+namespace
+{
+VertexDecl GetLandVertexDecl()
 {
-	if (_mesh != nullptr)
-	{
-		_mesh.reset();
-	}
-
 	VertexDecl decl;
 	decl.reserve(7);
 	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
@@ -55,10 +52,20 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	decl.emplace_back(VertexAttrib::Attribute::Color0, static_cast<uint8_t>(4), VertexAttrib::Type::Uint8, true);
 	// water alpha
 	decl.emplace_back(VertexAttrib::Attribute::Color3, static_cast<uint8_t>(1), VertexAttrib::Type::Float, true);
+	return decl;
+}
+} // namespace
+
+void LandBlock::BuildMesh(LandIslandInterface& island)
+{
+	if (_mesh != nullptr)
+	{
+		_mesh.reset();
+	}
 
 	const auto* verts = BuildVertexList(island);
 
-	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, decl);
+	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, GetLandVertexDecl());
 	_mesh = std::make_unique<Mesh>(vertexBuffer);
 
 	_dynamicsMeshInterface =
@@ -74,13 +81,31 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	_rigidBody->setUserIndex(-1);
 }
 
+void LandBlock::UpdateMesh(LandIslandInterface& island)
+{
+	assert(_mesh != nullptr);
+	assert(_physicsMesh != nullptr);
+
+	const auto* verts = BuildVertexList(island);
+
+	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, GetLandVertexDecl());
+	_mesh = std::make_unique<Mesh>(vertexBuffer);
+
+	// The rigid body is registered with the dynamics world so the shape is refit rather than replaced
+	_dynamicsMeshInterface->Update(verts->data, verts->size, vertexBuffer->GetStrideBytes());
+	btVector3 aabbMin;
+	btVector3 aabbMax;
+	_dynamicsMeshInterface->calculateAabbBruteForce(aabbMin, aabbMax);
+	_physicsMesh->refitTree(aabbMin, aabbMax);
+}
+
 const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
 {
 	// reserve 16*16 quads of 2 tris with 3 verts = 1536
 	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(LandVertex) * 1536);
 	auto* vertices = reinterpret_cast<LandVertex*>(verticesMem->data);
 
-	auto countries = island.GetCountries();
+	const auto& countries = island.GetCountries();
 
 	// auto neighbourBlockR = island.GetBlock(glm::u8vec2(_block->blockX + 1, _block->blockZ));
 	// auto neighbourBlockUp = island.GetBlock(glm::u8vec2(_block->blockX, _block->blockZ + 1));
@@ -232,6 +257,12 @@ const lnd::LNDCell* LandBlock::GetCells() const
 	return _block ? _block->cells.data() : nullptr;
 }
 
+lnd::LNDCell* LandBlock::GetCells()
+{
+	assert(_block);
+	return _block ? _block->cells.data() : nullptr;
+}
+
 glm::ivec2 LandBlock::GetBlockPosition() const
 {
 	assert(_block);
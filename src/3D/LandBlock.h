@@ -63,9 +63,12 @@ class LandBlock
 public:
 	LandBlock() = default;
 	void BuildMesh(LandIslandInterface& island);
+	/// Rebuild the vertices after cells were edited, refitting the existing collision shape in place
+	void UpdateMesh(LandIslandInterface& island);
 
 	[[nodiscard]] const graphics::Mesh& GetMesh() const { return *_mesh; }
 	[[nodiscard]] const lnd::LNDCell* GetCells() const;
+	[[nodiscard]] lnd::LNDCell* GetCells();
 	[[nodiscard]] glm::ivec2 GetBlockPosition() const;
 	[[nodiscard]] glm::vec2 GetMapPosition() const;
 	[[nodiscard]] std::unique_ptr<btRigidBody>& GetRigidBody() { return _rigidBody; };
@@ -12,8 +12,10 @@
 #include "LandIsland.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <LNDCompressedMaterialFile.h>
 #include <LNDFile.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
@@ -21,10 +23,12 @@
 #include <stb_image_write.h>
 
 #include "Dynamics/LandBlockBulletMeshInterface.h"
+#include "ECS/Systems/DynamicsSystemInterface.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/Mesh.h"
 #include "Graphics/Texture2D.h"
+#include "Graphics/UploadManager.h"
 #include "Locator.h"
 
 using namespace openblack;
@@ -70,6 +74,8 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	{
 		_landBlocks[i].SetLndBlock(lndBlocks[i]);
 	}
+	_dirtyBlocks.assign(_landBlocks.size(), false);
+	_dirtyCells.reset();
 
 	_extentIndexMin.x = std::numeric_limits<uint16_t>::max();
 	_extentIndexMin.y = std::numeric_limits<uint16_t>::max();
@@ -102,10 +108,14 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 
 	const auto indexSize = _extentIndexMax - _extentIndexMin + glm::u16vec2(1, 1);
 
+	// Created empty so that it stays mutable for terrain edits
 	_heightMap = std::make_unique<Texture2D>("Height Map");
 	const auto heightMapData = CreateHeightMap();
-	_heightMap->Create(indexSize.x * k_CellCount + 1, indexSize.y * k_CellCount + 1, 1, graphics::Format::R8,
-	                   Wrapping::ClampEdge, Filter::Linear, heightMapData.data(), static_cast<uint32_t>(heightMapData.size()));
+	const auto heightMapWidth = static_cast<uint16_t>(indexSize.x * k_CellCount + 1);
+	const auto heightMapHeight = static_cast<uint16_t>(indexSize.y * k_CellCount + 1);
+	_heightMap->Create(heightMapWidth, heightMapHeight, 1, graphics::Format::R8, Wrapping::ClampEdge, Filter::Linear);
+	_heightMap->Update(0, 0, heightMapWidth, heightMapHeight, heightMapData.data(),
+	                   static_cast<uint32_t>(heightMapData.size()));
 
 	const auto res = indexSize * glm::u16vec2(lnd::LNDMaterial::k_Width, lnd::LNDMaterial::k_Height);
 	_footprintFrameBuffer = std::make_unique<FrameBuffer>("Footprints", res.x, res.y, graphics::Format::RGBA8);
@@ -118,37 +128,63 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 
 	auto materialCount = static_cast<uint16_t>(lnd.GetMaterials().size());
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "[LandIsland] loading {} textures", materialCount);
-	std::vector<uint16_t> rgba5TextureData;
-	rgba5TextureData.resize(lnd::LNDMaterial::k_Width * lnd::LNDMaterial::k_Height * lnd.GetMaterials().size());
-	for (size_t i = 0; i < lnd.GetMaterials().size(); i++)
+	const auto compressedMaterials = LoadCompressedMaterials(path, lnd.GetMaterials());
+	_materialArray = std::make_unique<Texture2D>("LandIslandMaterialArray");
+	_materialArray->Create(lnd::LNDMaterial::k_Width, lnd::LNDMaterial::k_Height, materialCount, Format::BlockCompression1,
+	                       Wrapping::ClampEdge, Filter::LinearMipmapLinear, compressedMaterials.GetBlocks().data(),
+	                       static_cast<uint32_t>(compressedMaterials.GetBlocks().size()));
+
+	// GetNoise is the only CPU reader of the extra textures, the GPU gets bump in red and noise in green
+	const auto& extra = lnd.GetExtra();
+	_noiseMap = extra.noise.texels;
+	std::vector<uint8_t> bumpNoiseData(extra.bump.texels.size() * 2);
+	for (size_t i = 0; i < extra.bump.texels.size(); ++i)
 	{
-		std::memcpy(&rgba5TextureData[lnd::LNDMaterial::k_Width * lnd::LNDMaterial::k_Height * i],
-		            lnd.GetMaterials()[i].texels.data(),
-		            sizeof(lnd.GetMaterials()[i].texels[0]) * lnd.GetMaterials()[i].texels.size());
+		bumpNoiseData[2 * i + 0] = extra.bump.texels[i];
+		bumpNoiseData[2 * i + 1] = extra.noise.texels[i];
 	}
-	_materialArray = std::make_unique<Texture2D>("LandIslandMaterialArray");
-	_materialArray->Create(lnd::LNDMaterial::k_Width, lnd::LNDMaterial::k_Height, materialCount, Format::BGR5A1,
-	                       Wrapping::ClampEdge, Filter::Linear, rgba5TextureData.data(),
-	                       static_cast<uint32_t>(rgba5TextureData.size() * sizeof(rgba5TextureData[0])));
-
-	// read noise map into Texture2D
-	_noiseMap = lnd.GetExtra().noise.texels;
-	_textureNoiseMap = std::make_unique<Texture2D>("LandIslandNoiseMap");
-	_textureNoiseMap->Create(lnd::LNDBumpMap::k_Width, lnd::LNDBumpMap::k_Height, 1, Format::R8, Wrapping::ClampEdge,
-	                         Filter::Linear, _noiseMap.data(), static_cast<uint32_t>(_noiseMap.size() * sizeof(_noiseMap[0])));
-
-	// read bump map into Texture2D
-	_textureBumpMap = std::make_unique<Texture2D>("LandIslandBumpMap");
-	_textureBumpMap->Create(lnd::LNDBumpMap::k_Width, lnd::LNDBumpMap::k_Height, 1, Format::R8, Wrapping::Repeat,
-	                        Filter::Linear, lnd.GetExtra().bump.texels.data(),
-	                        static_cast<uint32_t>(sizeof(lnd.GetExtra().bump.texels[0]) * lnd.GetExtra().bump.texels.size()));
+	_textureBumpMap = std::make_unique<Texture2D>("LandIslandBumpNoiseMap");
+	_textureBumpMap->Create(lnd::LNDBumpMap::k_Width, lnd::LNDBumpMap::k_Height, 1, Format::RG8, Wrapping::Repeat,
+	                        Filter::Linear, UploadManager::Take(std::move(bumpNoiseData)));
 
 	// build the meshes (we could move this elsewhere)
 	for (auto& block : _landBlocks)
 	{
 		block.BuildMesh(*this);
 	}
-	bgfx::frame();
+}
+
+lnd::LNDCompressedMaterialFile LandIsland::LoadCompressedMaterials(const std::filesystem::path& path,
+                                                                    const std::vector<lnd::LNDMaterial>& materials)
+{
+	// Prefer the cache written by `lndtool compress` next to the lnd file, encoding on load is a few hundred milliseconds
+	auto cachePath = path;
+	cachePath.replace_extension(".lndc");
+	auto& fileSystem = Locator::filesystem::value();
+	if (fileSystem.Exists(cachePath))
+	{
+		lnd::LNDCompressedMaterialFile cache;
+		try
+		{
+			cache.Open(fileSystem.ReadAll(cachePath));
+			if (cache.GetHeader().materialCount == materials.size() &&
+			    cache.GetHeader().sourceHash == lnd::LNDCompressedMaterialFile::HashMaterials(materials))
+			{
+				return cache;
+			}
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Compressed materials {} are out of date, ignoring", cachePath.string());
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to open compressed materials {}: {}", cachePath.string(),
+			                   err.what());
+		}
+	}
+
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "[LandIsland] compressing {} materials", materials.size());
+	lnd::LNDCompressedMaterialFile compressed;
+	compressed.Compress(materials);
+	return compressed;
 }
 
 float LandIsland::GetHeightAt(glm::vec2 vec) const
@@ -207,6 +243,114 @@ const lnd::LNDCell& LandIsland::GetCell(const glm::u16vec2& coordinates) const
 	return _landBlocks[blockIndex - 1].GetCells()[cellIndex];
 }
 
+void LandIsland::SetCellAltitude(const glm::u16vec2& coordinates, uint8_t altitude)
+{
+	const auto& owner = GetCell(coordinates);
+	if (&owner == &k_EmptyCell || owner.altitude == altitude)
+	{
+		return;
+	}
+
+	// Blocks store 17x17 cells where the last row and column duplicate the first of the next block. Vertices on the far
+	// edge of a block are built from the neighbour's cells so every block touching this corner needs to be updated.
+	for (uint16_t dx = 0; dx < 2; ++dx)
+	{
+		for (uint16_t dz = 0; dz < 2; ++dz)
+		{
+			if (coordinates.x < dx || coordinates.y < dz)
+			{
+				continue;
+			}
+			const auto neighbour = coordinates - glm::u16vec2(dx, dz);
+			const uint16_t lookupIndex = ((neighbour.x & ~0xFU) << 1U) | (neighbour.y >> 4U);
+			const uint8_t blockIndex = _blockIndexLookup.at(lookupIndex);
+			if (blockIndex == 0)
+			{
+				continue;
+			}
+			const auto local = coordinates - glm::u16vec2(neighbour.x & ~0xFU, neighbour.y & ~0xFU);
+			_landBlocks[blockIndex - 1].GetCells()[local.x * 0x11u + local.y].altitude = altitude;
+			_dirtyBlocks[blockIndex - 1] = true;
+		}
+	}
+
+	if (_dirtyCells.has_value())
+	{
+		_dirtyCells->minimum = glm::min(_dirtyCells->minimum, coordinates);
+		_dirtyCells->maximum = glm::max(_dirtyCells->maximum, coordinates);
+	}
+	else
+	{
+		_dirtyCells = U16Extent2 {coordinates, coordinates};
+	}
+}
+
+void LandIsland::AdjustAltitude(const glm::vec2& position, float radius, float delta)
+{
+	if (radius <= 0.0f)
+	{
+		return;
+	}
+
+	const auto cellMin = glm::u16vec2(glm::clamp(glm::floor((position - radius) / k_CellSize), 0.0f, 511.0f));
+	const auto cellMax = glm::u16vec2(glm::clamp(glm::ceil((position + radius) / k_CellSize), 0.0f, 511.0f));
+	for (uint16_t x = cellMin.x; x <= cellMax.x; ++x)
+	{
+		for (uint16_t z = cellMin.y; z <= cellMax.y; ++z)
+		{
+			const auto distance = glm::distance(glm::vec2(x, z) * k_CellSize, position);
+			if (distance > radius)
+			{
+				continue;
+			}
+			// Smoothstep falloff so that the brush does not leave a ridge at its edge
+			const float t = 1.0f - distance / radius;
+			const float falloff = t * t * (3.0f - 2.0f * t);
+			const auto coordinates = glm::u16vec2(x, z);
+			const float altitude = GetCell(coordinates).altitude + falloff * delta / k_HeightUnit;
+			SetCellAltitude(coordinates, static_cast<uint8_t>(glm::clamp(glm::round(altitude), 0.0f, 255.0f)));
+		}
+	}
+}
+
+void LandIsland::UpdateDirtyBlocks()
+{
+	if (!_dirtyCells.has_value())
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < _landBlocks.size(); ++i)
+	{
+		if (!_dirtyBlocks[i])
+		{
+			continue;
+		}
+		_landBlocks[i].UpdateMesh(*this);
+		if (Locator::dynamicsSystem::has_value())
+		{
+			Locator::dynamicsSystem::value().UpdateRigidBody(_landBlocks[i].GetRigidBody().get());
+		}
+	}
+	std::fill(_dirtyBlocks.begin(), _dirtyBlocks.end(), false);
+
+	// Only upload the part of the height map covering the edited cells
+	const auto size = _dirtyCells->maximum - _dirtyCells->minimum + glm::u16vec2(1, 1);
+	std::vector<uint8_t> texels(size.x * size.y);
+	for (uint16_t y = 0; y < size.y; ++y)
+	{
+		for (uint16_t x = 0; x < size.x; ++x)
+		{
+			texels[y * size.x + x] = GetCell(_dirtyCells->minimum + glm::u16vec2(x, y)).altitude;
+		}
+	}
+	const auto texelOffset = _dirtyCells->minimum - _extentIndexMin * static_cast<uint16_t>(k_CellCount);
+	_heightMap->Update(texelOffset.x, texelOffset.y, size.x, size.y, texels.data(), static_cast<uint32_t>(texels.size()));
+
+	_dirtyCells.reset();
+	++_revision;
+}
+
 void LandIsland::DumpTextures() const
 {
 	_materialArray->DumpTexture();
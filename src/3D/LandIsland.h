@@ -12,6 +12,7 @@
 #include <array>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,12 @@
 
 namespace openblack
 {
+namespace lnd
+{
+class LNDCompressedMaterialFile;
+struct LNDMaterial;
+} // namespace lnd
+
 class LandIsland final: public LandIslandInterface
 {
 public:
@@ -31,17 +38,31 @@ class LandIsland final: public LandIslandInterface
 	[[nodiscard]] const LandBlock* GetBlock(const glm::u8vec2& coordinates) const;
 	[[nodiscard]] const lnd::LNDCell& GetCell(const glm::u16vec2& coordinates) const override;
 
+	void SetCellAltitude(const glm::u16vec2& coordinates, uint8_t altitude) override;
+	void AdjustAltitude(const glm::vec2& position, float radius, float delta) override;
+	void UpdateDirtyBlocks() override;
+	[[nodiscard]] uint32_t GetRevision() const override { return _revision; }
+
 	// Debug
 	void DumpTextures() const override;
 	void DumpMaps() const override;
 
 private:
+	/// Load the offline block compressed materials if they match the lnd, otherwise encode them
+	[[nodiscard]] static lnd::LNDCompressedMaterialFile LoadCompressedMaterials(const std::filesystem::path& path,
+	                                                                            const std::vector<lnd::LNDMaterial>& materials);
 	[[nodiscard]] std::vector<uint8_t> CreateHeightMap() const;
 	std::vector<LandBlock> _landBlocks;
 	std::vector<lnd::LNDCountry> _countries;
 
 	std::array<uint8_t, 1024> _blockIndexLookup {0};
 
+	/// Blocks whose meshes sample an edited cell, indexed like _landBlocks
+	std::vector<bool> _dirtyBlocks;
+	/// Bounds of the cells edited since the last UpdateDirtyBlocks, used for partial height map uploads
+	std::optional<U16Extent2> _dirtyCells;
+	uint32_t _revision {0};
+
 	// Renderer, Dynamics
 public:
 	[[nodiscard]] std::vector<LandBlock>& GetBlocks() override { return _landBlocks; }
@@ -65,7 +86,7 @@ class LandIsland final: public LandIslandInterface
 	std::unique_ptr<graphics::Texture2D> _countryLookup;
 
 	std::unique_ptr<graphics::Texture2D> _heightMap;
-	std::unique_ptr<graphics::Texture2D> _textureNoiseMap;
+	/// Bump in the red channel and noise in the green channel
 	std::unique_ptr<graphics::Texture2D> _textureBumpMap;
 
 	std::unique_ptr<graphics::FrameBuffer> _footprintFrameBuffer;
@@ -76,6 +97,7 @@ class LandIsland final: public LandIslandInterface
 	glm::vec2 _extentMin;
 	glm::vec2 _extentMax;
 
+	/// Kept on the CPU for GetNoise, used when building block vertices
 	std::array<uint8_t, 256 * 256> _noiseMap;
 };
 } // namespace openblack
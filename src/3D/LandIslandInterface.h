@@ -42,6 +42,13 @@ class LandIslandInterface
 	[[nodiscard]] virtual float GetHeightAt(glm::vec2) const = 0;
 	[[nodiscard]] virtual const lnd::LNDCell& GetCell(const glm::u16vec2& coordinates) const = 0;
 
+	// Terrain editing, changes are only visible to the renderer and dynamics after UpdateDirtyBlocks
+	virtual void SetCellAltitude(const glm::u16vec2& coordinates, uint8_t altitude) = 0;
+	virtual void AdjustAltitude(const glm::vec2& position, float radius, float delta) = 0;
+	virtual void UpdateDirtyBlocks() = 0;
+	/// Changes every time edits are applied, lets CPU side copies of the terrain know when to rebuild
+	[[nodiscard]] virtual uint32_t GetRevision() const = 0;
+
 	// Debug
 	virtual void DumpTextures() const = 0;
 	virtual void DumpMaps() const = 0;
@@ -9,14 +9,23 @@
 
 #include "Sky.h"
 
+#include <cmath>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+#include <LNDCompressedMaterialFile.h>
+#include <bgfx/bgfx.h>
 #include <glm/vec3.hpp>
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
 #include "3D/L3DMesh.h"
-#include "Common/Bitmap16B.h"
 #include "Common/StringUtils.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "Graphics/Texture2D.h"
+#include "Graphics/UploadManager.h"
 #include "Locator.h"
 
 using namespace openblack::filesystem;
@@ -25,11 +34,13 @@ using namespace openblack::graphics;
 namespace openblack
 {
 
-Sky::Sky()
+Sky::Sky(bool compressed, bool resident)
+    : _resident(resident)
 {
 	auto& fileSystem = Locator::filesystem::value();
 
 	SetDayNightTimes(4.5, 7.0, 7.5, 8.25);
+	_timeOfDay = 1.0f;
 
 	// load in the mesh
 	_model = std::make_unique<L3DMesh>("Sky");
@@ -41,6 +52,46 @@ Sky::Sky()
 	_model->LoadFromFile(fileSystem.GetPath<filesystem::Path::WeatherSystem>() / "sky.l3d");
 #endif
 
+	LoadBitmaps();
+	if (compressed)
+	{
+		LoadCompressed();
+	}
+
+	_texture = std::make_unique<Texture2D>("Sky");
+	const auto format = _compressed ? Format::BlockCompression1 : Format::BGR5A1;
+	const auto filter = _compressed ? Filter::LinearMipmapLinear : Filter::Linear;
+	if (_resident)
+	{
+		const auto layers = static_cast<uint16_t>(k_ResidentSize.x * k_ResidentSize.y);
+		_texture->Create(k_TextureResolution[0], k_TextureResolution[1], layers, format, Wrapping::ClampEdge, filter, nullptr,
+		                 0);
+		UpdateResidentLayers();
+	}
+	else
+	{
+		const auto* data = _compressed ? static_cast<const void*>(_compressed->GetBlocks().data()) : _bitmaps.data();
+		const auto size = _compressed ? _compressed->GetBlocks().size() : _bitmaps.size() * sizeof(_bitmaps[0]);
+		_texture->Create(k_TextureResolution[0], k_TextureResolution[1], k_TextureResolution[2], format,
+		                 Wrapping::ClampEdge, filter, UploadManager::Copy(data, static_cast<uint32_t>(size)));
+		_compressed.reset();
+	}
+
+	// Only resident layers are uploaded again later, from the blocks when compressed
+	if (_compressed || !_resident)
+	{
+		_bitmaps.clear();
+		_bitmaps.shrink_to_fit();
+	}
+}
+
+Sky::~Sky() = default;
+
+void Sky::LoadBitmaps()
+{
+	auto& fileSystem = Locator::filesystem::value();
+
+	_bitmaps.resize(k_LayerTexels * k_TextureResolution[2]);
 	for (uint32_t idx = 0; const auto& alignment : k_Alignments)
 	{
 		for (const auto& timeView : k_Times)
@@ -56,19 +107,110 @@ Sky::Sky()
 			const auto path = fileSystem.GetPath<filesystem::Path::WeatherSystem>() / filename;
 			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading sky texture: {}", path.generic_string());
 
-			Bitmap16B* bitmap = Bitmap16B::LoadFromFile(path);
-			memcpy(&_bitmaps.at(idx * k_TextureResolution[0] * k_TextureResolution[1]), bitmap->Data(), bitmap->Size());
-			delete bitmap;
+			// Header of 0, width, height, 0 followed by the texels, which are read in place
+			std::array<uint32_t, 4> header;
+			auto stream = fileSystem.Open(path, Stream::Mode::Read);
+			stream->Read(&header);
+			const auto texelCount = std::min<size_t>(static_cast<size_t>(header[1]) * header[2], k_LayerTexels);
+			stream->Read(reinterpret_cast<uint8_t*>(&_bitmaps[idx * k_LayerTexels]), texelCount * sizeof(_bitmaps[0]));
 			++idx;
 		}
 	}
+}
 
-	_texture = std::make_unique<Texture2D>("Sky");
-	_timeOfDay = 1.0f;
+void Sky::LoadCompressed()
+{
+	auto& fileSystem = Locator::filesystem::value();
+	const auto cachePath = fileSystem.GetCachePath() / "sky.lndc";
+	const auto hash = lnd::LNDCompressedMaterialFile::HashTexels(_bitmaps);
 
-	_texture->Create(k_TextureResolution[0], k_TextureResolution[1], k_TextureResolution[2], Format::BGR5A1,
-	                 Wrapping::ClampEdge, Filter::Linear, _bitmaps.data(),
-	                 static_cast<uint32_t>(_bitmaps.size() * sizeof(_bitmaps[0])));
+	if (fileSystem.Exists(cachePath))
+	{
+		auto cache = std::make_unique<lnd::LNDCompressedMaterialFile>();
+		try
+		{
+			cache->Open(fileSystem.ReadAll(cachePath));
+			if (cache->GetHeader().materialCount == k_TextureResolution[2] && cache->GetHeader().sourceHash == hash)
+			{
+				_compressed = std::move(cache);
+				return;
+			}
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Compressed sky {} is out of date, ignoring", cachePath.string());
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to open compressed sky {}: {}", cachePath.string(), err.what());
+		}
+	}
+
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Compressing sky textures");
+	_compressed = std::make_unique<lnd::LNDCompressedMaterialFile>();
+	_compressed->Compress(_bitmaps);
+#if !__ANDROID__
+	// Unlike the island materials, which are cached by lndtool, the sky textures are the same for every island so the
+	// cache is written once from here, to the user's cache directory as the game directory may be read only.
+	try
+	{
+		std::filesystem::create_directories(cachePath.parent_path());
+		_compressed->Write(cachePath);
+	}
+	catch (std::exception& err)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to write compressed sky {}: {}", cachePath.string(), err.what());
+	}
+#endif
+}
+
+glm::uvec2 Sky::GetResidentOrigin() const
+{
+	const auto type = GetCurrentSkyType();
+	const auto alignment = std::clamp(_alignment + 1.0f, 0.0f, static_cast<float>(k_Alignments.size() - 1));
+	return {
+	    std::min(static_cast<uint32_t>(type), static_cast<uint32_t>(k_Times.size()) - k_ResidentSize.x),
+	    std::min(static_cast<uint32_t>(alignment), static_cast<uint32_t>(k_Alignments.size()) - k_ResidentSize.y),
+	};
+}
+
+void Sky::UpdateResidentLayers()
+{
+	if (!_resident)
+	{
+		return;
+	}
+	const auto origin = GetResidentOrigin();
+	if (origin == _residentOrigin)
+	{
+		return;
+	}
+	_residentOrigin = origin;
+	for (uint32_t alignment = 0; alignment < k_ResidentSize.y; ++alignment)
+	{
+		for (uint32_t type = 0; type < k_ResidentSize.x; ++type)
+		{
+			const auto source = (origin.y + alignment) * static_cast<uint32_t>(k_Times.size()) + origin.x + type;
+			UploadLayer(static_cast<uint16_t>(alignment * k_ResidentSize.x + type), source);
+		}
+	}
+}
+
+void Sky::UploadLayer(uint16_t destination, uint32_t source)
+{
+	if (!_compressed)
+	{
+		_texture->Update(0, 0, k_TextureResolution[0], k_TextureResolution[1], &_bitmaps[source * k_LayerTexels],
+		                 static_cast<uint32_t>(k_LayerTexels * sizeof(_bitmaps[0])), destination);
+		return;
+	}
+
+	const auto* blocks = &_compressed->GetBlocks()[source * lnd::LNDCompressedMaterialFile::GetMaterialSize()];
+	for (uint8_t mip = 0; mip < lnd::LNDCompressedMaterialFile::k_MipCount; ++mip)
+	{
+		const auto width = static_cast<uint16_t>(std::max(k_TextureResolution[0] >> mip, 1));
+		const auto height = static_cast<uint16_t>(std::max(k_TextureResolution[1] >> mip, 1));
+		const auto size = lnd::LNDCompressedMaterialFile::GetMipSize(mip);
+		_texture->Update(0, 0, width, height, blocks, size, destination, mip);
+		blocks += size;
+	}
 }
 
 void Sky::SetDayNightTimes(float nightFull, float duskStart, float duskEnd, float dayFull)
@@ -83,6 +225,25 @@ void Sky::SetTime(float time)
 {
 	assert(time <= 24.0f);
 	_timeOfDay = time;
+	UpdateResidentLayers();
+}
+
+void Sky::SetAlignment(float alignment)
+{
+	_alignment = alignment;
+	UpdateResidentLayers();
+}
+
+glm::vec4 Sky::GetTypeAlignmentUniform() const
+{
+	const auto type = GetCurrentSkyType();
+	const auto alignment = _alignment + 1.0f;
+	if (_resident)
+	{
+		const auto origin = glm::vec2(_residentOrigin);
+		return {type - origin.x, alignment - origin.y, k_ResidentSize};
+	}
+	return {type, alignment, k_Times.size(), k_Alignments.size()};
 }
 
 float Sky::GetCurrentSkyType() const
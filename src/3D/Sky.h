@@ -11,8 +11,11 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
-#include <glm/fwd.hpp>
+#include <LNDFile.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
 #include "Graphics/RenderPass.h"
 
@@ -21,17 +24,27 @@ namespace openblack
 
 class L3DMesh;
 
+namespace lnd
+{
+class LNDCompressedMaterialFile;
+}
+
 namespace graphics
 {
 class ShaderProgram;
 class Texture2D;
 } // namespace graphics
 
+/// The sky dome, textured by blending the 3 alignment by 3 time of day textures.
+///
+/// When \p compressed, the textures are uploaded as BC1 with mips, encoded once and cached in the user cache directory.
+/// When \p resident, only the 2 by 2 textures blended at the current time and alignment are kept on the GPU, the others
+/// are uploaded when the time or alignment moves into them.
 class Sky
 {
 public:
-	Sky();
-	~Sky() = default;
+	Sky(bool compressed, bool resident);
+	~Sky();
 
 	void SetDayNightTimes(float nightFull, float duskStart, float duskEnd, float dayFull);
 	/// Time between 0 and 24 in hours
@@ -42,6 +55,10 @@ class Sky
 	/// 1 -> Dawn/Dusk
 	/// 2 -> Day (max value)
 	[[nodiscard]] float GetCurrentSkyType() const;
+	/// Alignment between -1 (evil) and 1 (good)
+	void SetAlignment(float alignment);
+	/// Type and alignment relative to the first texture layer, followed by the number of types and alignments in the texture
+	[[nodiscard]] glm::vec4 GetTypeAlignmentUniform() const;
 
 private:
 	friend class Renderer;
@@ -57,16 +74,34 @@ class Sky
 	    "day",
 	};
 	static constexpr std::array<uint16_t, 3> k_TextureResolution = {
-	    256,
-	    256,
+	    lnd::LNDMaterial::k_Width,
+	    lnd::LNDMaterial::k_Height,
 	    static_cast<uint16_t>(k_Alignments.size() * k_Times.size()),
 	};
+	static constexpr size_t k_LayerTexels = k_TextureResolution[0] * k_TextureResolution[1];
+	/// Size of the window of layers kept on the GPU in resident mode
+	static constexpr glm::uvec2 k_ResidentSize = {2, 2};
+
+	/// Read the textures straight into \ref _bitmaps
+	void LoadBitmaps();
+	void LoadCompressed();
+	/// Type and alignment of the first layer of the resident window
+	[[nodiscard]] glm::uvec2 GetResidentOrigin() const;
+	void UpdateResidentLayers();
+	void UploadLayer(uint16_t destination, uint32_t source);
 
 	std::unique_ptr<L3DMesh> _model;
 	std::unique_ptr<graphics::Texture2D> _texture; // TODO(bwrsandman): put in a resource manager and store look-up
 
-	std::array<uint16_t, k_TextureResolution[0] * k_TextureResolution[1] * k_TextureResolution[2]> _bitmaps;
+	/// Layers of alignment by time, kept after upload only when resident and not compressed
+	std::vector<lnd::LNDMaterial::R5G5B5A1> _bitmaps;
+	/// Kept after upload only when resident
+	std::unique_ptr<lnd::LNDCompressedMaterialFile> _compressed;
+	bool _resident;
+	/// Window currently uploaded in resident mode
+	glm::uvec2 _residentOrigin {UINT32_MAX, UINT32_MAX};
 
+	float _alignment {0.0f};
 	float _timeOfDay;
 	float _nightFullTime;
 	float _duskStartTime;
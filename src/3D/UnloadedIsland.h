@@ -32,6 +32,23 @@ class UnloadedIsland final: public LandIslandInterface
 		throw std::runtime_error("Cannot get landscape before any are loaded");
 	}
 
+	void SetCellAltitude(const glm::u16vec2&, uint8_t) override
+	{
+		throw std::runtime_error("Cannot get landscape before any are loaded");
+	}
+
+	void AdjustAltitude(const glm::vec2&, float, float) override
+	{
+		throw std::runtime_error("Cannot get landscape before any are loaded");
+	}
+
+	void UpdateDirtyBlocks() override { throw std::runtime_error("Cannot get landscape before any are loaded"); }
+
+	[[nodiscard]] uint32_t GetRevision() const override
+	{
+		throw std::runtime_error("Cannot get landscape before any are loaded");
+	}
+
 	void DumpTextures() const override { throw std::runtime_error("Cannot get landscape before any are loaded"); }
 
 	void DumpMaps() const override { throw std::runtime_error("Cannot get landscape before any are loaded"); }
@@ -11,6 +11,7 @@
 
 #include "AudioManager.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include <glm/gtc/constants.hpp>
@@ -22,9 +23,7 @@
 #include "FileSystem/FileSystemInterface.h"
 #include "Game.h"
 #include "Locator.h"
-#include "MpegAudioDecoder.h"
 #include "Resources/Resources.h"
-#include "WavAudioDecoder.h"
 
 using namespace openblack::ecs::components;
 
@@ -40,16 +39,18 @@ AudioManager::AudioManager()
 AudioManager::~AudioManager()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, AudioEmitter>([this](entt::entity entity, const Transform&, const AudioEmitter& emitter) {
-		DestroyEmitter(entity);
-		auto sound = Locator::resources::value().GetSounds().Handle(emitter.soundId);
-		_audioPlayer->DeleteBuffer(sound->bufferId);
-	});
+	registry.Each<Transform, AudioEmitter>(
+	    [this](entt::entity entity, const Transform&, const AudioEmitter&) { DestroyEmitter(entity); });
 
 	if (registry.Valid(_musicEntity))
 	{
 		DestroyEmitter(_musicEntity);
 	}
+
+	for (auto bufferId : _soundCache.Clear())
+	{
+		_audioPlayer->DeleteBuffer(bufferId);
+	}
 }
 
 void AudioManager::Stop()
@@ -68,6 +69,7 @@ void AudioManager::Update(Game& game)
 	auto forward = cam.GetForward();
 	auto top = cam.GetUp();
 	_audioPlayer->UpdateListener(pos, vel, forward, top);
+	UploadDecodedSounds();
 	auto& registry = Locator::entitiesRegistry::value();
 	registry.Each<Transform, AudioEmitter>(
 	    [this](entt::entity entity, const Transform& transform, const AudioEmitter& emitter) {
@@ -87,6 +89,56 @@ void AudioManager::Update(Game& game)
 			    DestroyEmitter(entity);
 		    }
 	    });
+	EvictSounds();
+}
+
+void AudioManager::UploadDecodedSounds()
+{
+	_soundDecoder.Poll(_decodedSounds);
+	auto& sounds = Locator::resources::value().GetSounds();
+	auto& registry = Locator::entitiesRegistry::value();
+	for (auto& decoded : _decodedSounds)
+	{
+		// Music is erased once stopped, possibly before it finished decoding
+		if (!sounds.Contains(decoded.id) || _soundCache.Contains(decoded.id))
+		{
+			continue;
+		}
+		auto sound = sounds.Handle(decoded.id);
+		sound->channelLayout = decoded.channelLayout;
+		sound->bufferId = CreateBuffer(sound->channelLayout, decoded.samples, sound->sampleRate);
+		sound->duration = _audioPlayer->GetDuration(sound->bufferId);
+		sound->sizeInBytes = decoded.samples.size() * sizeof(decoded.samples[0]);
+
+		const auto [first, last] = _waitingEmitters.equal_range(decoded.id);
+		_soundCache.Insert(decoded.id, sound->bufferId, sound->sizeInBytes, decoded.decodeTime,
+		                   static_cast<uint32_t>(std::distance(first, last)));
+		for (auto it = first; it != last; ++it)
+		{
+			const auto& emitter = registry.Get<AudioEmitter>(it->second);
+			_audioPlayer->QueueBuffer(emitter.sourceId, sound->bufferId);
+			if (emitter.state == AudioStatus::Playing)
+			{
+				const auto& transform = registry.Get<Transform>(it->second);
+				_audioPlayer->PlaySource(emitter.sourceId, transform.position, 1.f, emitter.loop == PlayType::Repeat);
+			}
+		}
+		_waitingEmitters.erase(first, last);
+	}
+	_decodedSounds.clear();
+}
+
+void AudioManager::EvictSounds()
+{
+	auto& sounds = Locator::resources::value().GetSounds();
+	for (const auto& [id, bufferId] : _soundCache.Evict())
+	{
+		_audioPlayer->DeleteBuffer(bufferId);
+		if (sounds.Contains(id))
+		{
+			sounds.Handle(id)->bufferId = 0;
+		}
+	}
 }
 
 BufferId AudioManager::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
@@ -99,6 +151,12 @@ void AudioManager::PlayEmitter(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& emitterComponent = registry.Get<AudioEmitter>(emitter);
+	if (IsWaiting(emitter, emitterComponent.soundId))
+	{
+		// Starts once its sound is decoded
+		emitterComponent.state = AudioStatus::Playing;
+		return;
+	}
 	auto& transform = registry.Get<Transform>(emitter);
 	_audioPlayer->PlaySource(emitterComponent.sourceId, transform.position, 1.f, emitterComponent.loop == PlayType::Repeat);
 }
@@ -124,6 +182,16 @@ void AudioManager::DestroyEmitter(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
+	const auto [first, last] = _waitingEmitters.equal_range(component.soundId);
+	const auto waiting = std::find_if(first, last, [emitter](const auto& pair) { return pair.second == emitter; });
+	if (waiting != last)
+	{
+		_waitingEmitters.erase(waiting);
+	}
+	else
+	{
+		_soundCache.Release(component.soundId);
+	}
 	_audioPlayer->DeleteSource(component.sourceId);
 	registry.Destroy(emitter);
 }
@@ -135,54 +203,36 @@ entt::entity AudioManager::CreateEmitter(entt::id_type id, PlayType playType, gl
 	auto& registry = Locator::entitiesRegistry::value();
 	auto entity = registry.Create();
 	auto sourceId = _audioPlayer->CreateSource(static_cast<float>(sound->pitch), relative);
-	if (!sound->buffer.empty())
+	if (const auto bufferId = _soundCache.Acquire(id))
+	{
+		_audioPlayer->QueueBuffer(sourceId, *bufferId);
+	}
+	else
 	{
-		CreateBuffer(sound);
+		_soundDecoder.Request(id, sound);
+		_waitingEmitters.emplace(id, entity);
 	}
-	_audioPlayer->QueueBuffer(sourceId, sound->bufferId);
 	registry.Assign<AudioEmitter>(entity, sourceId, id, 0, position, direction, radius, volume, playType, status, relative);
 	registry.Assign<Transform>(entity, glm::zero<glm::vec3>(), glm::one<glm::mat4>(), glm::one<glm::vec3>());
 	return entity;
 }
 
-void AudioManager::CreateBuffer(Sound& sound)
+void AudioManager::PrewarmSounds(const std::vector<entt::id_type>& ids)
 {
-	std::vector<int16_t> decodeBuffer;
-	for (auto& buffer : sound.buffer)
+	auto& sounds = Locator::resources::value().GetSounds();
+	for (auto id : ids)
 	{
-		bool success;
-		std::vector<int16_t> decoded;
-		{
-			auto decoder = audio::MpegAudioDecoder();
-			success = decoder.Open(buffer);
-			if (success)
-			{
-				decoder.Read(decoded);
-				sound.channelLayout = decoder.GetChannelLayout();
-			}
-		}
-		if (!success)
-		{
-			auto decoder = audio::WavAudioDecoder();
-			success = decoder.Open(buffer);
-			if (success)
-			{
-				decoder.Read(decoded);
-				sound.channelLayout = decoder.GetChannelLayout();
-			}
-		}
-		if (success)
-		{
-			decodeBuffer.insert(decodeBuffer.end(), decoded.begin(), decoded.end());
-		}
-		else
+		if (sounds.Contains(id) && !_soundCache.Contains(id))
 		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode sound");
+			_soundDecoder.Request(id, sounds.Handle(id));
 		}
 	}
-	sound.bufferId = CreateBuffer(sound.channelLayout, decodeBuffer, sound.sampleRate);
-	sound.duration = _audioPlayer->GetDuration(sound.bufferId);
-	sound.sizeInBytes = decodeBuffer.size() * sizeof(decodeBuffer[0]);
+}
+
+bool AudioManager::IsWaiting(entt::entity emitter, entt::id_type soundId) const
+{
+	const auto [first, last] = _waitingEmitters.equal_range(soundId);
+	return std::any_of(first, last, [emitter](const auto& pair) { return pair.second == emitter; });
 }
 
 bool AudioManager::EmitterExists(entt::entity emitter)
@@ -197,6 +247,11 @@ float AudioManager::GetProgress(entt::entity entity)
 	assert(registry.AnyOf<AudioEmitter>(entity));
 	auto& emitter = registry.Get<AudioEmitter>(entity);
 	auto sizeInBytes = Locator::resources::value().GetSounds().Handle(emitter.soundId)->sizeInBytes;
+	if (sizeInBytes == 0)
+	{
+		// Not decoded yet
+		return 0.0f;
+	}
 	return _audioPlayer->GetProgress(sizeInBytes, emitter.sourceId);
 }
 
@@ -257,8 +312,16 @@ void AudioManager::PlayMusic(const std::string& packPath, PlayType type)
 		pack::PackFile soundPack;
 		soundPack.Open(packPath);
 		const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		const auto& audioData = soundPack.GetAudioSamplesData();
-		Locator::resources::value().GetSounds().Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[0], audioData);
+		const auto waveDataOffset = soundPack.GetBlockOffset("LHAudioWaveData");
+		// Music is split into many samples which are decoded back to back
+		std::vector<SoundSegment> segments;
+		segments.reserve(audioHeaders.size());
+		for (const auto& header : audioHeaders)
+		{
+			segments.push_back({waveDataOffset + header.offset, header.size});
+		}
+		Locator::resources::value().GetSounds().Load(id, resources::SoundLoader::FromDiskTag {}, packPath, audioHeaders[0],
+		                                             std::move(segments));
 	}
 	auto sound = Locator::resources::value().GetSounds().Handle(id);
 	auto position = glm::one<glm::vec3>();
@@ -275,15 +338,16 @@ void AudioManager::StopMusic()
 	{
 		return;
 	}
-	auto& emitter = registry.Get<AudioEmitter>(_musicEntity);
+	const auto soundId = registry.Get<AudioEmitter>(_musicEntity).soundId;
 	// Clean up the audio player's music resources
-	_audioPlayer->StopSource(emitter.sourceId);
-	_audioPlayer->DeleteSource(emitter.sourceId);
-	[[maybe_unused]] auto music = Locator::resources::value().GetSounds().Handle(emitter.soundId);
+	StopEmitter(_musicEntity);
+	DestroyEmitter(_musicEntity);
+	if (const auto bufferId = _soundCache.Erase(soundId))
+	{
+		_audioPlayer->DeleteBuffer(*bufferId);
+	}
 	//	Erase the music resource as it is no longer being played
-	Locator::resources::value().GetSounds().Erase(emitter.soundId);
-	//	Remove the entity
-	registry.Destroy(_musicEntity);
+	Locator::resources::value().GetSounds().Erase(soundId);
 	_musicEntity = entt::null;
 }
 } // namespace openblack::audio
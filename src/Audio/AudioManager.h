@@ -12,6 +12,7 @@
 #include <map>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -20,6 +21,8 @@
 #include "AudioManagerInterface.h"
 #include "AudioPlayer.h"
 #include "Resources/Loaders.h"
+#include "SoundCache.h"
+#include "SoundDecoder.h"
 #include "SoundGroup.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -37,10 +40,14 @@ namespace openblack::audio
 class AudioManager final: public AudioManagerInterface
 {
 public:
+	/// Decoded sounds which no source plays are evicted past this size
+	static constexpr size_t k_SoundCacheBudget = 64 * 1024 * 1024;
+
 	AudioManager();
 	~AudioManager();
 	BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
-	void CreateBuffer(Sound& sound) override;
+	void PrewarmSounds(const std::vector<entt::id_type>& ids) override;
+	[[nodiscard]] const SoundCacheStatistics& GetSoundCacheStatistics() const override { return _soundCache.GetStatistics(); }
 	void PlayEmitter(entt::entity emitter) override;
 	void PauseEmitter(entt::entity emitter) override;
 	void StopEmitter(entt::entity emitter) override;
@@ -70,8 +77,13 @@ class AudioManager final: public AudioManagerInterface
 	const std::map<std::string, SoundGroup>& GetSoundGroups() override;
 
 private:
+	/// Upload newly decoded sounds and start the emitters which were waiting on them
+	void UploadDecodedSounds();
+	void EvictSounds();
+	[[nodiscard]] bool IsWaiting(entt::entity emitter, entt::id_type soundId) const;
+
 	std::unique_ptr<AudioPlayerInterface> _audioPlayer;
-	/// All sounds are loaded
+	/// All sounds are registered but only decoded once played or prewarmed
 	std::map<std::string, SoundGroup> _soundGroups;
 	/// Music resources are loaded on demand to avoid storing large audio buffers. There are no resource IDs yet
 	std::vector<std::string> _music;
@@ -79,6 +91,11 @@ class AudioManager final: public AudioManagerInterface
 	float _musicVolume {1.0f};
 	float _sfxVolume {1.0f};
 	entt::entity _musicEntity {entt::null};
+	SoundCache _soundCache {k_SoundCacheBudget};
+	SoundDecoder _soundDecoder;
+	/// Emitters created before their sound was decoded, they have no buffer queued yet
+	std::unordered_multimap<entt::id_type, entt::entity> _waitingEmitters;
+	std::vector<DecodedSound> _decodedSounds;
 };
 
 } // namespace openblack::audio
@@ -16,6 +16,7 @@
 #include "ECS/Components/AudioEmitter.h"
 #include "Resources/Loaders.h"
 #include "Sound.h"
+#include "SoundCache.h"
 #include "SoundGroup.h"
 
 namespace openblack
@@ -31,7 +32,9 @@ class AudioManagerInterface
 	virtual void Stop() = 0;
 	virtual void Update(Game& game) = 0;
 	virtual BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) = 0;
-	virtual void CreateBuffer(Sound& sound) = 0;
+	/// Decode \p ids ahead of time so that they start without delay when first played
+	virtual void PrewarmSounds(const std::vector<entt::id_type>& ids) = 0;
+	[[nodiscard]] virtual const SoundCacheStatistics& GetSoundCacheStatistics() const = 0;
 	virtual void PlayEmitter(entt::entity emitter) = 0;
 	virtual void PauseEmitter(entt::entity emitter) = 0;
 	virtual void StopEmitter(entt::entity emitter) = 0;
@@ -26,7 +26,12 @@ class AudioManagerNoOp final: public AudioManagerInterface
 	{
 		return 0;
 	}
-	void CreateBuffer([[maybe_unused]] Sound& sound) override {}
+	void PrewarmSounds([[maybe_unused]] const std::vector<entt::id_type>& ids) override {}
+	[[nodiscard]] const SoundCacheStatistics& GetSoundCacheStatistics() const override
+	{
+		static const SoundCacheStatistics result {};
+		return result;
+	}
 	void PlayEmitter([[maybe_unused]] entt::entity emitter) override {}
 	void PauseEmitter([[maybe_unused]] entt::entity emitter) override {}
 	void StopEmitter([[maybe_unused]] entt::entity emitter) override {}
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <filesystem>
 #include <queue>
 #include <string>
 #include <vector>
@@ -44,6 +47,13 @@ enum class PlayType
 	Overlap
 };
 
+/// Compressed bytes of a sound in its pack
+struct SoundSegment
+{
+	uint64_t offset;
+	uint32_t size;
+};
+
 class Sound
 {
 public:
@@ -58,7 +68,9 @@ class Sound
 	PlayType playType;
 	BufferId bufferId;
 	float duration;
-	std::vector<std::vector<uint8_t>> buffer;
+	/// The compressed bytes are only read from the pack while the sound is decoded
+	std::filesystem::path packPath;
+	std::vector<SoundSegment> segments;
 	size_t sizeInBytes;
 };
 } // namespace openblack::audio
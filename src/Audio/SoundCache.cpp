@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "SoundCache.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace openblack::audio;
+
+SoundCache::SoundCache(size_t budgetInBytes)
+    : _budget(budgetInBytes)
+{
+}
+
+std::optional<BufferId> SoundCache::Acquire(entt::id_type id)
+{
+	auto entry = _entries.find(id);
+	if (entry == _entries.end())
+	{
+		++_statistics.misses;
+		return std::nullopt;
+	}
+	++_statistics.hits;
+	++entry->second.users;
+	_recentlyUsed.splice(_recentlyUsed.begin(), _recentlyUsed, entry->second.recency);
+	return entry->second.bufferId;
+}
+
+void SoundCache::Release(entt::id_type id)
+{
+	auto entry = _entries.find(id);
+	if (entry != _entries.end())
+	{
+		assert(entry->second.users > 0);
+		--entry->second.users;
+	}
+}
+
+void SoundCache::Insert(entt::id_type id, BufferId bufferId, size_t sizeInBytes,
+                        std::chrono::duration<float, std::milli> decodeTime, uint32_t users)
+{
+	assert(!_entries.contains(id));
+	_recentlyUsed.push_front(id);
+	_entries.emplace(id, Entry {bufferId, sizeInBytes, users, _recentlyUsed.begin()});
+	_statistics.residentBytes += sizeInBytes;
+	++_statistics.decodes;
+	_statistics.totalDecodeTime += decodeTime;
+	_statistics.maxDecodeTime = std::max(_statistics.maxDecodeTime, decodeTime);
+}
+
+std::optional<BufferId> SoundCache::Erase(entt::id_type id)
+{
+	auto entry = _entries.find(id);
+	if (entry == _entries.end())
+	{
+		return std::nullopt;
+	}
+	const auto bufferId = entry->second.bufferId;
+	_statistics.residentBytes -= entry->second.sizeInBytes;
+	_recentlyUsed.erase(entry->second.recency);
+	_entries.erase(entry);
+	return bufferId;
+}
+
+std::vector<std::pair<entt::id_type, BufferId>> SoundCache::Evict()
+{
+	std::vector<std::pair<entt::id_type, BufferId>> evicted;
+	// Walk from the least recently used, erasing returns the already visited entry after it
+	for (auto it = _recentlyUsed.end(); it != _recentlyUsed.begin() && _statistics.residentBytes > _budget;)
+	{
+		--it;
+		auto entry = _entries.find(*it);
+		if (entry->second.users > 0)
+		{
+			continue;
+		}
+		evicted.emplace_back(entry->first, entry->second.bufferId);
+		_statistics.residentBytes -= entry->second.sizeInBytes;
+		++_statistics.evictions;
+		_entries.erase(entry);
+		it = _recentlyUsed.erase(it);
+	}
+	return evicted;
+}
+
+std::vector<BufferId> SoundCache::Clear()
+{
+	std::vector<BufferId> buffers;
+	buffers.reserve(_entries.size());
+	for (const auto& [id, entry] : _entries)
+	{
+		buffers.push_back(entry.bufferId);
+	}
+	_entries.clear();
+	_recentlyUsed.clear();
+	_statistics.residentBytes = 0;
+	return buffers;
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <entt/fwd.hpp>
+
+#include "Sound.h"
+
+namespace openblack::audio
+{
+struct SoundCacheStatistics
+{
+	uint32_t hits {0};
+	uint32_t misses {0};
+	uint32_t evictions {0};
+	uint32_t decodes {0};
+	std::chrono::duration<float, std::milli> totalDecodeTime {0.0f};
+	std::chrono::duration<float, std::milli> maxDecodeTime {0.0f};
+	size_t residentBytes {0};
+};
+
+/// Decoded sound buffers kept within a budget of bytes, the least recently played ones are evicted first.
+///
+/// Buffers which are queued on a source can't be deleted, they are counted as users and only evicted once released. The
+/// cache never deletes buffers itself, it hands back the ones to delete which lets it be used without an audio device.
+class SoundCache
+{
+public:
+	explicit SoundCache(size_t budgetInBytes);
+
+	/// The buffer of \p id if it is resident, which is then used until \ref Release
+	[[nodiscard]] std::optional<BufferId> Acquire(entt::id_type id);
+	void Release(entt::id_type id);
+	/// Add a newly decoded buffer already used by \p users sources
+	void Insert(entt::id_type id, BufferId bufferId, size_t sizeInBytes, std::chrono::duration<float, std::milli> decodeTime,
+	            uint32_t users);
+	/// Remove \p id regardless of the budget, returns its buffer to delete
+	[[nodiscard]] std::optional<BufferId> Erase(entt::id_type id);
+	/// Drop unused buffers until the cache fits in the budget, returns the evicted sounds and their buffers to delete
+	[[nodiscard]] std::vector<std::pair<entt::id_type, BufferId>> Evict();
+	/// Returns all buffers to delete
+	[[nodiscard]] std::vector<BufferId> Clear();
+
+	[[nodiscard]] bool Contains(entt::id_type id) const { return _entries.contains(id); }
+	[[nodiscard]] size_t GetBudget() const { return _budget; }
+	[[nodiscard]] const SoundCacheStatistics& GetStatistics() const { return _statistics; }
+
+private:
+	struct Entry
+	{
+		BufferId bufferId;
+		size_t sizeInBytes;
+		uint32_t users;
+		/// Position in \ref _recentlyUsed
+		std::list<entt::id_type>::iterator recency;
+	};
+
+	size_t _budget;
+	std::unordered_map<entt::id_type, Entry> _entries;
+	/// Most recently used first
+	std::list<entt::id_type> _recentlyUsed;
+	SoundCacheStatistics _statistics;
+};
+} // namespace openblack::audio
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "SoundDecoder.h"
+
+#include <spdlog/spdlog.h>
+
+#include "FileSystem/FileSystemInterface.h"
+#include "Locator.h"
+#include "MpegAudioDecoder.h"
+#include "WavAudioDecoder.h"
+
+using namespace openblack::audio;
+
+SoundDecoder::SoundDecoder()
+    : _thread(&SoundDecoder::Run, this)
+{
+}
+
+SoundDecoder::~SoundDecoder()
+{
+	{
+		std::lock_guard lock(_mutex);
+		_stop = true;
+	}
+	_condition.notify_one();
+	_thread.join();
+}
+
+void SoundDecoder::Request(entt::id_type id, entt::resource<Sound> sound)
+{
+	{
+		std::lock_guard lock(_mutex);
+		if (!_pending.insert(id).second)
+		{
+			return;
+		}
+		_requests.emplace_back(id, std::move(sound));
+	}
+	_condition.notify_one();
+}
+
+void SoundDecoder::Poll(std::vector<DecodedSound>& decoded)
+{
+	std::lock_guard lock(_mutex);
+	for (auto& sound : _decoded)
+	{
+		_pending.erase(sound.id);
+		decoded.emplace_back(std::move(sound));
+	}
+	_decoded.clear();
+}
+
+ChannelLayout SoundDecoder::Decode(const Sound& sound, std::vector<int16_t>& samples)
+{
+	// The sound's own layout isn't read as it's only written by the game thread once decoded
+	auto channelLayout = ChannelLayout::Mono;
+	std::unique_ptr<filesystem::Stream> pack;
+	try
+	{
+		pack = Locator::filesystem::value().Open(sound.packPath, filesystem::Stream::Mode::Read);
+	}
+	catch (std::exception& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to open {} to decode sound {}: {}", sound.packPath.string(),
+		                    sound.name, err.what());
+		return channelLayout;
+	}
+
+	std::vector<uint8_t> buffer;
+	for (const auto& segment : sound.segments)
+	{
+		buffer.resize(segment.size);
+		try
+		{
+			pack->Seek(static_cast<std::size_t>(segment.offset), filesystem::Stream::SeekMode::Begin);
+			pack->Read(buffer.data(), buffer.size());
+		}
+		catch (std::exception& err)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to read sound {} from {}: {}", sound.name,
+			                    sound.packPath.string(), err.what());
+			continue;
+		}
+
+		bool success;
+		std::vector<int16_t> decoded;
+		{
+			auto decoder = audio::MpegAudioDecoder();
+			success = decoder.Open(buffer);
+			if (success)
+			{
+				decoder.Read(decoded);
+				channelLayout = decoder.GetChannelLayout();
+			}
+		}
+		if (!success)
+		{
+			auto decoder = audio::WavAudioDecoder();
+			success = decoder.Open(buffer);
+			if (success)
+			{
+				decoder.Read(decoded);
+				channelLayout = decoder.GetChannelLayout();
+			}
+		}
+		if (success)
+		{
+			samples.insert(samples.end(), decoded.begin(), decoded.end());
+		}
+		else
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode sound {}", sound.name);
+		}
+	}
+	return channelLayout;
+}
+
+void SoundDecoder::Run()
+{
+	while (true)
+	{
+		std::pair<entt::id_type, entt::resource<Sound>> request;
+		{
+			std::unique_lock lock(_mutex);
+			_condition.wait(lock, [this] { return _stop || !_requests.empty(); });
+			if (_stop)
+			{
+				return;
+			}
+			request = std::move(_requests.front());
+			_requests.pop_front();
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		DecodedSound result {request.first, ChannelLayout::Mono, {}, {}};
+		result.channelLayout = Decode(*request.second, result.samples);
+		result.decodeTime = std::chrono::steady_clock::now() - start;
+
+		std::lock_guard lock(_mutex);
+		_decoded.emplace_back(std::move(result));
+	}
+}
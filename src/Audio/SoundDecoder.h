@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <entt/resource/resource.hpp>
+
+#include "Sound.h"
+
+namespace openblack::audio
+{
+struct DecodedSound
+{
+	entt::id_type id;
+	ChannelLayout channelLayout;
+	std::vector<int16_t> samples;
+	std::chrono::duration<float, std::milli> decodeTime;
+};
+
+/// Decodes the compressed samples of sounds to PCM on a worker thread.
+///
+/// Requests hold on to the sound resource so it outlives its decoding even if it is erased in the meantime.
+class SoundDecoder
+{
+public:
+	SoundDecoder();
+	~SoundDecoder();
+
+	/// Queue \p sound for decoding unless it is already queued
+	void Request(entt::id_type id, entt::resource<Sound> sound);
+	/// Move the sounds which finished decoding since the last poll into \p decoded
+	void Poll(std::vector<DecodedSound>& decoded);
+
+	/// Read the compressed segments of \p sound from its pack and decode them on the calling thread
+	static ChannelLayout Decode(const Sound& sound, std::vector<int16_t>& samples);
+
+private:
+	void Run();
+
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	std::deque<std::pair<entt::id_type, entt::resource<Sound>>> _requests;
+	/// Queued or being decoded
+	std::unordered_set<entt::id_type> _pending;
+	std::vector<DecodedSound> _decoded;
+	bool _stop {false};
+	std::thread _thread;
+};
+} // namespace openblack::audio
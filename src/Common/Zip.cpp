@@ -45,7 +45,7 @@ std::string GetZlibError(int statusCode)
 /*
  * More information found here https://www.zlib.net/zlib_how.html
  */
-std::vector<uint8_t> openblack::zip::Inflate(const std::vector<uint8_t>& deflatedData, size_t inflatedSize)
+std::vector<uint8_t> openblack::zip::Inflate(std::span<const uint8_t> deflatedData, size_t inflatedSize)
 {
 	auto deflatedSize = deflatedData.size();
 	auto inflatedData = std::vector<uint8_t>(inflatedSize);
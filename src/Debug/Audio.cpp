@@ -61,6 +61,8 @@ void Audio::Emitters()
 		if (ImGui::Selectable(name.c_str(), _selectedSoundPack == name, ImGuiSelectableFlags_SpanAllColumns))
 		{
 			_selectedSoundPack = name;
+			// Decode the pack in the background so its sounds can be auditioned without delay
+			Locator::audio::value().PrewarmSounds(group.sounds);
 		}
 
 		ImGui::NextColumn();
@@ -229,6 +231,15 @@ void Audio::AudioSettings()
 	{
 		soundManager.SetSfxVolume(sfxVolume);
 	}
+	const auto& cache = soundManager.GetSoundCacheStatistics();
+	const auto lookups = cache.hits + cache.misses;
+	ImGui::Text("Decoded sounds %.1f MiB, hit rate %.1f%% (%u hits, %u misses), %u evictions",
+	            static_cast<double>(cache.residentBytes) / (1024.0 * 1024.0),
+	            lookups > 0 ? 100.0 * cache.hits / lookups : 0.0, cache.hits, cache.misses, cache.evictions);
+	ImGui::Text("Decode latency mean %.2fms, max %.2fms over %u decodes",
+	            cache.decodes > 0 ? static_cast<double>(cache.totalDecodeTime.count()) / cache.decodes : 0.0,
+	            static_cast<double>(cache.maxDecodeTime.count()), cache.decodes);
+	ImGui::Separator();
 	ImGui::Text("Active Sounds");
 	ImGui::SameLine();
 	if (ImGui::Button("Play") && _selectedEmitter != entt::null)
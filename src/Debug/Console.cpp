@@ -460,6 +460,7 @@ void Console::ExecCommand(const std::string& commandLine)
 		{
 			AddLog("[error]: %s", error.what());
 		}
+		lhscriptx::FeatureScriptCommands::CreateQueuedTrees();
 	}
 }
 
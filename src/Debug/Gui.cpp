@@ -12,6 +12,8 @@
 #include <cinttypes>
 #include <cmath>
 
+#include <algorithm>
+
 #include <bgfx/embedded_shader.h>
 // BGFX has support for WSL to use windows d3d. We disable it here from the BGFX_EMBEDDED_SHADER macro.
 #if BX_PLATFORM_LINUX
@@ -52,6 +54,7 @@
 #include <GameWindow.h>
 #include <Locator.h>
 #include <Resources/ResourcesInterface.h>
+#include <TurnClock.h>
 
 #include "Audio.h"
 #include "Console.h"
@@ -569,6 +572,20 @@ bool Gui::ShowMenu(Game& game)
 					game.SetGameSpeed(multiplier);
 				}
 
+				auto& turnClock = game.GetTurnClock();
+				auto maxTurns = static_cast<int>(turnClock.GetMaxTurnsPerFrame());
+				if (ImGui::SliderInt("Max turns per frame", &maxTurns, 1, 20))
+				{
+					turnClock.SetMaxTurnsPerFrame(static_cast<uint32_t>(maxTurns));
+				}
+				auto fastForward = static_cast<int>(turnClock.GetFastForward());
+				if (ImGui::SliderInt("Fast forward turns per frame", &fastForward, 0, 100))
+				{
+					turnClock.SetFastForward(static_cast<uint32_t>(fastForward));
+				}
+				const std::chrono::duration<float, std::milli> lag = turnClock.GetLag();
+				ImGui::Text("Turn lag: %.3fms", lag.count());
+
 				ImGui::EndMenu();
 			}
 
@@ -648,46 +665,8 @@ void Gui::RenderArrow(const std::string& name, const ImVec2& pos, const ImVec2&
 	ImGui::PopStyleVar(); // ImGuiStyleVar_WindowPadding
 }
 
-bool boxIntersect(const glm::vec4& box1, const glm::vec4& box2)
-{
-	// where z is width and y is height
-	return box1.x - box2.x < box2.z && //
-	       box2.x - box1.x < box1.z && //
-	       box1.y - box2.y < box2.w && //
-	       box2.y - box1.y < box1.w;
-}
-
-bool fitBox(float minY, const std::vector<glm::vec4>& coveredAreas, glm::vec4& box)
-{
-	// Where z is width and y is height
-	bool restart = true;
-	while (restart)
-	{
-		restart = false;
-		for (const auto area : coveredAreas)
-		{
-			// If there is an overlap, try moving it up
-			while (boxIntersect(area, box))
-			{
-				restart = true; // Restart because we now might intersect with earlier boxes
-				box.y = area.y - 1.0f - box.w;
-				if (box.y - box.w < minY)
-				{
-					return false;
-				}
-			}
-			if (restart)
-			{
-				break;
-			}
-		}
-	}
-	return true;
-}
-
-std::optional<glm::uvec4> Gui::RenderVillagerName(const std::vector<glm::vec4>& coveredAreas, const std::string& name,
-                                                  const std::string& text, const glm::vec4& color, const ImVec2& pos,
-                                                  float arrowLength, std::function<void(void)> debugCallback) const
+void Gui::RenderVillagerName(uint32_t key, const std::string& name, const std::string& text, const glm::vec4& color,
+                             const ImVec2& pos, float arrowLength, std::function<void(void)> debugCallback)
 {
 	// clang-format off
 	const auto boxOverlayFlags =
@@ -736,7 +715,7 @@ std::optional<glm::uvec4> Gui::RenderVillagerName(const std::vector<glm::vec4>&
 	}
 
 	float originalY = boxExtent.y;
-	bool fits = fitBox(_menuBarSize.y, coveredAreas, boxExtent);
+	bool fits = _labelPlacer.Place(key, boxExtent);
 
 	if (fits)
 	{
@@ -762,17 +741,10 @@ std::optional<glm::uvec4> Gui::RenderVillagerName(const std::vector<glm::vec4>&
 	}
 	ImGui::PopStyleVar();
 
-	if (!fits)
-	{
-		return std::nullopt;
-	}
-
-	if (originalY == boxExtent.y)
+	if (fits && originalY == boxExtent.y)
 	{
 		RenderArrow("Villager overlay arrow #" + name, ImVec2(pos.x, pos.y - arrowLength), ImVec2(15, arrowLength));
 	}
-
-	return std::make_optional<glm::uvec4>(boxExtent);
 }
 
 void Gui::ShowVillagerNames(const Game& game)
@@ -792,116 +764,126 @@ void Gui::ShowVillagerNames(const Game& game)
 	const auto& camera = game.GetCamera();
 	const glm::vec4 viewport =
 	    glm::vec4(ImGui::GetStyle().WindowPadding.x, 0, displaySize.x - ImGui::GetStyle().WindowPadding.x, displaySize.y);
-	std::vector<glm::vec4> coveredAreas;
-	coveredAreas.reserve(Locator::entitiesRegistry::value().Size<Villager>());
-	Locator::entitiesRegistry::value().Each<const Transform, Villager, LivingAction>(
-	    [this, &i, &coveredAreas, &camera, config, viewport](const Transform& transform, Villager& villager,
-	                                                         LivingAction& action) {
-		    ++i;
-		    const float height = 2.0f * transform.scale.y; // TODO(bwrsandman): get from bounding box max y
-		    glm::vec3 screenPoint;
-		    if (!camera.ProjectWorldToScreen(transform.position + glm::vec3(0.0f, height, 0.0f), viewport, screenPoint))
-		    {
-			    return;
-		    }
+	auto& registry = Locator::entitiesRegistry::value();
 
+	// Cull by distance and view before doing any of the text formatting and placement
+	_villagerLabels.clear();
+	registry.Each<const Transform, const Villager, const LivingAction>(
+	    [this, &i, &camera, viewport](entt::entity entity, const Transform& transform, const Villager&, const LivingAction&) {
+		    ++i;
 		    // 3.5 was measured in vanilla but it is possible that it is configurable
 		    float const maxDistance = 3.5f;
 		    const glm::vec3 relativePosition = (camera.GetPosition() - transform.position) / 100.0f;
-		    if (glm::dot(relativePosition, relativePosition) > maxDistance * maxDistance)
+		    const auto distance2 = glm::dot(relativePosition, relativePosition);
+		    if (distance2 > maxDistance * maxDistance)
 		    {
 			    return;
 		    }
 
-		    // TODO(bwrsandman): Get owner player and associated color
-		    glm::vec4 color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
-		    // Female villagers have a lighter colour
-		    if (villager.sex == Villager::Sex::FEMALE)
+		    const float height = 2.0f * transform.scale.y; // TODO(bwrsandman): get from bounding box max y
+		    glm::vec3 screenPoint;
+		    if (!camera.ProjectWorldToScreen(transform.position + glm::vec3(0.0f, height, 0.0f), viewport, screenPoint))
 		    {
-			    color += glm::vec4((glm::vec3(1.0f) - glm::vec3(color)) * glm::vec3(144.0f / 255.0f), color.a);
-			    color = glm::saturate(color);
+			    return;
 		    }
+		    _villagerLabels.push_back({entity, i, glm::vec2(screenPoint), distance2});
+	    });
 
-		    const std::string name = "Villager #" + std::to_string(i);
-		    const std::string stateHelpText = "TODO: STATE HELP TEXT";
-		    std::string details =
-		        fmt::format("{}\nA:{} L:{}%, H:{}%", stateHelpText, villager.age, villager.health, villager.hunger);
-		    const auto& actionSystem = Locator::livingActionSystem::value();
-		    if (config.debugVillagerStates)
-		    {
-			    details +=
-			        fmt::format("\n"
-			                    "Top State:      {}\n"
-			                    "Final State:    {}\n"
-			                    "Previous State: {}\n"
-			                    "Turns until next state change: {}\n"
-			                    "Turns since last state change: {}",
-			                    k_VillagerStateStrings.at(
-			                        static_cast<size_t>(actionSystem.VillagerGetState(action, LivingAction::Index::Top))),
-			                    k_VillagerStateStrings.at(
-			                        static_cast<size_t>(actionSystem.VillagerGetState(action, LivingAction::Index::Final))),
-			                    k_VillagerStateStrings.at(
-			                        static_cast<size_t>(actionSystem.VillagerGetState(action, LivingAction::Index::Previous))),
-			                    action.turnsUntilStateChange, action.turnsSinceStateChange);
-		    }
+	// Nearest villagers get the first pick of the screen space
+	std::sort(_villagerLabels.begin(), _villagerLabels.end(),
+	          [](const auto& lhs, const auto& rhs) { return lhs.distance2 < rhs.distance2; });
 
-		    std::function<void(void)> debugCallback;
-		    if (config.debugVillagerNames)
-		    {
-			    debugCallback = [&villager, &action, &actionSystem] {
-				    if (villager.abode == entt::null)
-				    {
-					    ImGui::Text("Homeless");
-				    }
-				    ImGui::InputInt("Health", reinterpret_cast<int*>(&villager.health));
-				    ImGui::InputInt("Age", reinterpret_cast<int*>(&villager.age));
-				    ImGui::InputInt("Hunger", reinterpret_cast<int*>(&villager.hunger));
-				    ImGui::Combo("Life Stage", &villager.lifeStage, Villager::k_LifeStageStrs);
-				    ImGui::Combo("Sex", &villager.sex, Villager::k_SexStrs);
-				    ImGui::Combo("Tribe", &villager.tribe, k_TribeStrs);
-				    ImGui::Combo("Villager Number", &villager.number, k_VillagerRoleStrs);
-				    ImGui::Combo("Task", &villager.task, Villager::k_TaskStrs);
-
-				    size_t index = 0;
-				    for (const auto& str : LivingAction::k_IndexStrings)
-				    {
-					    if (ImGui::BeginCombo(str.data(), k_VillagerStateStrings
-					                                          .at(static_cast<size_t>(actionSystem.VillagerGetState(
-					                                              action, static_cast<LivingAction::Index>(index))))
-					                                          .data()))
-					    {
-						    size_t n = 0;
-						    for (const auto& stateStr : k_VillagerStateStrings)
-						    {
-							    const bool isSelected = static_cast<size_t>(actionSystem.VillagerGetState(
-							                                action, static_cast<LivingAction::Index>(index))) == n;
-							    if (ImGui::Selectable(stateStr.data(), isSelected))
-							    {
-								    actionSystem.VillagerSetState(action, static_cast<LivingAction::Index>(index),
-								                                  static_cast<VillagerStates>(n), true);
-							    }
-
-							    // Set the initial focus when opening the combo (scrolling + keyboard navigation focus)
-							    if (isSelected)
-							    {
-								    ImGui::SetItemDefaultFocus();
-							    }
-							    ++n;
-						    }
-						    ImGui::EndCombo();
-					    }
-					    ++index;
-				    }
-			    };
-		    }
+	_labelPlacer.Begin(glm::vec2(displaySize.x, displaySize.y), _menuBarSize.y);
+	for (const auto& label : _villagerLabels)
+	{
+		auto& villager = registry.Get<Villager>(label.entity);
+		auto& needs = registry.Get<VillagerNeeds>(label.entity);
+		auto& action = registry.Get<LivingAction>(label.entity);
+		// TODO(bwrsandman): Get owner player and associated color
+		glm::vec4 color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+		// Female villagers have a lighter colour
+		if (villager.sex == Villager::Sex::FEMALE)
+		{
+			color += glm::vec4((glm::vec3(1.0f) - glm::vec3(color)) * glm::vec3(144.0f / 255.0f), color.a);
+			color = glm::saturate(color);
+		}
 
-		    const auto area = RenderVillagerName(coveredAreas, name, details, color,
-		                                         ImVec2(screenPoint.x, viewport.w - screenPoint.y), 100.0f, debugCallback);
-		    if (area.has_value())
-		    {
-			    coveredAreas.emplace_back(area.value());
-		    }
-	    });
+		const std::string name = "Villager #" + std::to_string(label.number);
+		const std::string stateHelpText = "TODO: STATE HELP TEXT";
+		std::string details =
+		    fmt::format("{}\nA:{} L:{:.0f}%, H:{:.0f}%", stateHelpText, needs.age, needs.health, needs.hunger);
+		const auto& actionSystem = Locator::livingActionSystem::value();
+		if (config.debugVillagerStates)
+		{
+			details +=
+			    fmt::format("\n"
+			                "Top State:      {}\n"
+			                "Final State:    {}\n"
+			                "Previous State: {}\n"
+			                "Turns until next state change: {}\n"
+			                "Turns since last state change: {}",
+			                k_VillagerStateStrings.at(
+			                    static_cast<size_t>(actionSystem.VillagerGetState(action, LivingAction::Index::Top))),
+			                k_VillagerStateStrings.at(
+			                    static_cast<size_t>(actionSystem.VillagerGetState(action, LivingAction::Index::Final))),
+			                k_VillagerStateStrings.at(
+			                    static_cast<size_t>(actionSystem.VillagerGetState(action, LivingAction::Index::Previous))),
+			                action.turnsUntilStateChange, action.turnsSinceStateChange);
+		}
+
+		std::function<void(void)> debugCallback;
+		if (config.debugVillagerNames)
+		{
+			debugCallback = [&villager, &needs, &action, &actionSystem] {
+				if (villager.abode == entt::null)
+				{
+					ImGui::Text("Homeless");
+				}
+				ImGui::InputFloat("Health", &needs.health);
+				ImGui::InputInt("Age", reinterpret_cast<int*>(&needs.age));
+				ImGui::InputFloat("Hunger", &needs.hunger);
+				ImGui::Combo("Life Stage", &villager.lifeStage, Villager::k_LifeStageStrs);
+				ImGui::Combo("Sex", &villager.sex, Villager::k_SexStrs);
+				ImGui::Combo("Tribe", &villager.tribe, k_TribeStrs);
+				ImGui::Combo("Villager Number", &villager.number, k_VillagerRoleStrs);
+				ImGui::Combo("Task", &villager.task, Villager::k_TaskStrs);
+
+				size_t index = 0;
+				for (const auto& str : LivingAction::k_IndexStrings)
+				{
+					if (ImGui::BeginCombo(str.data(), k_VillagerStateStrings
+					                                      .at(static_cast<size_t>(actionSystem.VillagerGetState(
+					                                          action, static_cast<LivingAction::Index>(index))))
+					                                      .data()))
+					{
+						size_t n = 0;
+						for (const auto& stateStr : k_VillagerStateStrings)
+						{
+							const bool isSelected = static_cast<size_t>(actionSystem.VillagerGetState(
+							                            action, static_cast<LivingAction::Index>(index))) == n;
+							if (ImGui::Selectable(stateStr.data(), isSelected))
+							{
+								actionSystem.VillagerSetState(action, static_cast<LivingAction::Index>(index),
+								                              static_cast<VillagerStates>(n), true);
+							}
+
+							// Set the initial focus when opening the combo (scrolling + keyboard navigation focus)
+							if (isSelected)
+							{
+								ImGui::SetItemDefaultFocus();
+							}
+							++n;
+						}
+						ImGui::EndCombo();
+					}
+					++index;
+				}
+			};
+		}
+
+		RenderVillagerName(static_cast<uint32_t>(label.entity), name, details, color,
+		                   ImVec2(label.screenPoint.x, viewport.w - label.screenPoint.y), 100.0f, debugCallback);
+	}
 }
 
 void Gui::ShowCameraPositionOverlay(const Game& game)
@@ -17,10 +17,12 @@
 #include <vector>
 
 #include <bgfx/bgfx.h>
+#include <entt/fwd.hpp>
 #include <glm/fwd.hpp>
 #include <imgui.h>
 
 #include "Graphics/RenderPass.h"
+#include "LabelPlacer.h"
 
 struct SDL_Window;
 struct SDL_Cursor;
@@ -103,9 +105,9 @@ class Gui
 	void RenderDrawDataBgfx(ImDrawData* drawData);
 
 	void RenderArrow(const std::string& name, const ImVec2& pos, const ImVec2& size) const;
-	std::optional<glm::uvec4> RenderVillagerName(const std::vector<glm::vec4>& coveredAreas, const std::string& name,
-	                                             const std::string& text, const glm::vec4& color, const ImVec2& pos,
-	                                             float arrowLength, std::function<void(void)> debugCallback) const;
+	/// Draw a label for \p key if it can be placed without overlapping the labels placed before it this frame
+	void RenderVillagerName(uint32_t key, const std::string& name, const std::string& text, const glm::vec4& color,
+	                        const ImVec2& pos, float arrowLength, std::function<void(void)> debugCallback);
 	bool ShowMenu(Game& game);
 	void ShowVillagerNames(const Game& game);
 	void ShowCameraPositionOverlay(const Game& game);
@@ -123,5 +125,16 @@ class Gui
 	const bgfx::ViewId _viewId;
 	std::vector<std::unique_ptr<Window>> _debugWindows;
 	std::string _screenshotFilename = "screenshot.png";
+
+	struct VillagerLabel
+	{
+		entt::entity entity;
+		uint32_t number;
+		glm::vec2 screenPoint;
+		float distance2;
+	};
+	/// Villagers close enough and in view, kept to avoid allocating every frame
+	std::vector<VillagerLabel> _villagerLabels;
+	LabelPlacer _labelPlacer;
 };
 } // namespace openblack::debug::gui
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LabelPlacer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace openblack::debug::gui;
+
+namespace
+{
+bool BoxIntersect(const glm::vec4& box1, const glm::vec4& box2)
+{
+	// where z is width and y is height
+	return box1.x - box2.x < box2.z && //
+	       box2.x - box1.x < box1.z && //
+	       box1.y - box2.y < box2.w && //
+	       box2.y - box1.y < box1.w;
+}
+} // namespace
+
+void LabelPlacer::Begin(const glm::vec2& displaySize, float minY)
+{
+	_minY = minY;
+	_columns = std::max(static_cast<uint32_t>(std::ceil(displaySize.x / k_CellSize)), 1u);
+	_rows = std::max(static_cast<uint32_t>(std::ceil(displaySize.y / k_CellSize)), 1u);
+	_cells.resize(static_cast<size_t>(_columns) * _rows);
+	for (auto& cell : _cells)
+	{
+		cell.clear();
+	}
+	_boxes.clear();
+	_boxQueries.clear();
+	_searchSteps = k_MaxSearchSteps;
+	std::swap(_lifts, _previousLifts);
+	_lifts.clear();
+}
+
+bool LabelPlacer::Place(uint32_t key, glm::vec4& box)
+{
+	const auto anchorY = box.y;
+
+	const auto previous = _previousLifts.find(key);
+	if (previous != _previousLifts.end())
+	{
+		auto candidate = box;
+		candidate.y = anchorY - previous->second;
+		if (candidate.y - candidate.w >= _minY && FindOverlap(candidate) == nullptr)
+		{
+			box = candidate;
+			Insert(key, box, previous->second);
+			return true;
+		}
+	}
+
+	// Move up past every overlapping label, which may then overlap one that was already tested
+	while (const auto* overlap = FindOverlap(box))
+	{
+		if (_searchSteps == 0)
+		{
+			return false;
+		}
+		--_searchSteps;
+		box.y = overlap->y - 1.0f - box.w;
+		if (box.y - box.w < _minY)
+		{
+			return false;
+		}
+	}
+	Insert(key, box, anchorY - box.y);
+	return true;
+}
+
+const glm::vec4* LabelPlacer::FindOverlap(const glm::vec4& box)
+{
+	++_query;
+	const auto range = GetCellRange(box);
+	for (auto y = range.y; y <= range.w; ++y)
+	{
+		for (auto x = range.x; x <= range.z; ++x)
+		{
+			for (auto index : _cells[y * _columns + x])
+			{
+				if (_boxQueries[index] == _query)
+				{
+					continue;
+				}
+				_boxQueries[index] = _query;
+				if (BoxIntersect(_boxes[index], box))
+				{
+					return &_boxes[index];
+				}
+			}
+		}
+	}
+	return nullptr;
+}
+
+void LabelPlacer::Insert(uint32_t key, const glm::vec4& box, float lift)
+{
+	const auto index = static_cast<uint32_t>(_boxes.size());
+	_boxes.push_back(box);
+	_boxQueries.push_back(_query);
+	const auto range = GetCellRange(box);
+	for (auto y = range.y; y <= range.w; ++y)
+	{
+		for (auto x = range.x; x <= range.z; ++x)
+		{
+			_cells[y * _columns + x].push_back(index);
+		}
+	}
+	_lifts[key] = lift;
+}
+
+glm::uvec4 LabelPlacer::GetCellRange(const glm::vec4& box) const
+{
+	// Labels partially off screen share the border cells
+	const auto cell = [](float position, uint32_t count) {
+		return static_cast<uint32_t>(std::clamp(std::floor(position / k_CellSize), 0.0f, static_cast<float>(count - 1)));
+	};
+	return {cell(box.x, _columns), cell(box.y, _rows), cell(box.x + box.z, _columns), cell(box.y + box.w, _rows)};
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+namespace openblack::debug::gui
+{
+/// Places screen space labels without overlaps, moving them up until they fit.
+///
+/// Placed labels are bucketed in a grid of cells so that a label is only tested against its neighbours. A label which
+/// was placed the previous frame first tries the same lift above its anchor, so it keeps its position while the labels
+/// around it don't change. The search for new positions is capped per frame, labels which can't be placed in time are
+/// dropped until a later frame.
+///
+/// Boxes are x, y, width, height.
+class LabelPlacer
+{
+public:
+	static constexpr float k_CellSize = 64.0f;
+	/// Moves of labels past overlapping ones per frame
+	static constexpr uint32_t k_MaxSearchSteps = 2048;
+
+	/// Start a new frame, labels may not go above \p minY
+	void Begin(const glm::vec2& displaySize, float minY);
+	/// Find a place for the label \p key anchored at \p box, which is moved up to where it fits and reserved
+	[[nodiscard]] bool Place(uint32_t key, glm::vec4& box);
+
+	[[nodiscard]] uint32_t GetPlacedCount() const { return static_cast<uint32_t>(_boxes.size()); }
+
+private:
+	[[nodiscard]] const glm::vec4* FindOverlap(const glm::vec4& box);
+	void Insert(uint32_t key, const glm::vec4& box, float lift);
+	[[nodiscard]] glm::uvec4 GetCellRange(const glm::vec4& box) const;
+
+	float _minY {0.0f};
+	uint32_t _columns {0};
+	uint32_t _rows {0};
+	uint32_t _searchSteps {0};
+	/// Indices into \ref _boxes, row major
+	std::vector<std::vector<uint32_t>> _cells;
+	std::vector<glm::vec4> _boxes;
+	/// Last query which tested each box, a box spanning several cells is only tested once
+	std::vector<uint32_t> _boxQueries;
+	uint32_t _query {0};
+	/// Distance of each label above its anchor
+	std::unordered_map<uint32_t, float> _lifts;
+	std::unordered_map<uint32_t, float> _previousLifts;
+};
+} // namespace openblack::debug::gui
@@ -10,8 +10,11 @@
 #include "LandIsland.h"
 
 #include <LNDFile.h>
+#include <glm/gtx/vec_swizzle.hpp>
 
 #include "3D/LandIslandInterface.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Registry.h"
 #include "Game.h"
 #include "Graphics/FrameBuffer.h"
 #include "Gui.h"
@@ -28,7 +31,7 @@ void LandIsland::Draw(openblack::Game& game)
 {
 	auto& config = game.GetConfig();
 
-	const auto& landIsland = Locator::terrainSystem::value();
+	auto& landIsland = Locator::terrainSystem::value();
 
 	ImGui::SliderFloat("Bump", &config.bumpMapStrength, 0.0f, 1.0f, "%.3f");
 	ImGui::SliderFloat("Small Bump", &config.smallBumpMapStrength, 0.0f, 1.0f, "%.3f");
@@ -64,6 +67,24 @@ void LandIsland::Draw(openblack::Game& game)
 		ImGui::TreePop();
 	}
 
+	if (ImGui::TreeNodeEx("Terrain Editing"))
+	{
+		ImGui::SliderFloat("Brush Radius", &_brushRadius, LandIslandInterface::k_CellSize, 200.0f, "%.1f");
+		ImGui::SliderFloat("Brush Strength", &_brushStrength, 0.0f, 50.0f, "%.1f");
+		const auto& handPosition =
+		    Locator::entitiesRegistry::value().Get<ecs::components::Transform>(game.GetHand()).position;
+		if (ImGui::Button("Raise at Hand"))
+		{
+			landIsland.AdjustAltitude(glm::xz(handPosition), _brushRadius, _brushStrength);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Lower at Hand"))
+		{
+			landIsland.AdjustAltitude(glm::xz(handPosition), _brushRadius, -_brushStrength);
+		}
+		ImGui::TreePop();
+	}
+
 	ImGui::Separator();
 
 	if (ImGui::Button("Dump Textures"))
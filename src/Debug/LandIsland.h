@@ -22,6 +22,10 @@ class LandIsland: public Window
 	void Update(Game& game, const Renderer& renderer) override;
 	void ProcessEventOpen(const SDL_Event& event) override;
 	void ProcessEventAlways(const SDL_Event& event) override;
+
+private:
+	float _brushRadius {30.0f};
+	float _brushStrength {5.0f};
 };
 
 } // namespace openblack::debug::gui
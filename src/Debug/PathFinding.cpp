@@ -70,7 +70,10 @@ void PathFinding::Draw([[maybe_unused]] Game& game)
 		{
 			auto& transform = registry.Get<Transform>(_selectedVillager.value());
 			auto& wallHug = registry.Get<WallHug>(_selectedVillager.value());
-			ImGui::DragFloat3("Position", glm::value_ptr(transform.position));
+			if (ImGui::DragFloat3("Position", glm::value_ptr(transform.position)))
+			{
+				registry.SetMoved(_selectedVillager.value());
+			}
 			ImGui::DragFloat2("Goal", glm::value_ptr(wallHug.goal));
 			ImGui::DragFloat("Speed", &wallHug.speed);
 		}
@@ -98,6 +101,7 @@ void PathFinding::Draw([[maybe_unused]] Game& game)
 				if (ImGui::Button("Execute"))
 				{
 					registry.Get<Transform>(*_selectedVillager).position = _destination;
+					registry.SetMoved(*_selectedVillager);
 				}
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
@@ -116,9 +120,10 @@ void PathFinding::Draw([[maybe_unused]] Game& game)
 				{
 					auto& wallHug = registry.Get<WallHug>(*_selectedVillager);
 					wallHug.goal = glm::xz(_destination);
-					registry.Remove<MoveStateLinearTag, MoveStateOrbitTag, MoveStateExitCircleTag, MoveStateStepThroughTag,
-					                MoveStateFinalStepTag, MoveStateArrivedTag>(*_selectedVillager);
-					registry.Assign<MoveStateLinearTag>(*_selectedVillager);
+					auto& state = registry.Get<WallHugState>(*_selectedVillager);
+					state.state = MoveState::Linear;
+					state.clockwise = MoveStateClockwise::Undefined;
+					state.stepGoal = {};
 				}
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
@@ -11,14 +11,18 @@
 
 #include <cinttypes>
 
+#include <algorithm>
+
 #include <bgfx/bgfx.h>
 #include <imgui_widget_flamegraph.h>
 
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/Tree.h"
 #include "ECS/Registry.h"
+#include "ECS/Systems/RenderingSystemInterface.h"
 #include "Game.h"
 #include "Locator.h"
+#include "Renderer.h"
 
 #include "../Profiler.h"
 
@@ -60,6 +64,18 @@ void Profiler::Draw(Game& game)
 	ImGui::Text("Submit CPU %0.3f, GPU %0.3f (Max GPU Latency: %d)", double(stats->cpuTimeEnd - stats->cpuTimeBegin) * toMsCpu,
 	            double(stats->gpuTimeEnd - stats->gpuTimeBegin) * toMsGpu, stats->maxGpuLatency);
 	ImGui::Text("Wait Submit %0.3f, Wait Render %0.3f", stats->waitSubmit * toMsCpu, stats->waitRender * toMsCpu);
+	const auto frameTimes = game.GetProfiler().GetFrameTimes();
+	ImGui::Text("Frame Time %0.3f, Standard Deviation %0.3f", frameTimes.mean.count(), frameTimes.standardDeviation.count());
+	if (game.GetRenderer().HasRenderThread())
+	{
+		// Render thread work which the game thread didn't have to wait for
+		const auto renderMs = double(stats->cpuTimeEnd - stats->cpuTimeBegin) * toMsCpu;
+		ImGui::Text("Render Thread, overlapped with game %0.3f", std::max(renderMs - stats->waitRender * toMsCpu, 0.0));
+	}
+	else
+	{
+		ImGui::Text("Rendering on the game thread");
+	}
 
 	ImGui::Columns(5);
 	ImGui::Checkbox("Sky", &config.drawSky);
@@ -100,6 +116,15 @@ void Profiler::Draw(Game& game)
 
 	ImGui::Columns(1);
 
+	ImGui::Checkbox("Occlusion Culling", &config.occlusionCulling);
+	if (config.occlusionCulling)
+	{
+		const auto& occlusion = Locator::rendereringSystem::value().GetContext().occlusionCuller.GetStatistics();
+		ImGui::SameLine();
+		ImGui::Text("Occluder Triangles %u, Instances Tested %u, Occluded %u, Outside View %u", occlusion.occluderTriangles,
+		            occlusion.testedBoxes, occlusion.occludedBoxes, occlusion.outsideBoxes);
+	}
+
 	auto& entry = game.GetProfiler().GetEntries().at(game.GetProfiler().GetEntryIndex(-1));
 
 	ImGuiWidgetFlameGraph::PlotFlame(
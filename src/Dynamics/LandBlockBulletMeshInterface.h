@@ -37,13 +37,24 @@ class LandBlockBulletMeshInterface: public btStridingMeshInterface
 	    : _vertices(vertexCount / stride)
 	    , _indices(vertexCount / stride)
 	{
-		for (uint16_t i = 0; auto& v : _vertices)
+		for (uint16_t i = 0; auto& index : _indices)
+		{
+			index = i++;
+		}
+		Update(vertexData, vertexCount, stride);
+	}
+
+	/// Copy new vertex positions in place, the vertex count and layout must not change.
+	/// The owning shape's BVH must be refit afterwards.
+	void Update(const uint8_t* vertexData, [[maybe_unused]] uint32_t vertexCount, size_t stride)
+	{
+		assert(vertexCount / stride == _vertices.size());
+		for (size_t i = 0; auto& v : _vertices)
 		{
 			const auto* vertexBase = reinterpret_cast<const float*>(&vertexData[i * stride]);
 			v[0] = vertexBase[0];
 			v[1] = vertexBase[1];
 			v[2] = vertexBase[2];
-			_indices[i] = i;
 			++i;
 		}
 	}
@@ -17,6 +17,7 @@
 #include "ECS/Components/Fixed.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
+#include "ECS/Components/Pot.h"
 #include "ECS/Components/StoragePit.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
@@ -58,6 +59,22 @@ void AddStoragePitComponents(entt::entity entity, const Mesh& pitMesh, const GAb
 	const auto& m = extraMetrics.at(5);
 	auto translation = static_cast<glm::vec3>(glm::eulerAngleY(-yAngleRadians) * m[3]);
 	pit.foodPile = PotArchetype::Create(position + translation, yAngleRadians, info.potForResourceFood, foodAmount);
+
+	// Piles which are empty aren't created. The others only count towards the town once they are in the pit
+	auto& piles = registry.Context().storagePiles;
+	for (const auto pile : pit.woodPiles)
+	{
+		if (pile != entt::null)
+		{
+			piles.Link(entity, pile);
+			registry.Patch<Pot>(pile);
+		}
+	}
+	if (pit.foodPile != entt::null)
+	{
+		piles.Link(entity, pit.foodPile);
+		registry.Patch<Pot>(pit.foodPile);
+	}
 }
 
 entt::entity AbodeArchetype::Create(uint32_t townId, const glm::vec3& position, AbodeInfo type, float yAngleRadians,
@@ -9,6 +9,10 @@
 
 #include "TreeArchetype.h"
 
+#include <cassert>
+
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 
 #include "ECS/Components/Fixed.h"
@@ -42,3 +46,35 @@ entt::entity TreeArchetype::Create([[maybe_unused]] uint32_t forestId, const glm
 
 	return entity;
 }
+
+void TreeArchetype::Create(std::span<const Definition> trees, std::span<entt::entity> entities)
+{
+	assert(trees.size() == entities.size());
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& infos = Game::Instance()->GetInfoConstants().tree;
+
+	std::vector<Transform> transforms;
+	std::vector<Fixed> fixed;
+	std::vector<Tree> treeComponents;
+	std::vector<Mesh> meshes;
+	transforms.reserve(trees.size());
+	fixed.reserve(trees.size());
+	treeComponents.reserve(trees.size());
+	meshes.reserve(trees.size());
+	for (const auto& tree : trees)
+	{
+		const auto& info = infos.at(static_cast<size_t>(tree.type));
+		const auto& transform = transforms.emplace_back(
+		    Transform {tree.position, glm::mat3(glm::eulerAngleY(-tree.yAngleRadians)), glm::vec3(tree.scale)});
+		const auto [point, radius] = GetFixedObstacleBoundingCircle(info.normal, transform);
+		fixed.emplace_back(point, radius);
+		treeComponents.push_back({tree.type, tree.maxSize});
+		meshes.push_back({resources::MeshIdToResourceId(info.normal), static_cast<int8_t>(0), static_cast<int8_t>(-1)});
+	}
+
+	registry.Create(entities.begin(), entities.end());
+	registry.Insert<Transform>(entities.begin(), entities.end(), transforms.cbegin());
+	registry.Insert<Fixed>(entities.begin(), entities.end(), fixed.cbegin());
+	registry.Insert<Tree>(entities.begin(), entities.end(), treeComponents.cbegin());
+	registry.Insert<Mesh>(entities.begin(), entities.end(), meshes.cbegin());
+}
@@ -9,8 +9,10 @@
 
 #pragma once
 
+#include <span>
+
 #include <entt/fwd.hpp>
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Enums.h"
 
@@ -19,8 +21,21 @@ namespace openblack::ecs::archetypes
 class TreeArchetype
 {
 public:
+	struct Definition
+	{
+		uint32_t forestId;
+		glm::vec3 position;
+		TreeInfo type;
+		bool isNonScenic;
+		float yAngleRadians;
+		float maxSize;
+		float scale;
+	};
+
 	static entt::entity Create(uint32_t forestId, const glm::vec3& position, TreeInfo type, bool isNonScenic,
 	                           float yAngleRadians, float maxSize, float scale);
+	/// Create all of the \p trees at once, with their components inserted pool by pool, into \p entities
+	static void Create(std::span<const Definition> trees, std::span<entt::entity> entities);
 	TreeArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
@@ -15,6 +15,7 @@
 
 #include "3D/L3DMesh.h"
 #include "ECS/Components/Transform.h"
+#include "ECS/Registry.h"
 #include "Locator.h"
 #include "Resources/MeshId.h"
 #include "Resources/ResourcesInterface.h"
@@ -22,19 +23,32 @@
 using namespace openblack;
 using namespace openblack::ecs::components;
 
-std::pair<glm::vec2, float> openblack::ecs::archetypes::GetFixedObstacleBoundingCircle(MeshId meshId,
-                                                                                       const Transform& transform)
+namespace
+{
+const ecs::MeshFootprint& GetFootprint(MeshId meshId)
 {
+	// Mesh bounding boxes don't change once loaded, the footprints are forgotten with the rest of the level
+	auto& footprints = Locator::entitiesRegistry::value().Context().meshFootprints;
+	const auto cached = footprints.find(meshId);
+	if (cached != footprints.end())
+	{
+		return cached->second;
+	}
+
 	auto resourceId = resources::MeshIdToResourceId(meshId);
 	const auto l3dMesh = Locator::resources::value().GetMeshes().Handle(resourceId);
 	assert(l3dMesh);
 	const auto& bb = l3dMesh->GetBoundingBox();
-	const auto bbSize = glm::max(glm::vec2(1.0f, 1.0f), glm::xz(bb.Size() * 0.5f * transform.scale));
-	glm::mat4 modelMatrix = glm::mat4(1.0f);
-	modelMatrix = glm::translate(modelMatrix, transform.position);
-	modelMatrix *= glm::mat4(transform.rotation);
-	modelMatrix = glm::scale(modelMatrix, transform.scale);
-	const auto point = glm::xz(glm::vec4(bb.Center(), 1.0f) * glm::transpose(modelMatrix));
+	return footprints.emplace(meshId, ecs::MeshFootprint {bb.Center(), glm::xz(bb.Size() * 0.5f)}).first->second;
+}
+} // namespace
+
+std::pair<glm::vec2, float> openblack::ecs::archetypes::GetFixedObstacleBoundingCircle(MeshId meshId,
+                                                                                       const Transform& transform)
+{
+	const auto& footprint = GetFootprint(meshId);
+	const auto bbSize = glm::max(glm::vec2(1.0f, 1.0f), footprint.halfSize * glm::xz(transform.scale));
+	const auto point = glm::xz(transform.position + transform.rotation * (footprint.center * transform.scale));
 	const auto radius = (glm::compMax(bbSize) / glm::compMin(bbSize) > 1.4) ? glm::length(bbSize) : glm::compMax(bbSize);
 
 	return std::make_pair(point, radius);
@@ -38,12 +38,14 @@ entt::entity VillagerArchetype::Create([[maybe_unused]] const glm::vec3& abodePo
 
 	const auto& info = Game::Instance()->GetInfoConstants().villager.at(static_cast<size_t>(type));
 
-	registry.Assign<Transform>(entity, position, glm::eulerAngleY(glm::radians(180.0f)), glm::vec3(1.0));
+	const Transform transform {position, glm::eulerAngleY(glm::radians(180.0f)), glm::vec3(1.0)};
+	registry.Assign<Transform>(entity, transform);
+	registry.Assign<PreviousTransform>(entity, transform.position, transform.rotation);
 	registry.Assign<Mobile>(entity);
-	const uint32_t health = 100;
-	const uint32_t hunger = 100;
+	const float health = 100.0f;
+	const float hunger = 100.0f;
 
-	const auto lifeStage = age < 18 ? Villager::LifeStage::Child : Villager::LifeStage::Adult;
+	const auto lifeStage = age < info.grownUpAge ? Villager::LifeStage::Child : Villager::LifeStage::Adult;
 	const auto sex = info.villagerNumber == VillagerNumber::Housewife ? Villager::Sex::FEMALE : Villager::Sex::MALE;
 	const auto task = Villager::Task::IDLE;
 
@@ -55,9 +57,14 @@ entt::entity VillagerArchetype::Create([[maybe_unused]] const glm::vec3& abodePo
 		abode = Locator::townSystem::value().FindAbodeWithSpace(town);
 	}
 
-	registry.Assign<Villager>(entity, health, static_cast<uint32_t>(age), hunger, lifeStage, sex, info.tribeType,
-	                          info.villagerNumber, task, town, abode);
+	registry.Assign<Villager>(entity, lifeStage, sex, info.tribeType, info.villagerNumber, task, town, entt::null);
+	registry.Assign<VillagerNeeds>(entity, health, hunger, age, type);
+	if (abode != entt::null)
+	{
+		Locator::townSystem::value().AddVillagerToAbode(abode, entity);
+	}
 	registry.Assign<WallHug>(entity, glm::vec2(), glm::vec2(), GetSpeedStateSpeed(info.speedGroup.speedDefault));
+	registry.Assign<WallHugState>(entity);
 	const auto resourceId = resources::MeshIdToResourceId(info.highDetail);
 	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(0));
 	auto turnsSinceStateChange = Locator::rng::value().NextValue<uint16_t>(1, 500);
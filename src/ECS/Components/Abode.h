@@ -9,8 +9,6 @@
 
 #pragma once
 
-#include <set>
-
 #include "Enums.h"
 
 namespace openblack::ecs::components
@@ -24,8 +22,7 @@ struct Abode
 	// by the villagers
 	uint32_t foodAmount;
 	uint32_t woodAmount;
-	/// Villager
-	std::set<entt::entity> inhabitants;
+	// The inhabitants are linked to the abode in RegistryContext::abodeInhabitants
 };
 
 } // namespace openblack::ecs::components
@@ -9,9 +9,7 @@
 
 #pragma once
 
-#include <set>
-#include <string>
-#include <unordered_map>
+#include <cstdint>
 
 namespace openblack::ecs::components
 {
@@ -19,9 +17,10 @@ namespace openblack::ecs::components
 struct Town
 {
 	uint32_t id;
-	std::unordered_map<std::string, float> beliefs;
+	/// Row of the town's beliefs in the town system
+	uint32_t beliefIndex {0};
 	bool uninhabitable = false;
-	std::set<entt::entity> homelessVillagers;
+	// The homeless villagers are linked to the town in RegistryContext::homelessVillagers
 };
 
 } // namespace openblack::ecs::components
@@ -22,4 +22,12 @@ struct Transform
 	glm::vec3 scale;
 };
 
+/// Transform of an entity moved by the turns as the last turn started. The renderer draws it between this and its
+/// \ref Transform by how far into the next turn the frame is.
+struct PreviousTransform
+{
+	glm::vec3 position;
+	glm::mat3 rotation;
+};
+
 } // namespace openblack::ecs::components
@@ -64,9 +64,6 @@ struct Villager
 
 	using Type = std::tuple<Tribe, Villager::LifeStage, Villager::Sex, VillagerNumber>;
 
-	uint32_t health;
-	uint32_t age;
-	uint32_t hunger;
 	LifeStage lifeStage;
 	Sex sex;
 	Tribe tribe;
@@ -75,4 +72,16 @@ struct Villager
 	entt::entity town;
 	entt::entity abode;
 };
+
+/// What a villager needs to live, which changes every turn. It is kept apart from Villager so that the lifecycle update
+/// streams through a small packed array.
+struct VillagerNeeds
+{
+	float health;
+	/// Food in the villager's belly
+	float hunger;
+	/// In years
+	uint32_t age;
+	VillagerInfo type;
+};
 } // namespace openblack::ecs::components
@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <optional>
+
 #include <entt/fwd.hpp>
 #include <glm/vec2.hpp>
 
@@ -30,29 +34,27 @@ enum class MoveState
 	StepThrough,
 	FinalStep,
 	Arrived,
+	/// Not given a move yet
+	Idle,
 };
 
-template <MoveState S>
-struct MoveStateTagComponent
-{
-	static constexpr MoveState k_Value = S;
-	MoveStateClockwise clockwise;
-	glm::vec2 stepGoal;
-};
-
-using MoveStateLinearTag = MoveStateTagComponent<MoveState::Linear>;
-using MoveStateOrbitTag = MoveStateTagComponent<MoveState::Orbit>;
-using MoveStateExitCircleTag = MoveStateTagComponent<MoveState::ExitCircle>;
-using MoveStateStepThroughTag = MoveStateTagComponent<MoveState::StepThrough>;
-using MoveStateFinalStepTag = MoveStateTagComponent<MoveState::FinalStep>;
-using MoveStateArrivedTag = MoveStateTagComponent<MoveState::Arrived>;
-
 struct WallHugObjectReference
 {
 	uint8_t stepsAway;
 	entt::entity entity;
 };
 
+/// Movement state of a wall hugging entity. Transitions are made in place so that moving entities don't add or remove
+/// components every turn.
+struct WallHugState
+{
+	MoveState state {MoveState::Idle};
+	MoveStateClockwise clockwise {MoveStateClockwise::Undefined};
+	glm::vec2 stepGoal {0.0f, 0.0f};
+	/// Obstacle ahead or being orbited
+	std::optional<WallHugObjectReference> reference;
+};
+
 struct WallHug
 {
 	glm::vec2 goal;
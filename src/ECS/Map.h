@@ -12,6 +12,7 @@
 #include <cstdint>
 
 #include <array>
+#include <span>
 #include <unordered_set>
 
 #include <entt/fwd.hpp>
@@ -21,6 +22,15 @@
 namespace openblack::ecs
 {
 
+/// Fixed obstacles of a grid cell as packed arrays for batched intersection tests, one element per obstacle
+struct FixedObstacles
+{
+	std::span<const float> centerX;
+	std::span<const float> centerZ;
+	std::span<const float> radius;
+	std::span<const entt::entity> entities;
+};
+
 class MapInterface
 {
 public:
@@ -35,6 +45,8 @@ class MapInterface
 
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const CellId& cellId) const = 0;
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const = 0;
+	/// Same as \ref GetFixedInGridCell without fields, which can be walked through
+	[[nodiscard]] virtual FixedObstacles GetObstaclesInGridCell(const CellId& cellId) const = 0;
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const = 0;
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const = 0;
 
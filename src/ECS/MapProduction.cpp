@@ -16,6 +16,7 @@
 #include <glm/gtx/vec_swizzle.hpp>
 #include <glm/vec3.hpp>
 
+#include "ECS/Components/Field.h"
 #include "ECS/Components/Fixed.h"
 #include "ECS/Components/Mobile.h"
 #include "ECS/Components/Transform.h"
@@ -36,6 +37,23 @@ const std::unordered_set<entt::entity>& MapProduction::GetFixedInGridCell(const
 	return GetFixedInGridCell(cellId);
 }
 
+FixedObstacles MapProduction::GetObstaclesInGridCell(const CellId& cellId) const
+{
+	const auto cell = cellId.x + cellId.y * k_GridSize.x;
+	if (_obstacleOffsets.empty())
+	{
+		return {};
+	}
+	const auto offset = _obstacleOffsets.at(cell);
+	const auto count = _obstacleOffsets.at(cell + 1) - offset;
+	return {
+	    {_obstacleCenterX.data() + offset, count},
+	    {_obstacleCenterZ.data() + offset, count},
+	    {_obstacleRadius.data() + offset, count},
+	    {_obstacleEntities.data() + offset, count},
+	};
+}
+
 const std::unordered_set<entt::entity>& MapProduction::GetMobileInGridCell(const CellId& cellId) const
 {
 	return _mobileGrid.at(cellId.x + cellId.y * k_GridSize.x);
@@ -63,6 +81,11 @@ void MapProduction::Clear()
 	{
 		g.clear();
 	}
+	_obstacleOffsets.clear();
+	_obstacleCenterX.clear();
+	_obstacleCenterZ.clear();
+	_obstacleRadius.clear();
+	_obstacleEntities.clear();
 }
 
 void MapProduction::Build()
@@ -93,4 +116,29 @@ void MapProduction::Build()
 		    auto& cell = _mobileGrid.at(cellId.x + cellId.y * k_GridSize.x);
 		    cell.insert(entity);
 	    });
+	BuildObstacles();
+}
+
+void MapProduction::BuildObstacles()
+{
+	// The fixed components are copied once here so that path finding doesn't look them up for every step
+	auto& registry = Locator::entitiesRegistry::value();
+	_obstacleOffsets.reserve(_fixedGrid.size() + 1);
+	for (const auto& cell : _fixedGrid)
+	{
+		_obstacleOffsets.push_back(static_cast<uint32_t>(_obstacleEntities.size()));
+		for (const auto entity : cell)
+		{
+			if (registry.AnyOf<Field>(entity)) // TODO(bwrsandman): || !registry.AllOf<CollideData>();
+			{
+				continue;
+			}
+			const auto& fixed = registry.Get<const Fixed>(entity);
+			_obstacleCenterX.push_back(fixed.boundingCenter.x);
+			_obstacleCenterZ.push_back(fixed.boundingCenter.y);
+			_obstacleRadius.push_back(fixed.boundingRadius);
+			_obstacleEntities.push_back(entity);
+		}
+	}
+	_obstacleOffsets.push_back(static_cast<uint32_t>(_obstacleEntities.size()));
 }
@@ -13,6 +13,8 @@
 #warning "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+#include <vector>
+
 #include "Map.h"
 
 namespace openblack::ecs
@@ -22,6 +24,7 @@ class MapProduction final: public MapInterface
 {
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const CellId& cellId) const override;
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const override;
+	[[nodiscard]] FixedObstacles GetObstaclesInGridCell(const CellId& cellId) const override;
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const override;
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const override;
 
@@ -30,8 +33,15 @@ class MapProduction final: public MapInterface
 private:
 	void Clear() override;
 	void Build() override;
+	void BuildObstacles();
 
 	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _fixedGrid;
+	/// Obstacles of all cells one after the other, cell i spans [_obstacleOffsets[i], _obstacleOffsets[i + 1])
+	std::vector<uint32_t> _obstacleOffsets;
+	std::vector<float> _obstacleCenterX;
+	std::vector<float> _obstacleCenterZ;
+	std::vector<float> _obstacleRadius;
+	std::vector<entt::entity> _obstacleEntities;
 	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _mobileGrid;
 };
 
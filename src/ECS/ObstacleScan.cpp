@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "ObstacleScan.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include <entt/entity/entity.hpp>
+
+using namespace openblack::ecs;
+
+namespace
+{
+constexpr size_t k_BlockSize = 8;
+constexpr float k_NoHit = std::numeric_limits<float>::infinity();
+
+/// Score the obstacles in fixed size blocks without branches so that the compiler vectorises \p score, then keep the
+/// lowest.
+template <typename Score>
+std::optional<ObstacleHit> FindLowest(const FixedObstacles& obstacles, Score score)
+{
+	const auto count = obstacles.entities.size();
+	std::optional<ObstacleHit> result;
+	auto lowest = k_NoHit;
+	std::array<float, k_BlockSize> scores;
+	for (size_t first = 0; first < count; first += k_BlockSize)
+	{
+		const auto lanes = std::min(k_BlockSize, count - first);
+		for (size_t lane = 0; lane < lanes; ++lane)
+		{
+			scores[lane] = score(first + lane);
+		}
+		for (size_t lane = 0; lane < lanes; ++lane)
+		{
+			if (scores[lane] < lowest)
+			{
+				lowest = scores[lane];
+				result = ObstacleHit {obstacles.entities[first + lane], lowest};
+			}
+		}
+	}
+	return result;
+}
+} // namespace
+
+std::optional<ObstacleHit> openblack::ecs::CastRayAtObstacles(const FixedObstacles& obstacles, const glm::vec2& origin,
+                                                              const glm::vec2& direction)
+{
+	// Ray-circle intersection in 2d with ray = {origin, direction}, circle = {center, radius} (same as ray-sphere)
+	return FindLowest(obstacles, [&obstacles, origin, direction](size_t i) {
+		const auto ocX = origin.x - obstacles.centerX[i];
+		const auto ocZ = origin.y - obstacles.centerZ[i];
+		const auto halfB = ocX * direction.x + ocZ * direction.y;
+		const auto c = ocX * ocX + ocZ * ocZ - obstacles.radius[i] * obstacles.radius[i];
+		const auto discriminant = halfB * halfB - c;
+		// Misses take the square root of a negative, which is masked out below
+		const auto t = -halfB - std::sqrt(discriminant);
+		const bool inFront = (discriminant > 0.0f) & (t > 0.0f);
+		return inFront ? t : k_NoHit;
+	});
+}
+
+std::optional<ObstacleHit> openblack::ecs::FindOverlappingObstacle(const FixedObstacles& obstacles, const glm::vec2& center,
+                                                                   float radius, entt::entity ignore)
+{
+	return FindLowest(obstacles, [&obstacles, center, radius, ignore](size_t i) {
+		const auto dX = obstacles.centerX[i] - center.x;
+		const auto dZ = obstacles.centerZ[i] - center.y;
+		const auto d2 = dX * dX + dZ * dZ;
+		const auto r = obstacles.radius[i] + radius;
+		const bool overlaps = (d2 < r * r) & (d2 > 0.0f) & (obstacles.entities[i] != ignore);
+		return overlaps ? std::sqrt(d2) : k_NoHit;
+	});
+}
@@ -0,0 +1,37 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <optional>
+
+#include <entt/entity/fwd.hpp>
+#include <glm/vec2.hpp>
+
+#include "Map.h"
+
+namespace openblack::ecs
+{
+
+struct ObstacleHit
+{
+	entt::entity entity;
+	/// Along the ray for \ref CastRayAtObstacles, between the centers for \ref FindOverlappingObstacle
+	float distance;
+};
+
+/// Nearest obstacle which the ray from \p origin along the normalised \p direction enters in front of the origin
+[[nodiscard]] std::optional<ObstacleHit> CastRayAtObstacles(const FixedObstacles& obstacles, const glm::vec2& origin,
+                                                           const glm::vec2& direction);
+
+/// Nearest obstacle other than \p ignore overlapping the circle, obstacles at the same center are not counted
+[[nodiscard]] std::optional<ObstacleHit> FindOverlappingObstacle(const FixedObstacles& obstacles, const glm::vec2& center,
+                                                                float radius, entt::entity ignore);
+
+} // namespace openblack::ecs
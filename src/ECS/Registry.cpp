@@ -9,8 +9,63 @@
 
 #include "Registry.h"
 
+#include "Components/Abode.h"
+#include "Components/Pot.h"
+#include "Components/StoragePit.h"
+#include "Components/Town.h"
+#include "Components/Transform.h"
+#include "Components/Villager.h"
 #include "Locator.h"
 #include "Systems/RenderingSystemInterface.h"
+#include "Systems/SpatialQuerySystemInterface.h"
+
+namespace
+{
+using namespace openblack::ecs;
+
+void UnlinkVillager(entt::registry& registry, entt::entity entity)
+{
+	auto& context = registry.ctx().get<RegistryContext>();
+	context.abodeInhabitants.Unlink(entity);
+	context.homelessVillagers.Unlink(entity);
+}
+
+void ClearAbode(entt::registry& registry, entt::entity entity)
+{
+	auto& inhabitants = registry.ctx().get<RegistryContext>().abodeInhabitants;
+	for (const auto villager : inhabitants.GetChildren(entity))
+	{
+		if (registry.all_of<components::Villager>(villager))
+		{
+			registry.patch<components::Villager>(villager, [](auto& component) { component.abode = entt::null; });
+		}
+	}
+	inhabitants.Clear(entity);
+}
+
+void ClearTown(entt::registry& registry, entt::entity entity)
+{
+	registry.ctx().get<RegistryContext>().homelessVillagers.Clear(entity);
+}
+
+void UnlinkPile(entt::registry& registry, entt::entity entity)
+{
+	registry.ctx().get<RegistryContext>().storagePiles.Unlink(entity);
+}
+
+void ClearStoragePit(entt::registry& registry, entt::entity entity)
+{
+	registry.ctx().get<RegistryContext>().storagePiles.Clear(entity);
+}
+
+void MoveTransform([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	if (openblack::Locator::spatialQuerySystem::has_value())
+	{
+		openblack::Locator::spatialQuerySystem::value().SetMoved(entity);
+	}
+}
+} // namespace
 
 namespace openblack::ecs
 {
@@ -18,6 +73,14 @@ namespace openblack::ecs
 Registry::Registry()
 {
 	_registry.ctx().emplace<RegistryContext>();
+	// Links can't outlive their entities, these also run when the registry is reset
+	_registry.on_destroy<components::Villager>().connect<&UnlinkVillager>();
+	_registry.on_destroy<components::Abode>().connect<&ClearAbode>();
+	_registry.on_destroy<components::Town>().connect<&ClearTown>();
+	_registry.on_destroy<components::Pot>().connect<&UnlinkPile>();
+	_registry.on_destroy<components::StoragePit>().connect<&ClearStoragePit>();
+	// Replacing or patching a transform moves its entity, writes in place go through SetMoved
+	_registry.on_update<components::Transform>().connect<&MoveTransform>();
 }
 
 void Registry::Release(entt::entity entity)
@@ -28,6 +91,7 @@ void Registry::Release(entt::entity entity)
 
 void Registry::Destroy(entt::entity entity)
 {
+	SetDirty();
 	_registry.destroy(entity);
 }
 
@@ -52,5 +116,14 @@ void Registry::Reset()
 void Registry::SetDirty()
 {
 	Locator::rendereringSystem::value().SetDirty();
+	if (Locator::spatialQuerySystem::has_value())
+	{
+		Locator::spatialQuerySystem::value().SetDirty();
+	}
+}
+
+void Registry::SetMoved(entt::entity entity)
+{
+	MoveTransform(_registry, entity);
 }
 } // namespace openblack::ecs
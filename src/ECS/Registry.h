@@ -12,6 +12,7 @@
 #include <entt/entt.hpp>
 
 #include "ECS/RegistryContext.h"
+#include "ECS/RegistryGroups.h"
 
 namespace openblack
 {
@@ -47,6 +48,7 @@ class Registry
 	template <typename It>
 	void Destroy(It first, It last)
 	{
+		SetDirty();
 		_registry.destroy(first, last);
 	}
 	template <typename Component, typename... Args>
@@ -55,6 +57,12 @@ class Registry
 		SetDirty();
 		return _registry.emplace<Component>(entity, std::forward<Args>(args)...);
 	}
+	template <typename Component, typename It, typename ComponentIt>
+	void Insert(It first, It last, ComponentIt from)
+	{
+		SetDirty();
+		_registry.insert<Component>(first, last, from);
+	}
 	template <typename Component, typename... Args>
 	decltype(auto) AssignOrReplace(entt::entity entity, [[maybe_unused]] Args&&... args)
 	{
@@ -67,6 +75,28 @@ class Registry
 		SetDirty();
 		return _registry.remove<Component, Other...>(entity);
 	}
+	/// Change a component in place and let the listeners of its updates know
+	template <typename Component, typename... Func>
+	decltype(auto) Patch(entt::entity entity, Func&&... func)
+	{
+		SetDirty();
+		return _registry.patch<Component>(entity, std::forward<Func>(func)...);
+	}
+	template <typename Component>
+	decltype(auto) OnConstruct()
+	{
+		return _registry.on_construct<Component>();
+	}
+	template <typename Component>
+	decltype(auto) OnUpdate()
+	{
+		return _registry.on_update<Component>();
+	}
+	template <typename Component>
+	decltype(auto) OnDestroy()
+	{
+		return _registry.on_destroy<Component>();
+	}
 	template <typename After, typename Before, typename... Args>
 	decltype(auto) SwapComponents(entt::entity entity, [[maybe_unused]] Before previousComponent,
 	                              [[maybe_unused]] Args&&... args)
@@ -75,9 +105,30 @@ class Registry
 		return Assign<After>(entity, std::forward<Args>(args)...);
 	}
 	virtual void SetDirty();
+	/// The transform of \p entity was written in place, let the systems which cache where entities are know
+	virtual void SetMoved(entt::entity entity);
 	virtual RegistryContext& Context();
 	[[nodiscard]] virtual const RegistryContext& Context() const;
 	virtual void Reset();
+	/// Reorder a pool, which unlike adding or removing components keeps the rendering context valid
+	template <typename Component, typename Compare, typename Sort = entt::std_sort>
+	void Sort(Compare compare, Sort algo = Sort {})
+	{
+		_registry.sort<Component>(std::move(compare), std::move(algo));
+	}
+	/// Group which owns the pools of \p Owned, keeping the components of entities which have all of them packed in the
+	/// same order
+	template <typename... Owned>
+	decltype(auto) Group()
+	{
+		return _registry.group<Owned...>();
+	}
+	/// The pool of \p Component, which iterates in the order it was last sorted in
+	template <typename Component>
+	decltype(auto) Storage()
+	{
+		return _registry.storage<Component>();
+	}
 	template <typename Component>
 	size_t Size()
 	{
@@ -108,15 +159,35 @@ class Registry
 	{
 		return _registry.view<Components...>().front();
 	}
+	/// Call \p func with the \p Components of every entity which has them all, through their group when RegistryGroups
+	/// declares one for them
 	template <typename... Components, typename... Exclude, typename Func>
 	decltype(auto) Each(Func func, Exclude... exclude)
 	{
-		return _registry.view<Components...>(exclude...).each(func);
-	}
+		constexpr auto k_Group = k_RegistryGroupIndex<Components...>;
+		if constexpr (sizeof...(Exclude) == 0 && k_Group < std::tuple_size_v<RegistryGroups>)
+		{
+			EachInGroup<false, Components...>(std::tuple_element_t<k_Group, RegistryGroups>::Get(_registry), func);
+		}
+		else
+		{
+			_registry.view<Components...>(exclude...).each(func);
+		}
+	}
+	/// Same as the non-const overload, a group is only used once it was created by a non-const iteration
 	template <typename... Components, typename... Exclude, typename Func>
-	[[nodiscard]] decltype(auto) Each(Func func, Exclude... exclude) const
-	{
-		return _registry.view<Components...>(exclude...).each(func);
+	decltype(auto) Each(Func func, Exclude... exclude) const
+	{
+		constexpr auto k_Group = k_RegistryGroupIndex<Components...>;
+		if constexpr (sizeof...(Exclude) == 0 && k_Group < std::tuple_size_v<RegistryGroups>)
+		{
+			if (auto group = std::tuple_element_t<k_Group, RegistryGroups>::GetIfExists(_registry))
+			{
+				EachInGroup<true, Components...>(group, func);
+				return;
+			}
+		}
+		_registry.view<Components...>(exclude...).each(func);
 	}
 	template <typename Component>
 	[[nodiscard]] decltype(auto) ToEntity(const Component& component) const
@@ -143,6 +214,29 @@ class Registry
 
 protected:
 	entt::registry _registry;
+
+private:
+	/// Groups of a const registry hand out const components
+	template <typename Component, bool Const>
+	using GroupElement =
+	    std::conditional_t<Const, const std::remove_const_t<Component>&, std::remove_const_t<Component>&>;
+
+	template <bool Const, typename... Components, typename Group, typename Func>
+	static void EachInGroup(Group&& group, Func& func)
+	{
+		// Group elements are in the layout's order, hand them over in the order the caller asked for
+		for (auto&& element : group.each())
+		{
+			if constexpr (std::is_invocable_v<Func&, entt::entity, GroupElement<Components, Const>...>)
+			{
+				func(std::get<entt::entity>(element), std::get<GroupElement<Components, Const>>(element)...);
+			}
+			else
+			{
+				func(std::get<GroupElement<Components, Const>>(element)...);
+			}
+		}
+	}
 };
 
 } // namespace openblack::ecs
@@ -9,20 +9,45 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <unordered_map>
 
 #include <entt/entity/fwd.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 
 #include "Components/Footpath.h"
 #include "Components/Stream.h"
 #include "Components/Town.h"
+#include "Relationship.h"
+
+namespace openblack
+{
+enum class MeshId : uint32_t;
+}
 
 namespace openblack::ecs
 {
+/// Center of a mesh's bounding box and its half extents on the ground, in the mesh's space
+struct MeshFootprint
+{
+	glm::vec3 center;
+	glm::vec2 halfSize;
+};
+
 struct RegistryContext
 {
 	std::unordered_map<components::Footpath::Id, entt::entity> footpaths;
 	std::unordered_map<components::Stream::Id, entt::entity> streams;
 	std::unordered_map<uint32_t, entt::entity> towns;
+	/// Villagers living in an abode
+	Relationship abodeInhabitants;
+	/// Villagers of a town without an abode
+	Relationship homelessVillagers;
+	/// Piles of a storage pit
+	Relationship storagePiles;
+	/// Footprints of the meshes of fixed obstacles, only transformed for each instance
+	std::unordered_map<MeshId, MeshFootprint> meshFootprints;
 };
 } // namespace openblack::ecs
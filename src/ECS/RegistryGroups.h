@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+#include <entt/entity/registry.hpp>
+
+#include "ECS/Components/Fixed.h"
+#include "ECS/Components/Mobile.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/Villager.h"
+
+namespace openblack::ecs
+{
+template <typename... Owned>
+struct Owns
+{
+};
+
+template <typename... Observed>
+struct Observes
+{
+};
+
+/// A group which owns the pools of some components and only observes the pools of others
+template <typename OwnedList, typename ObservedList = Observes<>>
+struct GroupLayout;
+
+template <typename... Owned, typename... Observed>
+struct GroupLayout<Owns<Owned...>, Observes<Observed...>>
+{
+	template <typename Component>
+	static constexpr bool k_Contains =
+	    (std::is_same_v<Component, Owned> || ...) || (std::is_same_v<Component, Observed> || ...);
+
+	/// Whether iterating exactly \p Components, in any order or constness, can go through this group
+	template <typename... Components>
+	static constexpr bool k_Matches =
+	    sizeof...(Components) == sizeof...(Owned) + sizeof...(Observed) &&
+	    (k_Contains<std::remove_const_t<Components>> && ...);
+
+	static decltype(auto) Get(entt::registry& registry) { return registry.group<Owned...>(entt::get<Observed...>); }
+	/// The group if it was created, which a const registry can't do
+	static decltype(auto) GetIfExists(const entt::registry& registry)
+	{
+		return registry.group_if_exists<Owned...>(entt::get<Observed...>);
+	}
+};
+
+/// Component combinations iterated every turn or frame, which Registry::Each goes through groups for.
+///
+/// A pool can only be owned by one group and can't be sorted once it is owned, so components sorted by their systems,
+/// such as the wall hug states of the pathfinding, are left to views. Transform isn't owned either: the rendering and
+/// spatial query loops over meshes exclude different components, which a group can't serve, and owning it would move
+/// transforms around whenever an entity gains a mesh.
+using RegistryGroups = std::tuple<                                           //
+    GroupLayout<Owns<components::Fixed>, Observes<components::Transform>>,   //
+    GroupLayout<Owns<components::Mobile>, Observes<components::Transform>>,  //
+    GroupLayout<Owns<components::VillagerNeeds, components::Villager>>>;
+
+/// Index in RegistryGroups of the layout iterating \p Components, or its size if there is none
+template <typename... Components>
+constexpr size_t k_RegistryGroupIndex = []<typename... Layouts>(std::type_identity<std::tuple<Layouts...>>) {
+	constexpr std::array<bool, sizeof...(Layouts)> k_Matching {Layouts::template k_Matches<Components...>...};
+	return static_cast<size_t>(std::find(k_Matching.begin(), k_Matching.end(), true) - k_Matching.begin());
+}(std::type_identity<RegistryGroups> {});
+} // namespace openblack::ecs
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "Relationship.h"
+
+using namespace openblack::ecs;
+
+namespace
+{
+size_t IndexOf(entt::entity entity)
+{
+	return static_cast<size_t>(entt::to_entity(entity));
+}
+} // namespace
+
+void Relationship::Link(entt::entity parent, entt::entity child)
+{
+	Unlink(child);
+
+	const auto childIndex = IndexOf(child);
+	if (childIndex >= _links.size())
+	{
+		_links.resize(childIndex + 1);
+	}
+	const auto parentIndex = IndexOf(parent);
+	if (parentIndex >= _children.size())
+	{
+		_children.resize(parentIndex + 1);
+	}
+
+	auto& children = _children[parentIndex];
+	_links[childIndex] = {parent, static_cast<uint32_t>(children.size())};
+	children.push_back(child);
+}
+
+bool Relationship::Unlink(entt::entity child)
+{
+	const auto childIndex = IndexOf(child);
+	if (childIndex >= _links.size() || _links[childIndex].parent == entt::null)
+	{
+		return false;
+	}
+
+	auto& link = _links[childIndex];
+	auto& children = _children[IndexOf(link.parent)];
+	const auto last = children.back();
+	children[link.slot] = last;
+	_links[IndexOf(last)].slot = link.slot;
+	children.pop_back();
+	link = {};
+	return true;
+}
+
+void Relationship::Clear(entt::entity parent)
+{
+	const auto parentIndex = IndexOf(parent);
+	if (parentIndex >= _children.size())
+	{
+		return;
+	}
+
+	auto& children = _children[parentIndex];
+	for (const auto child : children)
+	{
+		_links[IndexOf(child)] = {};
+	}
+	children.clear();
+}
+
+entt::entity Relationship::GetParent(entt::entity child) const
+{
+	const auto childIndex = IndexOf(child);
+	if (childIndex >= _links.size())
+	{
+		return entt::null;
+	}
+	return _links[childIndex].parent;
+}
+
+std::span<const entt::entity> Relationship::GetChildren(entt::entity parent) const
+{
+	const auto parentIndex = IndexOf(parent);
+	if (parentIndex >= _children.size())
+	{
+		return {};
+	}
+	return _children[parentIndex];
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+
+namespace openblack::ecs
+{
+
+/// One to many links between entities, such as an abode and its inhabitants or a town and its homeless villagers.
+///
+/// The children of a parent are packed together and each child knows its parent and its slot among the children, so
+/// linking and unlinking are constant time. Both sides are indexed by entity index rather than hashed or stored in a
+/// tree. Unlinking moves the last child of the parent into the freed slot, children keep their order otherwise.
+class Relationship
+{
+public:
+	/// Make \p child a child of \p parent, moving it from its previous parent if it had one
+	void Link(entt::entity parent, entt::entity child);
+	/// Returns whether \p child had a parent
+	bool Unlink(entt::entity child);
+	/// Unlink every child of \p parent
+	void Clear(entt::entity parent);
+
+	[[nodiscard]] entt::entity GetParent(entt::entity child) const;
+	[[nodiscard]] std::span<const entt::entity> GetChildren(entt::entity parent) const;
+	[[nodiscard]] uint32_t GetChildCount(entt::entity parent) const
+	{
+		return static_cast<uint32_t>(GetChildren(parent).size());
+	}
+
+private:
+	struct ParentSlot
+	{
+		entt::entity parent {entt::null};
+		/// Position of the child among the children of its parent
+		uint32_t slot {0};
+	};
+
+	/// By child entity index
+	std::vector<ParentSlot> _links;
+	/// By parent entity index
+	std::vector<std::vector<entt::entity>> _children;
+};
+
+} // namespace openblack::ecs
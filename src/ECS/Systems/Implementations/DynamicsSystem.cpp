@@ -75,6 +75,17 @@ void DynamicsSystem::AddRigidBody(btRigidBody* object)
 	_world->addRigidBody(object);
 }
 
+void DynamicsSystem::UpdateRigidBody(btRigidBody* object)
+{
+	// The shape changed under a registered body: refresh its broadphase bounds and drop cached contacts
+	_world->updateSingleAabb(object);
+	if (object->getBroadphaseHandle() != nullptr)
+	{
+		_world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(object->getBroadphaseHandle(),
+		                                                                        _world->getDispatcher());
+	}
+}
+
 void DynamicsSystem::RegisterRigidBodies()
 {
 	auto& registry = Locator::entitiesRegistry::value();
@@ -102,20 +113,24 @@ void DynamicsSystem::RegisterIslandRigidBodies(LandIslandInterface& island)
 void DynamicsSystem::UpdatePhysicsTransforms()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, const RigidBody>([&registry](Transform& transform, const RigidBody& body) {
+	// The renderer rewrites the instances of rigid bodies which moved, their transforms don't dirty the registry
+	registry.Each<Transform, const RigidBody>([&registry](entt::entity entity, Transform& transform, const RigidBody& body) {
 		btTransform trans;
 		body.motionState->getWorldTransform(trans);
 
-		transform.position.x = trans.getOrigin().getX();
-		transform.position.y = trans.getOrigin().getY();
-		transform.position.z = trans.getOrigin().getZ();
+		const auto position = glm::vec3(trans.getOrigin().getX(), trans.getOrigin().getY(), trans.getOrigin().getZ());
 
 		glm::quat quaternion(trans.getRotation().getW(), trans.getRotation().getX(), trans.getRotation().getY(),
 		                     trans.getRotation().getZ());
+		const auto rotation = glm::mat3_cast(quaternion);
 
-		transform.rotation = glm::mat3_cast(quaternion);
-
-		registry.SetDirty();
+		// Bodies at rest keep their bounds in the spatial queries
+		if (position != transform.position || rotation != transform.rotation)
+		{
+			transform.position = position;
+			transform.rotation = rotation;
+			registry.SetMoved(entity);
+		}
 	});
 }
 
@@ -44,6 +44,7 @@ class DynamicsSystem final: public DynamicsSystemInterface
 	void Reset() override;
 	void Update(std::chrono::microseconds& dt) override;
 	void AddRigidBody(btRigidBody* object) override;
+	void UpdateRigidBody(btRigidBody* object) override;
 	void RegisterRigidBodies() override;
 	void RegisterIslandRigidBodies(LandIslandInterface& island) override;
 	void UpdatePhysicsTransforms() override;
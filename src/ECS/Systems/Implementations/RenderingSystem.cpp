@@ -11,11 +11,15 @@
 
 #include "RenderingSystem.h"
 
+#include <algorithm>
+
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
+#include "ECS/Components/Hand.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
+#include "ECS/Components/RigidBody.h"
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
 #include "ECS/Components/Transform.h"
@@ -54,22 +58,23 @@ void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 		instanceCount *= 2;
 	}
 
-	// Recreate instancing uniform buffer if it is too small
-	if (_renderContext.instanceUniforms.size() < instanceCount)
+	// The render thread may still be reading the other copy, it is left untouched and the buffer grows when updated
+	auto& instanceUniforms = _renderContext.instanceUniforms.Flip();
+	if (instanceUniforms.size() < instanceCount)
 	{
-		if (bgfx::isValid(_renderContext.instanceUniformBuffer))
+		if (!bgfx::isValid(_renderContext.instanceUniformBuffer))
 		{
-			bgfx::destroy(_renderContext.instanceUniformBuffer);
+			bgfx::VertexLayout layout;
+			layout.begin()
+			    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
+			    .end();
+			_renderContext.instanceUniformBuffer =
+			    bgfx::createDynamicVertexBuffer(instanceCount, layout, BGFX_BUFFER_ALLOW_RESIZE);
 		}
-		bgfx::VertexLayout layout;
-		layout.begin()
-		    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
-		    .end();
-		_renderContext.instanceUniformBuffer = bgfx::createDynamicVertexBuffer(instanceCount, layout);
-		_renderContext.instanceUniforms.resize(instanceCount);
+		instanceUniforms.resize(instanceCount);
 	}
 
 	// Determine uniform buffer offsets and instance count for draw
@@ -89,33 +94,59 @@ void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
 
 	// Store offsets of uniforms for descs
 	std::map<entt::id_type, uint32_t> uniformOffsets;
+	auto& instanceUniforms = _renderContext.instanceUniforms.Front();
 
 	// Set transforms for instanced draw at offsets
-	registry.Each<const Mesh, const Transform>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform) {
-		    auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
-		    auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
-
-		    auto modelMatrix = glm::mat4(transform.rotation);
-		    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
-		    modelMatrix = glm::scale(modelMatrix, transform.scale);
-
-		    const uint32_t idx = desc->second.offset + offset.first->second;
-		    _renderContext.instanceUniforms[idx] = modelMatrix;
-		    if (drawBoundingBox)
-		    {
-			    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
-			    auto box = l3dMesh->GetBoundingBox();
-			    auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
-			    _renderContext.instanceUniforms[idx + _renderContext.instanceUniforms.size() / 2] = boxMatrix;
-		    }
-		    offset.first->second++;
+	auto write = [this, &instanceUniforms, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform) {
+		auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
+		auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
+
+		auto modelMatrix = glm::mat4(transform.rotation);
+		modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
+		modelMatrix = glm::scale(modelMatrix, transform.scale);
+
+		const uint32_t idx = desc->second.offset + offset.first->second;
+		instanceUniforms[idx] = modelMatrix;
+		if (drawBoundingBox)
+		{
+			auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
+			auto box = l3dMesh->GetBoundingBox();
+			auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
+			instanceUniforms[idx + instanceUniforms.size() / 2] = boxMatrix;
+		}
+		offset.first->second++;
+		return idx;
+	};
+	registry.Each<const Mesh, const Transform>(write,
+	                                           entt::exclude<TempleInteriorPart, PreviousTransform, Hand, RigidBody>);
+
+	// Entities which move without dirtying the registry come last in the instances of their mesh so that they can be
+	// rewritten together
+	auto& movingInstances = _renderContext.movingInstances;
+	registry.Each<const Mesh, const Transform, const PreviousTransform>(
+	    [&write, &movingInstances](entt::entity entity, const Mesh& mesh, const Transform& transform,
+	                               const PreviousTransform& /*unused*/) {
+		    movingInstances.push_back({entity, write(mesh, transform), 0, true});
 	    },
 	    entt::exclude<TempleInteriorPart>);
+	registry.Each<const Mesh, const Transform, const Hand>(
+	    [&write, &movingInstances](entt::entity entity, const Mesh& mesh, const Transform& transform,
+	                               const Hand& /*unused*/) {
+		    movingInstances.push_back({entity, write(mesh, transform), 0, false});
+	    },
+	    entt::exclude<TempleInteriorPart, PreviousTransform>);
+	registry.Each<const Mesh, const Transform, const RigidBody>(
+	    [&write, &movingInstances](entt::entity entity, const Mesh& mesh, const Transform& transform,
+	                               const RigidBody& /*unused*/) {
+		    movingInstances.push_back({entity, write(mesh, transform), 0, false});
+	    },
+	    entt::exclude<TempleInteriorPart, PreviousTransform, Hand>);
+	std::sort(movingInstances.begin(), movingInstances.end(),
+	          [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
 
-	if (!_renderContext.instanceUniforms.empty())
+	if (!instanceUniforms.empty())
 	{
-		const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size() * sizeof(glm::mat4));
-		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(_renderContext.instanceUniforms.data(), size));
+		const auto size = static_cast<uint32_t>(instanceUniforms.size() * sizeof(glm::mat4));
+		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(instanceUniforms.data(), size));
 	}
 }
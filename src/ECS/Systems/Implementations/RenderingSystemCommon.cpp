@@ -11,29 +11,48 @@
 
 #include "RenderingSystemCommon.h"
 
+#include <algorithm>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/norm.hpp>
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
+#include "3D/LandIslandInterface.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
+#include "ECS/Systems/SpatialQuerySystemInterface.h"
 #include "Graphics/DebugLines.h"
 #include "Graphics/ShaderManager.h"
+#include "Graphics/UploadManager.h"
 #include "Locator.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack::ecs::systems;
 using namespace openblack::ecs::components;
 
+namespace
+{
+/// Large meshes further than this from the camera cover too little of the view to be worth rasterising
+constexpr float k_OccluderRadius = 500.0f;
+constexpr size_t k_MaxOccluderMeshes = 32;
+} // namespace
+
 RenderContext::RenderContext()
     : instanceUniformBuffer(BGFX_INVALID_HANDLE)
+    , visibleInstanceUniformBuffer(BGFX_INVALID_HANDLE)
 {
 }
 RenderContext::~RenderContext()
 {
+	if (bgfx::isValid(visibleInstanceUniformBuffer))
+	{
+		bgfx::destroy(visibleInstanceUniformBuffer);
+	}
 	if (bgfx::isValid(instanceUniformBuffer))
 	{
 		bgfx::destroy(instanceUniformBuffer);
@@ -49,15 +68,19 @@ void RenderingSystemCommon::SetDirty()
 	_renderContext.dirty = true;
 }
 
-void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams)
+void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams, float turnProgress)
 {
 	auto& registry = Locator::entitiesRegistry::value();
 
-	if (_renderContext.dirty || _renderContext.hasBoundingBoxes != drawBoundingBox ||
-	    (_renderContext.footpaths != nullptr) != drawFootpaths || (_renderContext.streams != nullptr) != drawStreams)
+	const bool prepare = _renderContext.dirty || _renderContext.hasBoundingBoxes != drawBoundingBox ||
+	                     (_renderContext.footpaths != nullptr) != drawFootpaths ||
+	                     (_renderContext.streams != nullptr) != drawStreams;
+	if (prepare)
 	{
 		PrepareDrawDescs(drawBoundingBox);
+		_renderContext.movingInstances.clear();
 		PrepareDrawUploadUniforms(drawBoundingBox);
+		_renderContext.instanceUniformsInSync = false;
 
 		_renderContext.boundingBox.reset();
 		if (drawBoundingBox)
@@ -124,4 +147,221 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 		_renderContext.dirty = false;
 		_renderContext.hasBoundingBoxes = drawBoundingBox;
 	}
+
+	PrepareDrawMovingInstances(turnProgress, prepare);
+}
+
+void RenderingSystemCommon::PrepareDrawMovingInstances(float turnProgress, bool uploaded)
+{
+	auto& instances = _renderContext.movingInstances;
+	auto& movedRanges = _renderContext.movedRanges;
+	movedRanges.clear();
+	if (instances.empty())
+	{
+		return;
+	}
+
+	if (!uploaded)
+	{
+		// The copy in flight is left alone, the other one is brought up to date before the moving instances are written
+		auto& instanceUniforms = _renderContext.instanceUniforms.Flip();
+		if (!_renderContext.instanceUniformsInSync)
+		{
+			instanceUniforms = _renderContext.instanceUniforms.Back();
+			_renderContext.instanceUniformsInSync = true;
+		}
+	}
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	const auto& meshes = Locator::resources::value().GetMeshes();
+	auto& instanceUniforms = _renderContext.instanceUniforms.Front();
+	const auto boundingBoxOffset = static_cast<uint32_t>(instanceUniforms.size() / 2);
+
+	for (auto& instance : instances)
+	{
+		// Entities destroyed since the instances were prepared aren't drawn for long enough to matter
+		if (!registry.Valid(instance.entity))
+		{
+			continue;
+		}
+
+		const auto& transform = registry.Get<const Transform>(instance.entity);
+		auto position = transform.position;
+		auto rotation = transform.rotation;
+		if (instance.interpolated)
+		{
+			const auto& previous = registry.Get<const PreviousTransform>(instance.entity);
+			const bool moving = previous.position != transform.position || previous.rotation != transform.rotation;
+			if (moving)
+			{
+				instance.pendingWrites = 2;
+				position = glm::mix(previous.position, transform.position, turnProgress);
+				rotation = glm::mat3_cast(
+				    glm::slerp(glm::quat_cast(previous.rotation), glm::quat_cast(transform.rotation), turnProgress));
+			}
+			else if (instance.pendingWrites == 0)
+			{
+				continue;
+			}
+			else
+			{
+				--instance.pendingWrites;
+			}
+		}
+
+		auto modelMatrix = glm::mat4(rotation);
+		modelMatrix = glm::translate(modelMatrix, position * rotation);
+		modelMatrix = glm::scale(modelMatrix, transform.scale);
+		// The hand and rigid bodies are written where they are whenever the GPU was last given somewhere else
+		if (!instance.interpolated)
+		{
+			if (!uploaded && instance.uploaded == modelMatrix)
+			{
+				continue;
+			}
+			instance.uploaded = modelMatrix;
+		}
+		instanceUniforms[instance.index] = modelMatrix;
+		if (_renderContext.hasBoundingBoxes)
+		{
+			const auto box = meshes.Handle(registry.Get<const Mesh>(instance.entity).id)->GetBoundingBox();
+			instanceUniforms[instance.index + boundingBoxOffset] =
+			    modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
+		}
+
+		if (!movedRanges.empty() && movedRanges.back().first + movedRanges.back().second == instance.index)
+		{
+			++movedRanges.back().second;
+		}
+		else
+		{
+			movedRanges.emplace_back(instance.index, 1);
+		}
+	}
+
+	// The whole list was just uploaded by reference, it is read when the frame is submitted
+	if (uploaded)
+	{
+		movedRanges.clear();
+		return;
+	}
+	for (const auto& [first, count] : movedRanges)
+	{
+		const auto size = static_cast<uint32_t>(count * sizeof(glm::mat4));
+		bgfx::update(_renderContext.instanceUniformBuffer, first,
+		             graphics::UploadManager::Copy(&instanceUniforms[first], size));
+		if (_renderContext.hasBoundingBoxes)
+		{
+			bgfx::update(_renderContext.instanceUniformBuffer, first + boundingBoxOffset,
+			             graphics::UploadManager::Copy(&instanceUniforms[first + boundingBoxOffset], size));
+		}
+	}
+}
+
+void RenderingSystemCommon::RasterizeOccluders(const glm::vec3& cameraPosition)
+{
+	auto& culler = _renderContext.occlusionCuller;
+
+	const auto& island = Locator::terrainSystem::value();
+	if (&island != _terrainOccluderIsland || island.GetRevision() != _terrainOccluderRevision)
+	{
+		graphics::OcclusionCuller::BuildTerrainOccluder(island, _terrainOccluderVertices, _terrainOccluderIndices);
+		_terrainOccluderIsland = &island;
+		_terrainOccluderRevision = island.GetRevision();
+	}
+	culler.RasterizeTriangles(glm::mat4(1.0f), _terrainOccluderVertices, _terrainOccluderIndices);
+
+	if (!Locator::spatialQuerySystem::has_value())
+	{
+		return;
+	}
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	const auto& meshes = Locator::resources::value().GetMeshes();
+
+	_occluderEntities.clear();
+	Locator::spatialQuerySystem::value().QuerySphere(cameraPosition, k_OccluderRadius, _occluderEntities);
+	std::erase_if(_occluderEntities, [&registry, &meshes](entt::entity entity) {
+		const auto& mesh = registry.Get<const Mesh>(entity);
+		return !meshes.Contains(mesh.id) || !meshes.Handle(mesh.id)->HasOccluder();
+	});
+
+	// The nearest meshes hide the most
+	const auto count = std::min(_occluderEntities.size(), k_MaxOccluderMeshes);
+	std::partial_sort(_occluderEntities.begin(), _occluderEntities.begin() + count, _occluderEntities.end(),
+	                  [&registry, &cameraPosition](entt::entity a, entt::entity b) {
+		                  return glm::distance2(registry.Get<const Transform>(a).position, cameraPosition) <
+		                         glm::distance2(registry.Get<const Transform>(b).position, cameraPosition);
+	                  });
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& [mesh, transform] = registry.Get<const Mesh, const Transform>(_occluderEntities[i]);
+		const auto l3dMesh = meshes.Handle(mesh.id);
+
+		auto modelMatrix = glm::mat4(transform.rotation);
+		modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
+		modelMatrix = glm::scale(modelMatrix, transform.scale);
+
+		culler.RasterizeTriangles(modelMatrix, l3dMesh->GetOccluderVertices(), l3dMesh->GetOccluderIndices());
+	}
+}
+
+void RenderingSystemCommon::PrepareOcclusionCulling(bool enabled, const glm::mat4& viewProjection,
+                                                    const glm::vec3& cameraPosition)
+{
+	_renderContext.occlusionCulled = false;
+	if (!enabled)
+	{
+		return;
+	}
+
+	auto& culler = _renderContext.occlusionCuller;
+	culler.Begin(viewProjection);
+	RasterizeOccluders(cameraPosition);
+	culler.End();
+
+	// Keep the visible instances of each mesh together so they can still be drawn in one call
+	const auto& meshes = Locator::resources::value().GetMeshes();
+	const auto& instanceUniforms = _renderContext.instanceUniforms.Front();
+	auto& visibleInstanceUniforms = _renderContext.visibleInstanceUniforms.Flip();
+	visibleInstanceUniforms.clear();
+	_renderContext.visibleDrawDescs.clear();
+	for (const auto& [meshId, desc] : _renderContext.instancedDrawDescs)
+	{
+		const auto offset = static_cast<uint32_t>(visibleInstanceUniforms.size());
+		const auto box = meshes.Handle(meshId)->GetBoundingBox();
+		for (uint32_t i = desc.offset; i < desc.offset + desc.count; ++i)
+		{
+			// Meshes morphing with the terrain aren't where their transform says
+			if (desc.morphWithTerrain || culler.IsVisible(box, instanceUniforms[i]))
+			{
+				visibleInstanceUniforms.push_back(instanceUniforms[i]);
+			}
+		}
+		const auto count = static_cast<uint32_t>(visibleInstanceUniforms.size()) - offset;
+		if (count > 0)
+		{
+			_renderContext.visibleDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(meshId),
+			                                        std::forward_as_tuple(offset, count, desc.morphWithTerrain));
+		}
+	}
+
+	if (!visibleInstanceUniforms.empty())
+	{
+		if (!bgfx::isValid(_renderContext.visibleInstanceUniformBuffer))
+		{
+			bgfx::VertexLayout layout;
+			layout.begin()
+			    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
+			    .end();
+			_renderContext.visibleInstanceUniformBuffer = bgfx::createDynamicVertexBuffer(
+			    static_cast<uint32_t>(visibleInstanceUniforms.size()), layout, BGFX_BUFFER_ALLOW_RESIZE);
+		}
+		const auto size = static_cast<uint32_t>(visibleInstanceUniforms.size() * sizeof(glm::mat4));
+		bgfx::update(_renderContext.visibleInstanceUniformBuffer, 0, bgfx::makeRef(visibleInstanceUniforms.data(), size));
+	}
+	_renderContext.occlusionCulled = true;
 }
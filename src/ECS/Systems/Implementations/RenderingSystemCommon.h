@@ -23,6 +23,11 @@
 #warning "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+namespace openblack
+{
+class LandIslandInterface;
+}
+
 namespace openblack::ecs::systems
 {
 
@@ -31,13 +36,25 @@ class RenderingSystemCommon: public RenderingSystemInterface
 public:
 	~RenderingSystemCommon();
 	void SetDirty() override;
-	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) override;
+	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams, float turnProgress) override;
+	void PrepareOcclusionCulling(bool enabled, const glm::mat4& viewProjection, const glm::vec3& cameraPosition) override;
 	const RenderContext& GetContext() override { return _renderContext; }
 
 private:
 	virtual void PrepareDrawDescs(bool drawBoundingBox) = 0;
 	virtual void PrepareDrawUploadUniforms(bool drawBoundingBox) = 0;
 
+	/// Write the instances of the entities which moved, only those are uploaded unless the whole list just was
+	void PrepareDrawMovingInstances(float turnProgress, bool uploaded);
+	void RasterizeOccluders(const glm::vec3& cameraPosition);
+
+	/// The terrain occluder is only rebuilt when the island is edited or replaced
+	std::vector<glm::vec3> _terrainOccluderVertices;
+	std::vector<uint32_t> _terrainOccluderIndices;
+	const LandIslandInterface* _terrainOccluderIsland {nullptr};
+	uint32_t _terrainOccluderRevision {0};
+	std::vector<entt::entity> _occluderEntities;
+
 protected:
 	RenderContext _renderContext;
 };
@@ -73,22 +73,23 @@ void RenderingSystemTemple::PrepareDrawDescs(bool drawBoundingBox)
 		instanceCount *= 2;
 	}
 
-	// Recreate instancing uniform buffer if it is too small
-	if (_renderContext.instanceUniforms.size() < instanceCount)
+	// The render thread may still be reading the other copy, it is left untouched and the buffer grows when updated
+	auto& instanceUniforms = _renderContext.instanceUniforms.Flip();
+	if (instanceUniforms.size() < instanceCount)
 	{
-		if (bgfx::isValid(_renderContext.instanceUniformBuffer))
+		if (!bgfx::isValid(_renderContext.instanceUniformBuffer))
 		{
-			bgfx::destroy(_renderContext.instanceUniformBuffer);
+			bgfx::VertexLayout layout;
+			layout.begin()
+			    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
+			    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
+			    .end();
+			_renderContext.instanceUniformBuffer =
+			    bgfx::createDynamicVertexBuffer(instanceCount, layout, BGFX_BUFFER_ALLOW_RESIZE);
 		}
-		bgfx::VertexLayout layout;
-		layout.begin()
-		    .add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
-		    .add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
-		    .end();
-		_renderContext.instanceUniformBuffer = bgfx::createDynamicVertexBuffer(instanceCount, layout);
-		_renderContext.instanceUniforms.resize(instanceCount);
+		instanceUniforms.resize(instanceCount);
 	}
 
 	// Determine uniform buffer offsets and instance count for draw
@@ -108,11 +109,12 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 
 	// Store offsets of uniforms for descs
 	std::map<entt::id_type, uint32_t> uniformOffsets;
+	auto& instanceUniforms = _renderContext.instanceUniforms.Front();
 
 	// Set transforms for instanced draw at offsets
 	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
-	                                             const TempleInteriorPart& templePart) {
+	    [this, &instanceUniforms, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
+	                                                                const TempleInteriorPart& templePart) {
 		    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
 
 		    if (_loadedRooms.contains(templePart.room))
@@ -125,20 +127,20 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 			    modelMatrix = glm::scale(modelMatrix, transform.scale);
 
 			    const uint32_t idx = desc->second.offset + offset.first->second;
-			    _renderContext.instanceUniforms[idx] = modelMatrix;
+			    instanceUniforms[idx] = modelMatrix;
 			    if (drawBoundingBox)
 			    {
 				    auto box = l3dMesh->GetBoundingBox();
 				    auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
-				    _renderContext.instanceUniforms[idx + _renderContext.instanceUniforms.size() / 2] = boxMatrix;
+				    instanceUniforms[idx + instanceUniforms.size() / 2] = boxMatrix;
 			    }
 			    offset.first->second++;
 		    }
 	    });
 
-	if (!_renderContext.instanceUniforms.empty())
+	if (!instanceUniforms.empty())
 	{
-		const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size() * sizeof(glm::mat4));
-		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(_renderContext.instanceUniforms.data(), size));
+		const auto size = static_cast<uint32_t>(instanceUniforms.size() * sizeof(glm::mat4));
+		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(instanceUniforms.data(), size));
 	}
 }
@@ -32,6 +32,9 @@ class RenderingSystemTemple final: public RenderingSystemCommon
 public:
 	~RenderingSystemTemple();
 
+	/// Nothing on the island can hide what is inside of the temple, every instance is drawn
+	void PrepareOcclusionCulling(bool, const glm::mat4&, const glm::vec3&) override {}
+
 private:
 	void PrepareDrawDescs(bool drawBoundingBox) override;
 	void PrepareDrawUploadUniforms(bool drawBoundingBox) override;
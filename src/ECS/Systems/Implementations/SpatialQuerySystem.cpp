@@ -0,0 +1,289 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#define LOCATOR_IMPLEMENTATIONS
+
+#include "SpatialQuerySystem.h"
+
+#include <glm/gtc/matrix_access.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include "3D/L3DMesh.h"
+#include "ECS/Components/Mesh.h"
+#include "ECS/Components/Temple.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Registry.h"
+#include "Locator.h"
+#include "Resources/ResourcesInterface.h"
+
+using namespace openblack;
+using namespace openblack::ecs::systems;
+using namespace openblack::ecs::components;
+
+namespace
+{
+// Entities rarely move by more than this between two frames, leaving room avoids reinserting walkers every frame
+constexpr float k_FatMargin = 2.0f;
+
+glm::mat4 ModelMatrix(const Transform& transform)
+{
+	// Matches the model matrix of the rendering system
+	auto modelMatrix = glm::mat4(transform.rotation);
+	modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
+	modelMatrix = glm::scale(modelMatrix, transform.scale);
+	return modelMatrix;
+}
+
+AxisAlignedBoundingBox TransformBox(const glm::mat4& matrix, const AxisAlignedBoundingBox& box)
+{
+	const auto center = glm::vec3(matrix * glm::vec4(box.Center(), 1.0f));
+	const auto halfSize = box.Size() * 0.5f;
+	const auto absolute = glm::mat3(glm::abs(matrix[0]), glm::abs(matrix[1]), glm::abs(matrix[2]));
+	const auto extent = absolute * halfSize;
+	return {center - extent, center + extent};
+}
+
+bool SphereOverlaps(const AxisAlignedBoundingBox& box, const glm::vec3& center, float radius)
+{
+	const auto closest = glm::clamp(center, box.minima, box.maxima);
+	const auto offset = closest - center;
+	return glm::dot(offset, offset) <= radius * radius;
+}
+
+std::array<glm::vec4, 6> FrustumPlanes(const glm::mat4& viewProjection)
+{
+	const auto row0 = glm::row(viewProjection, 0);
+	const auto row1 = glm::row(viewProjection, 1);
+	const auto row2 = glm::row(viewProjection, 2);
+	const auto row3 = glm::row(viewProjection, 3);
+	// The near plane assumes a [-1, 1] depth range which is conservative for [0, 1] renderers
+	return {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+}
+} // namespace
+
+SpatialQuerySystem::SpatialQuerySystem()
+    : _tree(k_FatMargin)
+{
+}
+
+SpatialQuerySystem::~SpatialQuerySystem() = default;
+
+void SpatialQuerySystem::Update()
+{
+	if (_dirty)
+	{
+		Rebuild();
+		_dirty = false;
+	}
+
+	auto& registry = Locator::entitiesRegistry::value();
+	for (const auto entity : _moved)
+	{
+		const auto index = static_cast<uint32_t>(entt::to_entity(entity));
+		auto& entry = _entries[index];
+		entry.moved = false;
+		// Removed by the rebuild, or its slot was taken by another entity since
+		if (entry.entity != entity || entry.proxy == DynamicAabbTree::k_NullNode)
+		{
+			continue;
+		}
+		Fit(entry, registry.Get<const Transform>(entity), index);
+	}
+	_moved.clear();
+}
+
+void SpatialQuerySystem::SetDirty()
+{
+	_dirty = true;
+}
+
+void SpatialQuerySystem::SetMoved(entt::entity entity)
+{
+	// Entities which aren't in the tree yet are fitted when they are inserted
+	const auto index = static_cast<size_t>(entt::to_entity(entity));
+	if (index >= _entries.size() || _entries[index].entity != entity || _entries[index].moved)
+	{
+		return;
+	}
+	_entries[index].moved = true;
+	_moved.push_back(entity);
+}
+
+void SpatialQuerySystem::Rebuild()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& meshes = Locator::resources::value().GetMeshes();
+
+	++_updateStamp;
+	size_t seen = 0;
+	registry.Each<const Mesh, const Transform>(
+	    [this, &meshes, &seen](entt::entity entity, const Mesh& mesh, const Transform& transform) {
+		    const auto index = static_cast<uint32_t>(entt::to_entity(entity));
+		    if (index >= _entries.size())
+		    {
+			    _entries.resize(index + 1);
+		    }
+		    auto& entry = _entries[index];
+
+		    // Entities already in the tree are refitted when they move, not when others are created
+		    if (entry.proxy != DynamicAabbTree::k_NullNode && entry.entity == entity && entry.meshId == mesh.id)
+		    {
+			    entry.lastSeen = _updateStamp;
+			    ++seen;
+			    return;
+		    }
+		    if (!meshes.Contains(mesh.id))
+		    {
+			    return;
+		    }
+		    entry.entity = entity;
+		    entry.meshId = mesh.id;
+		    entry.localBox = meshes.Handle(mesh.id)->GetBoundingBox();
+		    entry.lastSeen = _updateStamp;
+		    ++seen;
+		    Fit(entry, transform, index);
+	    },
+	    entt::exclude<TempleInteriorPart>);
+
+	// Entities were destroyed or lost their components, find which by their stamp
+	if (seen != _tree.GetProxyCount())
+	{
+		for (auto& entry : _entries)
+		{
+			if (entry.proxy != DynamicAabbTree::k_NullNode && entry.lastSeen != _updateStamp)
+			{
+				_tree.DestroyProxy(entry.proxy);
+				entry = {};
+			}
+		}
+	}
+}
+
+void SpatialQuerySystem::Fit(Entry& entry, const Transform& transform, uint32_t index)
+{
+	const auto modelMatrix = ModelMatrix(transform);
+	entry.worldBox = TransformBox(modelMatrix, entry.localBox);
+	entry.worldToLocal = glm::inverse(modelMatrix);
+
+	if (entry.proxy == DynamicAabbTree::k_NullNode)
+	{
+		entry.proxy = _tree.CreateProxy(entry.worldBox, index);
+	}
+	else
+	{
+		_tree.MoveProxy(entry.proxy, entry.worldBox);
+	}
+}
+
+std::optional<SpatialQueryHit> SpatialQuerySystem::RayCastClosestHit(const SpatialQueryRay& ray, entt::entity ignore,
+                                                                     std::vector<int32_t>& stack) const
+{
+	std::optional<SpatialQueryHit> result;
+	_tree.RayCast(
+	    ray.origin, ray.direction, ray.tMax,
+	    [this, &ray, &result, ignore](int32_t proxy, float tMax) {
+		    const auto& entry = GetEntry(proxy);
+		    if (entry.entity == ignore)
+		    {
+			    return tMax;
+		    }
+		    // The model matrix is affine so distances along the ray are the same in local space
+		    const auto localOrigin = glm::vec3(entry.worldToLocal * glm::vec4(ray.origin, 1.0f));
+		    const auto localDirection = glm::vec3(entry.worldToLocal * glm::vec4(ray.direction, 0.0f));
+		    float distance;
+		    if (!DynamicAabbTree::RayIntersects(entry.localBox, localOrigin, 1.0f / localDirection, tMax, distance))
+		    {
+			    return tMax;
+		    }
+		    result = SpatialQueryHit {entry.entity, distance};
+		    return distance;
+	    },
+	    stack);
+	return result;
+}
+
+std::optional<SpatialQueryHit> SpatialQuerySystem::RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction,
+                                                                     float tMax, entt::entity ignore) const
+{
+	std::vector<int32_t> stack;
+	return RayCastClosestHit(SpatialQueryRay {origin, direction, tMax}, ignore, stack);
+}
+
+void SpatialQuerySystem::QueryBox(const AxisAlignedBoundingBox& box, std::vector<entt::entity>& entities,
+                                  std::vector<int32_t>& stack) const
+{
+	_tree.Query([&box](const AxisAlignedBoundingBox& nodeBox) { return DynamicAabbTree::Overlaps(nodeBox, box); },
+	            [this, &box, &entities](int32_t proxy) {
+		            const auto& entry = GetEntry(proxy);
+		            if (DynamicAabbTree::Overlaps(entry.worldBox, box))
+		            {
+			            entities.push_back(entry.entity);
+		            }
+		            return true;
+	            },
+	            stack);
+}
+
+void SpatialQuerySystem::QueryBox(const AxisAlignedBoundingBox& box, std::vector<entt::entity>& entities) const
+{
+	std::vector<int32_t> stack;
+	QueryBox(box, entities, stack);
+}
+
+void SpatialQuerySystem::QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& entities) const
+{
+	_tree.Query([&center, radius](const AxisAlignedBoundingBox& nodeBox) { return SphereOverlaps(nodeBox, center, radius); },
+	            [this, &center, radius, &entities](int32_t proxy) {
+		            const auto& entry = GetEntry(proxy);
+		            if (SphereOverlaps(entry.worldBox, center, radius))
+		            {
+			            entities.push_back(entry.entity);
+		            }
+		            return true;
+	            });
+}
+
+void SpatialQuerySystem::QueryFrustum(const glm::mat4& viewProjection, std::vector<entt::entity>& entities) const
+{
+	const auto planes = FrustumPlanes(viewProjection);
+	_tree.Query([&planes](const AxisAlignedBoundingBox& nodeBox) { return DynamicAabbTree::InFrontOfPlanes(nodeBox, planes); },
+	            [this, &planes, &entities](int32_t proxy) {
+		            const auto& entry = GetEntry(proxy);
+		            if (DynamicAabbTree::InFrontOfPlanes(entry.worldBox, planes))
+		            {
+			            entities.push_back(entry.entity);
+		            }
+		            return true;
+	            });
+}
+
+void SpatialQuerySystem::RayCastClosestHits(const std::vector<SpatialQueryRay>& rays,
+                                            std::vector<std::optional<SpatialQueryHit>>& hits) const
+{
+	std::vector<int32_t> stack;
+	stack.reserve(64);
+	hits.resize(rays.size());
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		hits[i] = RayCastClosestHit(rays[i], entt::null, stack);
+	}
+}
+
+void SpatialQuerySystem::QueryBoxes(const std::vector<AxisAlignedBoundingBox>& boxes, std::vector<entt::entity>& entities,
+                                    std::vector<uint32_t>& offsets) const
+{
+	std::vector<int32_t> stack;
+	stack.reserve(64);
+	offsets.resize(boxes.size());
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		offsets[i] = static_cast<uint32_t>(entities.size());
+		QueryBox(boxes[i], entities, stack);
+	}
+}
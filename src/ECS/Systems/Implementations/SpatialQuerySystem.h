@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "3D/DynamicAabbTree.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Systems/SpatialQuerySystemInterface.h"
+
+#if !defined(LOCATOR_IMPLEMENTATIONS)
+#warning "Locator interface implementations should only be included in Locator.cpp, use interface instead."
+#endif
+
+namespace openblack::ecs::systems
+{
+
+class SpatialQuerySystem final: public SpatialQuerySystemInterface
+{
+public:
+	SpatialQuerySystem();
+	~SpatialQuerySystem() override;
+
+	void Update() override;
+	void SetDirty() override;
+	void SetMoved(entt::entity entity) override;
+
+	[[nodiscard]] std::optional<SpatialQueryHit> RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction,
+	                                                               float tMax, entt::entity ignore) const override;
+	void QueryBox(const AxisAlignedBoundingBox& box, std::vector<entt::entity>& entities) const override;
+	void QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& entities) const override;
+	void QueryFrustum(const glm::mat4& viewProjection, std::vector<entt::entity>& entities) const override;
+
+	void RayCastClosestHits(const std::vector<SpatialQueryRay>& rays,
+	                        std::vector<std::optional<SpatialQueryHit>>& hits) const override;
+	void QueryBoxes(const std::vector<AxisAlignedBoundingBox>& boxes, std::vector<entt::entity>& entities,
+	                std::vector<uint32_t>& offsets) const override;
+
+private:
+	/// Indexed by entity index so that lookups during the update don't hash
+	struct Entry
+	{
+		entt::entity entity {entt::null};
+		int32_t proxy {DynamicAabbTree::k_NullNode};
+		uint32_t lastSeen {0};
+		entt::id_type meshId {0};
+		/// Already in the moved list
+		bool moved {false};
+		AxisAlignedBoundingBox localBox;
+		AxisAlignedBoundingBox worldBox;
+		/// Inverse model matrix, moves rays into the space of localBox
+		glm::mat4 worldToLocal;
+	};
+
+	[[nodiscard]] std::optional<SpatialQueryHit> RayCastClosestHit(const SpatialQueryRay& ray, entt::entity ignore,
+	                                                               std::vector<int32_t>& stack) const;
+	void QueryBox(const AxisAlignedBoundingBox& box, std::vector<entt::entity>& entities,
+	              std::vector<int32_t>& stack) const;
+	/// Insert new entities and those which changed mesh, remove those which were destroyed or lost their components
+	void Rebuild();
+	void Fit(Entry& entry, const ecs::components::Transform& transform, uint32_t index);
+	[[nodiscard]] const Entry& GetEntry(int32_t proxy) const { return _entries[_tree.GetUserData(proxy)]; }
+
+	DynamicAabbTree _tree;
+	std::vector<Entry> _entries;
+	uint32_t _updateStamp {0};
+	bool _dirty {true};
+	std::vector<entt::entity> _moved;
+};
+} // namespace openblack::ecs::systems
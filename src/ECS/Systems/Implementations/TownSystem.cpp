@@ -12,6 +12,8 @@
 #include "TownSystem.h"
 
 #include "ECS/Components/Abode.h"
+#include "ECS/Components/Pot.h"
+#include "ECS/Components/StoragePit.h"
 #include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/Villager.h"
@@ -19,23 +21,55 @@
 #include "Game.h"
 #include "Locator.h"
 
+using namespace openblack::ecs;
 using namespace openblack::ecs::components;
 using namespace openblack::ecs::systems;
 
+namespace
+{
+entt::entity FindTown(entt::registry& registry, uint32_t townId)
+{
+	const auto& towns = registry.ctx().get<RegistryContext>().towns;
+	const auto town = towns.find(townId);
+	return town != towns.end() ? town->second : entt::null;
+}
+} // namespace
+
+TownSystem::TownSystem()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	_connections.emplace_back(registry.OnConstruct<Abode>().connect<&TownSystem::OnAbodeChanged>(*this));
+	_connections.emplace_back(registry.OnUpdate<Abode>().connect<&TownSystem::OnAbodeChanged>(*this));
+	_connections.emplace_back(registry.OnDestroy<Abode>().connect<&TownSystem::OnContributorDestroyed>(*this));
+	_connections.emplace_back(registry.OnConstruct<Villager>().connect<&TownSystem::OnVillagerChanged>(*this));
+	_connections.emplace_back(registry.OnUpdate<Villager>().connect<&TownSystem::OnVillagerChanged>(*this));
+	_connections.emplace_back(registry.OnDestroy<Villager>().connect<&TownSystem::OnContributorDestroyed>(*this));
+	_connections.emplace_back(registry.OnUpdate<Pot>().connect<&TownSystem::OnPileChanged>(*this));
+	_connections.emplace_back(registry.OnDestroy<Pot>().connect<&TownSystem::OnContributorDestroyed>(*this));
+	_connections.emplace_back(registry.OnConstruct<StoragePit>().connect<&TownSystem::OnStoragePitConstructed>(*this));
+	_connections.emplace_back(registry.OnDestroy<StoragePit>().connect<&TownSystem::OnStoragePitDestroyed>(*this));
+}
+
 entt::entity TownSystem::FindAbodeWithSpace(entt::entity townEntity) const
 {
+	if (_economy.GetFreeHousing(townEntity) == 0)
+	{
+		return entt::null;
+	}
+
 	const auto& infoConstants = Game::Instance()->GetInfoConstants();
 	auto& registry = Locator::entitiesRegistry::value();
 	const auto& town = registry.Get<Town>(townEntity);
+	const auto& inhabitants = registry.Context().abodeInhabitants;
 
 	entt::entity result = entt::null;
-	registry.Each<const Abode>([&town, &infoConstants, &result](entt::entity entity, auto component) {
+	registry.Each<const Abode>([&town, &inhabitants, &infoConstants, &result](entt::entity entity, const Abode& component) {
 		if (result != entt::null || component.townId != town.id)
 		{
 			return;
 		}
 		const auto& info = infoConstants.abode.at(static_cast<size_t>(component.type));
-		if (static_cast<uint32_t>(component.inhabitants.size()) < info.maxVillagersInAbode)
+		if (inhabitants.GetChildCount(entity) < info.maxVillagersInAbode)
 		{
 			result = entity;
 		}
@@ -69,11 +103,115 @@ void TownSystem::AddHomelessVillagerToTown(entt::entity townEntity, entt::entity
 	[[maybe_unused]] auto& registry = Locator::entitiesRegistry::value();
 	[[maybe_unused]] auto& registryContext = registry.Context();
 
-	auto& town = registry.Get<Town>(townEntity);
-	auto& villager = registry.Get<Villager>(villagerEntity);
-	// TODO(bwrsandman): if already assigned to abode or other villager homeless list, remove
+	[[maybe_unused]] const auto& town = registry.Get<const Town>(townEntity);
+	[[maybe_unused]] const auto& villager = registry.Get<const Villager>(villagerEntity);
+	// TODO(bwrsandman): if already assigned to abode, remove
 	assert(villager.abode == entt::null);
 	assert(villager.town == entt::null || villager.town == registryContext.towns[town.id]);
-	town.homelessVillagers.insert(villagerEntity);
-	villager.town = townEntity;
+	// Linking moves the villager out of another town's homeless list
+	registryContext.homelessVillagers.Link(townEntity, villagerEntity);
+	registry.Patch<Villager>(villagerEntity, [townEntity](auto& v) { v.town = townEntity; });
+}
+
+void TownSystem::AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& registryContext = registry.Context();
+
+	registryContext.homelessVillagers.Unlink(villagerEntity);
+	registryContext.abodeInhabitants.Link(abodeEntity, villagerEntity);
+	registry.Patch<Villager>(villagerEntity, [abodeEntity](auto& v) { v.abode = abodeEntity; });
+}
+
+void TownSystem::AddTown(entt::entity townEntity)
+{
+	auto& town = Locator::entitiesRegistry::value().Get<Town>(townEntity);
+	town.beliefIndex = _beliefs.AddTown();
+}
+
+void TownSystem::Reset()
+{
+	_beliefs.Clear();
+	_economy.Clear();
+}
+
+void TownSystem::SetBelief(entt::entity townEntity, PlayerNames player, float belief)
+{
+	const auto& town = Locator::entitiesRegistry::value().Get<const Town>(townEntity);
+	_beliefs.Set(town.beliefIndex, player, belief);
+}
+
+float TownSystem::GetBelief(entt::entity townEntity, PlayerNames player) const
+{
+	const auto& town = Locator::entitiesRegistry::value().Get<const Town>(townEntity);
+	return _beliefs.Get(town.beliefIndex, player);
+}
+
+void TownSystem::AccumulateBeliefs(std::span<const float> influence, float scale)
+{
+	_beliefs.Accumulate(influence, scale);
+}
+
+void TownSystem::OnAbodeChanged(entt::registry& registry, entt::entity entity)
+{
+	const auto& abode = registry.get<const Abode>(entity);
+	const auto town = FindTown(registry, abode.townId);
+	if (town == entt::null)
+	{
+		_economy.Remove(entity);
+		return;
+	}
+
+	const auto& info = Game::Instance()->GetInfoConstants().abode.at(static_cast<size_t>(abode.type));
+	// The food and wood of storage pits are counted in their piles
+	const bool isStoragePit = info.abodeType == AbodeType::StoragePit;
+	_economy.Set(entity, town,
+	             {isStoragePit ? 0 : abode.foodAmount, isStoragePit ? 0 : abode.woodAmount, 0, 0, info.maxVillagersInAbode, 0});
+}
+
+void TownSystem::OnVillagerChanged(entt::registry& registry, entt::entity entity)
+{
+	const auto& villager = registry.get<const Villager>(entity);
+	if (villager.town == entt::null)
+	{
+		_economy.Remove(entity);
+		return;
+	}
+
+	const uint32_t homeless = villager.abode == entt::null ? 1 : 0;
+	_economy.Set(entity, villager.town, {0, 0, 1, homeless, 0, 1 - homeless});
+}
+
+void TownSystem::OnPileChanged(entt::registry& registry, entt::entity entity)
+{
+	const auto pit = registry.ctx().get<RegistryContext>().storagePiles.GetParent(entity);
+	const auto town = pit != entt::null ? FindTown(registry, registry.get<const Abode>(pit).townId) : entt::null;
+	if (town == entt::null)
+	{
+		_economy.Remove(entity);
+		return;
+	}
+
+	const auto& pot = registry.get<const Pot>(entity);
+	const bool isFood = registry.get<const StoragePit>(pit).foodPile == entity;
+	_economy.Set(entity, town, {isFood ? pot.amount : 0u, isFood ? 0u : pot.amount, 0, 0, 0, 0}, pit);
+}
+
+void TownSystem::OnStoragePitConstructed(entt::registry& registry, entt::entity entity)
+{
+	const auto town = FindTown(registry, registry.get<const Abode>(entity).townId);
+	if (town != entt::null)
+	{
+		_economy.AddStorage(entity, town, registry.get<const Transform>(entity).position);
+	}
+}
+
+void TownSystem::OnStoragePitDestroyed([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	_economy.RemoveStorage(entity);
+}
+
+void TownSystem::OnContributorDestroyed([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	_economy.Remove(entity);
 }
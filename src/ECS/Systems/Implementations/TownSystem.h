@@ -9,7 +9,14 @@
 
 #pragma once
 
+#include <vector>
+
+#include <entt/entity/fwd.hpp>
+#include <entt/signal/sigh.hpp>
+
 #include "ECS/Systems/TownSystemInterface.h"
+#include "ECS/TownBeliefs.h"
+#include "ECS/TownEconomy.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
 #warning "Locator interface implementations should only be included in Locator.cpp, use interface instead."
@@ -21,8 +28,32 @@ namespace openblack::ecs::systems
 class TownSystem final: public TownSystemInterface
 {
 public:
+	TownSystem();
+
 	[[nodiscard]] entt::entity FindAbodeWithSpace(entt::entity townEntity) const override;
 	[[nodiscard]] entt::entity FindClosestTown(const glm::vec3& point) const override;
 	void AddHomelessVillagerToTown(entt::entity townEntity, entt::entity villagerEntity) override;
+	void AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity) override;
+
+	void AddTown(entt::entity townEntity) override;
+	void Reset() override;
+	void SetBelief(entt::entity townEntity, PlayerNames player, float belief) override;
+	[[nodiscard]] float GetBelief(entt::entity townEntity, PlayerNames player) const override;
+	void AccumulateBeliefs(std::span<const float> influence, float scale) override;
+	[[nodiscard]] const TownBeliefs& GetBeliefs() const override { return _beliefs; }
+	[[nodiscard]] const TownEconomy& GetEconomy() const override { return _economy; }
+
+private:
+	void OnAbodeChanged(entt::registry& registry, entt::entity entity);
+	void OnVillagerChanged(entt::registry& registry, entt::entity entity);
+	void OnPileChanged(entt::registry& registry, entt::entity entity);
+	void OnStoragePitConstructed(entt::registry& registry, entt::entity entity);
+	void OnStoragePitDestroyed(entt::registry& registry, entt::entity entity);
+	void OnContributorDestroyed(entt::registry& registry, entt::entity entity);
+
+	TownBeliefs _beliefs;
+	TownEconomy _economy;
+	/// Disconnected from the registry's signals when the system goes away
+	std::vector<entt::scoped_connection> _connections;
 };
 } // namespace openblack::ecs::systems
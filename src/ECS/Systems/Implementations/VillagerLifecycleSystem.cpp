@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#define LOCATOR_IMPLEMENTATIONS
+
+#include "VillagerLifecycleSystem.h"
+
+#include <algorithm>
+
+#include "ECS/Components/Villager.h"
+#include "ECS/Registry.h"
+#include "Game.h"
+#include "Locator.h"
+
+using namespace openblack::ecs::components;
+using namespace openblack::ecs::systems;
+
+VillagerLifecycleSystem::VillagerLifecycleSystem()
+{
+	const auto& infoConstants = Game::Instance()->GetInfoConstants();
+	std::transform(infoConstants.villager.cbegin(), infoConstants.villager.cend(), _rates.begin(), [](const auto& info) {
+		return VillagerLifecycle::Rates {info.gameTurnReducesFoodInBellyBy,
+		                                 info.hungryForFood,
+		                                 info.starvingForFood,
+		                                 info.hungerToLifeMultiplier,
+		                                 info.starvingToLifeMultiplier,
+		                                 info.grownUpAge};
+	});
+}
+
+void VillagerLifecycleSystem::Update()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	_events.clear();
+	const bool newYear = ++_turnsThisYear >= _turnsPerYear;
+	if (newYear)
+	{
+		_turnsThisYear = 0;
+	}
+
+	// The group keeps the needs and villagers packed in the same order, the needs are streamed every turn while the
+	// villagers are only touched once a year
+	registry.Group<VillagerNeeds, Villager>().each([this, newYear](entt::entity entity, VillagerNeeds& needs,
+	                                                                Villager& villager) {
+		const auto& rates = _rates[static_cast<size_t>(needs.type)];
+		if (const auto event = VillagerLifecycle::AdvanceTurn(needs, rates))
+		{
+			_events.push_back({entity, *event});
+		}
+		if (newYear)
+		{
+			if (const auto event = VillagerLifecycle::AdvanceYear(needs, villager.lifeStage, rates))
+			{
+				_events.push_back({entity, *event});
+			}
+		}
+	});
+
+	// Destroyed once the group is no longer iterated, all at once as a famine can kill a whole town in a turn
+	_dead.clear();
+	for (const auto& event : _events)
+	{
+		if (event.type == VillagerLifecycle::Event::Died)
+		{
+			_dead.push_back(event.villager);
+		}
+	}
+	if (!_dead.empty())
+	{
+		registry.Destroy(_dead.begin(), _dead.end());
+	}
+}
+
+void VillagerLifecycleSystem::SetTurnsPerYear(uint32_t turnsPerYear)
+{
+	_turnsPerYear = std::max(turnsPerYear, 1u);
+	_turnsThisYear = std::min(_turnsThisYear, _turnsPerYear - 1);
+}
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include "ECS/Systems/VillagerLifecycleSystemInterface.h"
+#include "Enums.h"
+
+#if !defined(LOCATOR_IMPLEMENTATIONS)
+#warning "Locator interface implementations should only be included in Locator.cpp, use interface instead."
+#endif
+
+namespace openblack::ecs::systems
+{
+
+class VillagerLifecycleSystem final: public VillagerLifecycleSystemInterface
+{
+public:
+	/// Until a level script sets it
+	static constexpr uint32_t k_DefaultTurnsPerYear = 3000;
+
+	VillagerLifecycleSystem();
+
+	void Update() override;
+	[[nodiscard]] const std::vector<Event>& GetEvents() const override { return _events; }
+	void SetTurnsPerYear(uint32_t turnsPerYear) override;
+
+private:
+	std::array<VillagerLifecycle::Rates, static_cast<size_t>(VillagerInfo::_COUNT)> _rates;
+	std::vector<Event> _events;
+	/// Kept between turns so that deaths don't allocate
+	std::vector<entt::entity> _dead;
+	uint32_t _turnsPerYear {k_DefaultTurnsPerYear};
+	uint32_t _turnsThisYear {0};
+};
+} // namespace openblack::ecs::systems
@@ -9,11 +9,16 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <bgfx/bgfx.h>
 #include <entt/entt.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "Graphics/DoubleBuffered.h"
 #include "Graphics/Mesh.h"
+#include "Graphics/OcclusionCuller.h"
 
 namespace openblack::ecs::systems
 {
@@ -44,9 +49,33 @@ struct RenderContext
 	/// but in practice, it should only grow its reserved memory.
 	/// If debug bounding boxes are enabled, it will double in size to fit all
 	/// bounding boxes in the second half of the list.
-	std::vector<glm::mat4> instanceUniforms;
+	/// It is uploaded by reference, the copy of the frame being rendered is left alone while the next one is filled.
+	graphics::DoubleBuffered<std::vector<glm::mat4>> instanceUniforms;
 	/// Stores information for rendering which is prepared at \ref PrepareDraw.
 	std::map<entt::id_type, const InstancedDrawDesc> instancedDrawDescs;
+
+	struct MovingInstance
+	{
+		entt::entity entity;
+		/// Index of the instance in \ref instanceUniforms
+		uint32_t index;
+		/// Frames left writing where a turn-driven entity stopped, once into each copy of \ref instanceUniforms
+		uint8_t pendingWrites;
+		/// Drawn between its previous and current transform by the progress of the turn, otherwise where it is
+		bool interpolated;
+		/// Model matrix the GPU was last given for an instance which isn't interpolated. Both copies of
+		/// \ref instanceUniforms upload into the same buffer, so neither copy tells what the GPU holds.
+		glm::mat4 uploaded {0.0f};
+	};
+	/// Instances of the entities which can move between two dirtying changes, by index: those moved by the turns, the
+	/// hand and rigid bodies. They are rewritten at every \ref PrepareDraw when they moved, the other instances only
+	/// when dirty.
+	std::vector<MovingInstance> movingInstances;
+	/// Both copies of \ref instanceUniforms only differ by their \ref movingInstances
+	bool instanceUniformsInSync {false};
+	/// Ranges of \ref instanceUniforms updated on their own by the last \ref PrepareDraw, as first index and count.
+	/// Empty when the whole list was uploaded.
+	std::vector<std::pair<uint32_t, uint32_t>> movedRanges;
 	/// Not an actual vertex buffer, but a dynamic general purpose buffer which
 	/// stores uniform data as a GPU-side copy of \ref _instanceUniforms and
 	/// which is populated in \ref PrepareDraw and consumed in \ref DrawModels.
@@ -56,15 +85,28 @@ struct RenderContext
 	/// the instances of entities and their bounding boxes.
 	bgfx::DynamicVertexBufferHandle instanceUniformBuffer;
 
+	/// Instances of \ref instanceUniforms which are not hidden from the main view, refilled at every
+	/// \ref PrepareOcclusionCulling and consumed instead of the full list by the main pass.
+	graphics::DoubleBuffered<std::vector<glm::mat4>> visibleInstanceUniforms;
+	std::map<entt::id_type, const InstancedDrawDesc> visibleDrawDescs;
+	/// GPU-side copy of \ref visibleInstanceUniforms
+	bgfx::DynamicVertexBufferHandle visibleInstanceUniformBuffer;
+	graphics::OcclusionCuller occlusionCuller;
+
 	bool dirty {true};
 	bool hasBoundingBoxes {false};
+	/// The main pass should draw \ref visibleDrawDescs
+	bool occlusionCulled {false};
 };
 
 class RenderingSystemInterface
 {
 public:
 	virtual void SetDirty() = 0;
-	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) = 0;
+	/// \p turnProgress is how far into the next turn the frame is, from 0 to 1
+	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams, float turnProgress) = 0;
+	/// Rasterise the terrain and nearby large meshes seen from \p viewProjection and keep the instances they don't hide
+	virtual void PrepareOcclusionCulling(bool enabled, const glm::mat4& viewProjection, const glm::vec3& cameraPosition) = 0;
 	virtual const RenderContext& GetContext() = 0;
 	inline ~RenderingSystemInterface() = default;
 };
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <optional>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+
+namespace openblack::ecs::systems
+{
+struct SpatialQueryRay
+{
+	glm::vec3 origin;
+	glm::vec3 direction;
+	float tMax;
+};
+
+struct SpatialQueryHit
+{
+	entt::entity entity;
+	/// In units of the ray direction
+	float distance;
+};
+
+/// Ray, frustum, sphere and box queries over the world bounding boxes of entities with a Mesh and a Transform.
+/// Results are tested against the exact world box of each entity, ray hits against its oriented mesh box.
+class SpatialQuerySystemInterface
+{
+public:
+	/// Insert and remove entities if the registry changed, then refit the entities which moved since the last update
+	virtual void Update() = 0;
+	/// Entities gained or lost components, look for them on the next update
+	virtual void SetDirty() = 0;
+	/// The transform of \p entity changed, refit it on the next update
+	virtual void SetMoved(entt::entity entity) = 0;
+
+	[[nodiscard]] virtual std::optional<SpatialQueryHit> RayCastClosestHit(const glm::vec3& origin,
+	                                                                       const glm::vec3& direction, float tMax,
+	                                                                       entt::entity ignore = entt::null) const = 0;
+	virtual void QueryBox(const AxisAlignedBoundingBox& box, std::vector<entt::entity>& entities) const = 0;
+	virtual void QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& entities) const = 0;
+	/// Entities at least partially inside the clip volume of \p viewProjection
+	virtual void QueryFrustum(const glm::mat4& viewProjection, std::vector<entt::entity>& entities) const = 0;
+
+	// Batched queries share their traversal state, results are written in order of the queries
+	virtual void RayCastClosestHits(const std::vector<SpatialQueryRay>& rays,
+	                                std::vector<std::optional<SpatialQueryHit>>& hits) const = 0;
+	/// Entities of boxes[i] are appended to \p entities starting at offsets[i]
+	virtual void QueryBoxes(const std::vector<AxisAlignedBoundingBox>& boxes, std::vector<entt::entity>& entities,
+	                        std::vector<uint32_t>& offsets) const = 0;
+
+	virtual ~SpatialQuerySystemInterface() = default;
+};
+} // namespace openblack::ecs::systems
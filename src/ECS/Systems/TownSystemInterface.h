@@ -9,9 +9,19 @@
 
 #pragma once
 
+#include <span>
+
 #include <entt/fwd.hpp>
 #include <glm/fwd.hpp>
 
+#include "Enums.h"
+
+namespace openblack::ecs
+{
+class TownBeliefs;
+class TownEconomy;
+} // namespace openblack::ecs
+
 namespace openblack::ecs::systems
 {
 class TownSystemInterface
@@ -20,5 +30,19 @@ class TownSystemInterface
 	[[nodiscard]] virtual entt::entity FindAbodeWithSpace(entt::entity townEntity) const = 0;
 	[[nodiscard]] virtual entt::entity FindClosestTown(const glm::vec3& point) const = 0;
 	virtual void AddHomelessVillagerToTown(entt::entity townEntity, entt::entity villagerEntity) = 0;
+	/// Move a villager into an abode, out of its previous abode or its town's homeless list
+	virtual void AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity) = 0;
+
+	/// Give a newly created town its row of beliefs
+	virtual void AddTown(entt::entity townEntity) = 0;
+	/// Forget the beliefs of all towns, once their entities are gone
+	virtual void Reset() = 0;
+	virtual void SetBelief(entt::entity townEntity, PlayerNames player, float belief) = 0;
+	[[nodiscard]] virtual float GetBelief(entt::entity townEntity, PlayerNames player) const = 0;
+	/// Add \p influence times \p scale to the belief of every town in every player at once
+	virtual void AccumulateBeliefs(std::span<const float> influence, float scale) = 0;
+	[[nodiscard]] virtual const TownBeliefs& GetBeliefs() const = 0;
+	/// Food, wood, population and housing of every town, kept up to date as abodes, piles and villagers change
+	[[nodiscard]] virtual const TownEconomy& GetEconomy() const = 0;
 };
 } // namespace openblack::ecs::systems
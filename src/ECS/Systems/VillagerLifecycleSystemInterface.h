@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+
+#include "ECS/VillagerLifecycle.h"
+
+namespace openblack::ecs::systems
+{
+
+class VillagerLifecycleSystemInterface
+{
+public:
+	struct Event
+	{
+		entt::entity villager;
+		VillagerLifecycle::Event type;
+	};
+
+	/// Advance the needs of every villager by a turn, and their age when a year has gone by, then destroy the villagers
+	/// which died
+	virtual void Update() = 0;
+	/// What happened to villagers during the last update, all at once rather than as each villager is updated. The
+	/// villagers of Died events are already destroyed
+	[[nodiscard]] virtual const std::vector<Event>& GetEvents() const = 0;
+	virtual void SetTurnsPerYear(uint32_t turnsPerYear) = 0;
+};
+
+} // namespace openblack::ecs::systems
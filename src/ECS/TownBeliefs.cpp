@@ -0,0 +1,37 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TownBeliefs.h"
+
+#include <cassert>
+
+using namespace openblack::ecs;
+
+uint32_t TownBeliefs::AddTown()
+{
+	const auto town = GetTownCount();
+	_beliefs.resize(_beliefs.size() + k_PlayerStride, 0.0f);
+	return town;
+}
+
+void TownBeliefs::Clear()
+{
+	_beliefs.clear();
+}
+
+void TownBeliefs::Accumulate(std::span<const float> influence, float scale)
+{
+	assert(influence.size() == _beliefs.size());
+	auto* beliefs = _beliefs.data();
+	const auto* influences = influence.data();
+	for (size_t i = 0; i < _beliefs.size(); ++i)
+	{
+		beliefs[i] += influences[i] * scale;
+	}
+}
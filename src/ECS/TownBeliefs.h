@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
+#include "Enums.h"
+
+namespace openblack::ecs
+{
+
+/// Belief of every town in every player, as rows of towns by columns of PlayerNames.
+///
+/// Rows always have room for every player so that players are columns without being registered first. Updates over
+/// all towns and players are one pass over contiguous floats.
+class TownBeliefs
+{
+public:
+	static constexpr uint32_t k_PlayerStride = static_cast<uint32_t>(PlayerNames::_COUNT);
+
+	/// Add a town which doesn't believe in anyone, returns its row
+	uint32_t AddTown();
+	void Clear();
+
+	[[nodiscard]] float Get(uint32_t town, PlayerNames player) const { return _beliefs[Index(town, player)]; }
+	void Set(uint32_t town, PlayerNames player, float belief) { _beliefs[Index(town, player)] = belief; }
+
+	/// Add \p influence times \p scale to every belief, \p influence is laid out as \ref GetBeliefs
+	void Accumulate(std::span<const float> influence, float scale);
+
+	[[nodiscard]] std::span<const float> GetBeliefs() const { return _beliefs; }
+	[[nodiscard]] uint32_t GetTownCount() const { return static_cast<uint32_t>(_beliefs.size() / k_PlayerStride); }
+
+private:
+	[[nodiscard]] size_t Index(uint32_t town, PlayerNames player) const
+	{
+		assert(player < PlayerNames::_COUNT && town < GetTownCount());
+		return static_cast<size_t>(town) * k_PlayerStride + static_cast<uint32_t>(player);
+	}
+
+	std::vector<float> _beliefs;
+};
+
+} // namespace openblack::ecs
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TownEconomy.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
+using namespace openblack::ecs;
+
+namespace
+{
+size_t IndexOf(entt::entity entity)
+{
+	return static_cast<size_t>(entt::to_entity(entity));
+}
+
+void Accumulate(TownEconomy::Stock& total, const TownEconomy::Stock& stock, bool add)
+{
+	const auto apply = [add](uint32_t& value, uint32_t amount) { value = add ? value + amount : value - amount; };
+	apply(total.food, stock.food);
+	apply(total.wood, stock.wood);
+	apply(total.population, stock.population);
+	apply(total.homeless, stock.homeless);
+	apply(total.housing, stock.housing);
+	apply(total.housed, stock.housed);
+}
+} // namespace
+
+void TownEconomy::Set(entt::entity contributor, entt::entity town, const Stock& stock, entt::entity storage)
+{
+	Remove(contributor);
+
+	const auto index = IndexOf(contributor);
+	if (index >= _contributions.size())
+	{
+		_contributions.resize(index + 1);
+	}
+	auto& contribution = _contributions[index];
+	contribution = {town, storage, stock};
+	Apply(contribution, true);
+}
+
+void TownEconomy::Remove(entt::entity contributor)
+{
+	const auto index = IndexOf(contributor);
+	if (index >= _contributions.size() || _contributions[index].town == entt::null)
+	{
+		return;
+	}
+	Apply(_contributions[index], false);
+	_contributions[index] = {};
+}
+
+void TownEconomy::AddStorage(entt::entity storage, entt::entity town, const glm::vec3& position)
+{
+	_storage[town].push_back({storage, position, 0, 0});
+}
+
+void TownEconomy::RemoveStorage(entt::entity storage)
+{
+	for (auto& [town, storages] : _storage)
+	{
+		std::erase_if(storages, [storage](const Storage& s) { return s.entity == storage; });
+	}
+
+	// The piles left behind no longer count towards the town until they are in a pit again
+	for (auto& contribution : _contributions)
+	{
+		if (contribution.storage == storage)
+		{
+			Apply(contribution, false);
+			contribution = {};
+		}
+	}
+}
+
+void TownEconomy::Clear()
+{
+	_contributions.clear();
+	_towns.clear();
+	_storage.clear();
+}
+
+TownEconomy::Stock TownEconomy::GetStock(entt::entity town) const
+{
+	const auto stock = _towns.find(town);
+	return stock != _towns.end() ? stock->second : Stock {};
+}
+
+uint32_t TownEconomy::GetFreeHousing(entt::entity town) const
+{
+	const auto stock = GetStock(town);
+	return stock.housing > stock.housed ? stock.housing - stock.housed : 0;
+}
+
+entt::entity TownEconomy::FindNearestStorageWithWood(entt::entity town, const glm::vec3& position) const
+{
+	const auto storages = _storage.find(town);
+	if (storages == _storage.end())
+	{
+		return entt::null;
+	}
+
+	entt::entity result = entt::null;
+	auto closest = std::numeric_limits<float>::infinity();
+	for (const auto& storage : storages->second)
+	{
+		const auto offset = storage.position - position;
+		const auto distance2 = glm::dot(offset, offset);
+		if (storage.wood > 0 && distance2 < closest)
+		{
+			closest = distance2;
+			result = storage.entity;
+		}
+	}
+	return result;
+}
+
+void TownEconomy::Apply(const Contribution& contribution, bool add)
+{
+	Accumulate(_towns[contribution.town], contribution.stock, add);
+	if (contribution.storage == entt::null)
+	{
+		return;
+	}
+	if (auto* storage = FindStorage(contribution.town, contribution.storage))
+	{
+		storage->food = add ? storage->food + contribution.stock.food : storage->food - contribution.stock.food;
+		storage->wood = add ? storage->wood + contribution.stock.wood : storage->wood - contribution.stock.wood;
+	}
+}
+
+TownEconomy::Storage* TownEconomy::FindStorage(entt::entity town, entt::entity storage)
+{
+	const auto storages = _storage.find(town);
+	if (storages == _storage.end())
+	{
+		return nullptr;
+	}
+	const auto it = std::find_if(storages->second.begin(), storages->second.end(),
+	                             [storage](const Storage& s) { return s.entity == storage; });
+	return it != storages->second.end() ? &*it : nullptr;
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+#include <glm/vec3.hpp>
+
+namespace openblack::ecs
+{
+
+/// Running totals of what each town has, kept up to date as abodes, piles and villagers change rather than summed when
+/// they are needed.
+///
+/// Every entity which adds to a town, such as an abode, a pile in a storage pit or a villager, is a contributor. What
+/// each contributor last added is kept so that it can be replaced or taken away without knowing its previous value.
+class TownEconomy
+{
+public:
+	struct Stock
+	{
+		uint32_t food;
+		uint32_t wood;
+		uint32_t population;
+		uint32_t homeless;
+		/// Villagers the town's abodes have room for
+		uint32_t housing;
+		/// Villagers living in the town's abodes
+		uint32_t housed;
+	};
+
+	/// Replace what \p contributor adds to \p town, and to the \p storage pit it is a pile of if it is one
+	void Set(entt::entity contributor, entt::entity town, const Stock& stock, entt::entity storage = entt::null);
+	void Remove(entt::entity contributor);
+
+	void AddStorage(entt::entity storage, entt::entity town, const glm::vec3& position);
+	/// Forget the \p storage pit along with what its piles added to its town
+	void RemoveStorage(entt::entity storage);
+
+	void Clear();
+
+	[[nodiscard]] Stock GetStock(entt::entity town) const;
+	[[nodiscard]] uint32_t GetFreeHousing(entt::entity town) const;
+	/// The closest of the town's storage pits which has wood, out of the few the town has
+	[[nodiscard]] entt::entity FindNearestStorageWithWood(entt::entity town, const glm::vec3& position) const;
+
+private:
+	struct Contribution
+	{
+		entt::entity town {entt::null};
+		entt::entity storage {entt::null};
+		Stock stock {};
+	};
+
+	struct Storage
+	{
+		entt::entity entity;
+		glm::vec3 position;
+		uint32_t food;
+		uint32_t wood;
+	};
+
+	void Apply(const Contribution& contribution, bool add);
+	Storage* FindStorage(entt::entity town, entt::entity storage);
+
+	/// By contributor entity index
+	std::vector<Contribution> _contributions;
+	std::unordered_map<entt::entity, Stock> _towns;
+	/// Storage pits of each town
+	std::unordered_map<entt::entity, std::vector<Storage>> _storage;
+};
+
+} // namespace openblack::ecs
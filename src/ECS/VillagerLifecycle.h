@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <optional>
+
+#include "ECS/Components/Villager.h"
+
+namespace openblack::ecs
+{
+
+/// How the needs of a villager change as turns and years go by.
+///
+/// A villager's food goes down every turn, and its health once it is hungry or starving. Villagers grow up a year at a
+/// time. Each step reports what happened to the villager, if anything, only on the turn it happened.
+class VillagerLifecycle
+{
+public:
+	/// Values for one type of villager, taken from its info constants
+	struct Rates
+	{
+		float foodPerTurn;
+		float hungryForFood;
+		float starvingForFood;
+		float hungryLifeLoss;
+		float starvingLifeLoss;
+		uint32_t grownUpAge;
+	};
+
+	enum class Event : uint8_t
+	{
+		Starving,
+		Died,
+		GrewUp,
+	};
+
+	// Both steps run for every villager in the lifecycle system's pass so they are kept inline
+
+	static std::optional<Event> AdvanceTurn(components::VillagerNeeds& needs, const Rates& rates)
+	{
+		const auto previousHunger = needs.hunger;
+		const auto previousHealth = needs.health;
+
+		needs.hunger = std::max(needs.hunger - rates.foodPerTurn, 0.0f);
+		const bool starving = needs.hunger < rates.starvingForFood;
+		const bool hungry = needs.hunger < rates.hungryForFood;
+		const auto lifeLoss = starving ? rates.starvingLifeLoss : (hungry ? rates.hungryLifeLoss : 0.0f);
+		needs.health = std::max(needs.health - lifeLoss, 0.0f);
+
+		if (needs.health <= 0.0f && previousHealth > 0.0f)
+		{
+			return Event::Died;
+		}
+		if (starving && previousHunger >= rates.starvingForFood)
+		{
+			return Event::Starving;
+		}
+		return std::nullopt;
+	}
+
+	static std::optional<Event> AdvanceYear(components::VillagerNeeds& needs, components::Villager::LifeStage& lifeStage,
+	                                        const Rates& rates)
+	{
+		++needs.age;
+		if (lifeStage == components::Villager::LifeStage::Child && needs.age >= rates.grownUpAge)
+		{
+			lifeStage = components::Villager::LifeStage::Adult;
+			return Event::GrewUp;
+		}
+		return std::nullopt;
+	}
+};
+
+} // namespace openblack::ecs
@@ -92,6 +92,11 @@ std::vector<uint8_t> AndroidFileSystem::ReadAll(const std::filesystem::path& pat
 	return data;
 }
 
+std::filesystem::path AndroidFileSystem::GetCachePath() const
+{
+	return std::filesystem::path(SDL_AndroidGetInternalStoragePath()) / "cache";
+}
+
 void AndroidFileSystem::Iterate(const std::filesystem::path& path, bool recursive,
                                 const std::function<void(const std::filesystem::path&)>& function) const
 {
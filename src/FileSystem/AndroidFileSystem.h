@@ -31,6 +31,7 @@ class AndroidFileSystem: public FileSystemInterface
 	bool Exists(const std::filesystem::path& path) const override;
 	void SetGamePath(const std::filesystem::path& path) override { _gamePath = path; }
 	[[nodiscard]] const std::filesystem::path& GetGamePath() const override { return _gamePath; }
+	[[nodiscard]] std::filesystem::path GetCachePath() const override;
 	void AddAdditionalPath(const std::filesystem::path& path) override { _additionalPaths.push_back(path); }
 	std::vector<uint8_t> ReadAll(const std::filesystem::path& path) override;
 	void Iterate(const std::filesystem::path& path, bool recursive,
@@ -13,10 +13,12 @@
 
 #include <cctype>
 #include <cstddef>
+#include <cstdlib>
 
 #include <spdlog/spdlog.h>
 
 #include "FileStream.h"
+#include "MMapStream.h"
 
 #ifdef _WIN32
 // clang-format off
@@ -74,6 +76,10 @@ std::filesystem::path DefaultFileSystem::FindPath(const std::filesystem::path& p
 
 std::unique_ptr<Stream> DefaultFileSystem::Open(const std::filesystem::path& path, Stream::Mode mode)
 {
+	if (mode == Stream::Mode::Read)
+	{
+		return std::unique_ptr<Stream>(new MMapStream(FindPath(path)));
+	}
 	return std::unique_ptr<Stream>(new FileStream(FindPath(path), mode));
 }
 
@@ -93,12 +99,8 @@ bool DefaultFileSystem::Exists(const std::filesystem::path& path) const
 std::vector<uint8_t> DefaultFileSystem::ReadAll(const std::filesystem::path& path)
 {
 	auto file = Open(path, Stream::Mode::Read);
-	const std::size_t size = file->Size();
-
-	std::vector<uint8_t> data(size);
-	file->Read(data.data(), size);
-
-	return data;
+	const auto data = file->View(0, file->Size());
+	return {data.begin(), data.end()};
 }
 
 void DefaultFileSystem::Iterate(const std::filesystem::path& path, bool recursive,
@@ -121,6 +123,33 @@ void DefaultFileSystem::Iterate(const std::filesystem::path& path, bool recursiv
 	}
 }
 
+std::filesystem::path DefaultFileSystem::GetCachePath() const
+{
+#ifdef _WIN32
+	const char* base = std::getenv("LOCALAPPDATA");
+	if (base != nullptr)
+	{
+		return std::filesystem::path(base) / "openblack" / "cache";
+	}
+#else
+	const char* xdgCache = std::getenv("XDG_CACHE_HOME");
+	if (xdgCache != nullptr && *xdgCache != '\0')
+	{
+		return std::filesystem::path(xdgCache) / "openblack";
+	}
+	const char* home = std::getenv("HOME");
+	if (home != nullptr)
+	{
+#ifdef __APPLE__
+		return std::filesystem::path(home) / "Library" / "Caches" / "openblack";
+#else
+		return std::filesystem::path(home) / ".cache" / "openblack";
+#endif
+	}
+#endif
+	return std::filesystem::temp_directory_path() / "openblack";
+}
+
 void DefaultFileSystem::SetGamePath(const std::filesystem::path& path)
 {
 	_gamePath = path;
@@ -112,6 +112,8 @@ class FileSystemInterface
 	[[nodiscard]] virtual bool Exists(const std::filesystem::path& path) const = 0;
 	virtual void SetGamePath(const std::filesystem::path& path) = 0;
 	[[nodiscard]] virtual const std::filesystem::path& GetGamePath() const = 0;
+	/// Writable directory of the user for files derived from the game data, which may not exist yet
+	[[nodiscard]] virtual std::filesystem::path GetCachePath() const = 0;
 	virtual void AddAdditionalPath(const std::filesystem::path& path) = 0;
 	virtual std::vector<uint8_t> ReadAll(const std::filesystem::path& path) = 0;
 	virtual void Iterate(const std::filesystem::path& path, bool recursive,
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MMapStream.h"
+
+#include <cstring>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace openblack::filesystem;
+
+MMapStream::MMapStream(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error(fmt::format("Failed to open file '{}'", path.string()));
+	}
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) == 0)
+	{
+		CloseHandle(file);
+		throw std::runtime_error(fmt::format("Failed to get size of file '{}'", path.string()));
+	}
+	_size = static_cast<std::size_t>(size.QuadPart);
+	if (_size > 0)
+	{
+		// The view keeps the mapping alive, neither handle is needed once it is mapped
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr)
+		{
+			_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		throw std::runtime_error(fmt::format("Failed to open file '{}'", path.string()));
+	}
+	struct stat status = {};
+	if (fstat(file, &status) != 0)
+	{
+		close(file);
+		throw std::runtime_error(fmt::format("Failed to get size of file '{}'", path.string()));
+	}
+	_size = static_cast<std::size_t>(status.st_size);
+	if (_size > 0)
+	{
+		// The mapping stays valid once the file is closed
+		void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data != MAP_FAILED)
+		{
+			_data = static_cast<const uint8_t*>(data);
+		}
+	}
+	close(file);
+#endif
+
+	if (_size > 0 && _data == nullptr)
+	{
+		throw std::runtime_error(fmt::format("Failed to map file '{}'", path.string()));
+	}
+}
+
+MMapStream::~MMapStream()
+{
+	if (_data == nullptr)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(_data);
+#else
+	munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+}
+
+std::size_t MMapStream::Position() const
+{
+	return _position;
+}
+
+std::size_t MMapStream::Size() const
+{
+	return _size;
+}
+
+void MMapStream::Seek(std::size_t position, SeekMode seek)
+{
+	switch (seek)
+	{
+	case SeekMode::Begin:
+		_position = position;
+		break;
+	case SeekMode::Current:
+		_position += position;
+		break;
+	case SeekMode::End:
+		_position = _size + position;
+		break;
+	}
+}
+
+Stream& MMapStream::Read(uint8_t* buffer, std::size_t length)
+{
+	if (_position > _size || length > _size - _position)
+	{
+		throw std::runtime_error(fmt::format("Error while reading file"));
+	}
+	std::memcpy(buffer, _data + _position, length);
+	_position += length;
+	return *this;
+}
+
+Stream& MMapStream::Write([[maybe_unused]] const uint8_t* buffer, [[maybe_unused]] std::size_t length)
+{
+	throw std::runtime_error(fmt::format("Error while writing file: mapped files are read only"));
+}
+
+std::string MMapStream::GetLine()
+{
+	if (_position >= _size)
+	{
+		return {};
+	}
+	const auto* begin = _data + _position;
+	const auto* end = _data + _size;
+	const auto* it = std::find(begin, end, '\n');
+
+	std::string line(reinterpret_cast<const char*>(begin), static_cast<std::size_t>(it - begin));
+	// Move the cursor past the '\n'
+	_position = static_cast<std::size_t>(std::min(it + 1, end) - _data);
+	return line;
+}
+
+bool MMapStream::IsEndOfFile() const
+{
+	return _position >= _size;
+}
+
+std::span<const uint8_t> MMapStream::View(std::size_t offset, std::size_t length)
+{
+	if (offset > _size || length > _size - offset)
+	{
+		throw std::runtime_error("View out of bounds of stream");
+	}
+	return {_data + offset, length};
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <filesystem>
+
+#include "Stream.h"
+
+namespace openblack::filesystem
+{
+
+/// Read only stream of a file mapped in memory, which the OS pages in as it is read.
+/// Views point into the mapping, reading a file through them doesn't copy it.
+class MMapStream final: public Stream
+{
+public:
+	explicit MMapStream(const std::filesystem::path& path);
+	MMapStream(const MMapStream&) = delete;
+	MMapStream& operator=(const MMapStream&) = delete;
+	~MMapStream() override;
+
+	[[nodiscard]] std::size_t Position() const override;
+	[[nodiscard]] std::size_t Size() const override;
+	void Seek(std::size_t position, SeekMode seek) override;
+
+	Stream& Read(uint8_t* buffer, std::size_t length) override;
+	Stream& Write(const uint8_t* buffer, std::size_t length) override;
+
+	std::string GetLine() override;
+
+	bool IsEndOfFile() const override;
+
+	[[nodiscard]] std::span<const uint8_t> View(std::size_t offset, std::size_t length) override;
+
+private:
+	/// Null for empty files, which can't be mapped
+	const uint8_t* _data {nullptr};
+	std::size_t _size {0};
+	std::size_t _position {0};
+};
+
+} // namespace openblack::filesystem
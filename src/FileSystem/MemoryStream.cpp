@@ -13,11 +13,13 @@
 #include <cstdint>
 
 #include <algorithm>
+#include <stdexcept>
+#include <utility>
 
 using namespace openblack::filesystem;
 
 MemoryStream::MemoryStream(std::vector<uint8_t>&& data)
-    : _data(data)
+    : _data(std::move(data))
     , _position(0)
 {
 }
@@ -85,3 +87,12 @@ bool MemoryStream::IsEndOfFile() const
 {
 	return Position() >= Size();
 }
+
+std::span<const uint8_t> MemoryStream::View(std::size_t offset, std::size_t length)
+{
+	if (offset > _data.size() || length > _data.size() - offset)
+	{
+		throw std::runtime_error("View out of bounds of stream");
+	}
+	return {_data.data() + offset, length};
+}
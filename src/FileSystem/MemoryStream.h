@@ -34,6 +34,8 @@ class MemoryStream: public Stream
 
 	bool IsEndOfFile() const override;
 
+	[[nodiscard]] std::span<const uint8_t> View(std::size_t offset, std::size_t length) override;
+
 protected:
 	std::vector<uint8_t> _data;
 	std::size_t _position;
@@ -10,8 +10,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace openblack::filesystem
 {
@@ -46,6 +50,23 @@ class Stream
 
 	virtual bool IsEndOfFile() const = 0;
 
+	/// Bytes from \p offset to \p offset + \p length, without moving the position.
+	/// Streams in memory or mapped return their own storage, which is valid for as long as the stream. Other streams
+	/// return a copy, which is only valid until the next view.
+	[[nodiscard]] virtual std::span<const uint8_t> View(std::size_t offset, std::size_t length)
+	{
+		if (offset > Size() || length > Size() - offset)
+		{
+			throw std::runtime_error("View out of bounds of stream");
+		}
+		const auto position = Position();
+		_viewCopy.resize(length);
+		Seek(offset, SeekMode::Begin);
+		Read(_viewCopy.data(), length);
+		Seek(position, SeekMode::Begin);
+		return _viewCopy;
+	}
+
 	template <typename T>
 	Stream& Read(T* value)
 	{
@@ -71,6 +92,9 @@ class Stream
 	{
 		return Write(&value, sizeof(T));
 	}
+
+private:
+	std::vector<uint8_t> _viewCopy;
 };
 
 } // namespace openblack::filesystem
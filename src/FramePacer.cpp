@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace openblack;
+
+FramePacer::Clock::duration FramePacer::GetFramePeriod() const
+{
+	const auto limit = _background && _backgroundFrameRateLimit != 0 ? _backgroundFrameRateLimit : _frameRateLimit;
+	if (limit == 0)
+	{
+		return Clock::duration::zero();
+	}
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / limit;
+}
+
+void FramePacer::Wait()
+{
+	const auto period = GetFramePeriod();
+	const auto now = Clock::now();
+	if (period == Clock::duration::zero())
+	{
+		_deadline = now;
+		return;
+	}
+
+	const auto due = Schedule(_deadline, now, period);
+	if (due - now > k_SpinDuration)
+	{
+		std::this_thread::sleep_for(due - now - k_SpinDuration);
+	}
+	while (Clock::now() < due)
+	{
+		std::this_thread::yield();
+	}
+	_deadline = due;
+}
+
+FramePacer::Clock::time_point FramePacer::Schedule(Clock::time_point deadline, Clock::time_point now,
+                                                   Clock::duration period)
+{
+	return std::max(deadline + period, now);
+}
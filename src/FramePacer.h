@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+
+namespace openblack
+{
+/// Limits the rate at which frames start, without a window or vsync to do it.
+///
+/// Waiting sleeps until shortly before the frame is due, which the OS may overshoot, and spins for the rest. A frame
+/// which starts late moves the following ones rather than making them catch up.
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/// How long before the frame is due waiting stops sleeping and spins
+	static constexpr auto k_SpinDuration = std::chrono::milliseconds(2);
+
+	/// Frames per second, 0 to not limit them
+	void SetFrameRateLimit(uint32_t limit) { _frameRateLimit = limit; }
+	/// Frames per second while the window is hidden or unfocused, 0 to use the frame rate limit
+	void SetBackgroundFrameRateLimit(uint32_t limit) { _backgroundFrameRateLimit = limit; }
+	void SetBackground(bool background) { _background = background; }
+	[[nodiscard]] bool IsBackground() const { return _background; }
+
+	/// Time between frames, zero if they aren't limited
+	[[nodiscard]] Clock::duration GetFramePeriod() const;
+	/// Wait until the next frame is due
+	void Wait();
+
+	/// When the frame following one due at \p deadline is due. It can't be due before \p now.
+	[[nodiscard]] static Clock::time_point Schedule(Clock::time_point deadline, Clock::time_point now,
+	                                                Clock::duration period);
+
+private:
+	uint32_t _frameRateLimit {0};
+	uint32_t _backgroundFrameRateLimit {0};
+	bool _background {false};
+	Clock::time_point _deadline;
+};
+} // namespace openblack
@@ -49,12 +49,18 @@
 #include "ECS/Systems/PathfindingSystemInterface.h"
 #include "ECS/Systems/PlayerSystemInterface.h"
 #include "ECS/Systems/RenderingSystemInterface.h"
+#include "ECS/Systems/SpatialQuerySystemInterface.h"
 #include "ECS/Systems/TownSystemInterface.h"
+#include "ECS/Systems/VillagerLifecycleSystemInterface.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "FramePacer.h"
 #include "GameWindow.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/Texture2D.h"
+#include "Graphics/UploadManager.h"
+#include "LHScriptX/FeatureScriptCommands.h"
 #include "LHScriptX/Script.h"
+#include "LevelCatalogue.h"
 #include "Locator.h"
 #include "PackFile.h"
 #include "Parsers/InfoFile.h"
@@ -62,6 +68,7 @@
 #include "Renderer.h"
 #include "Resources/Loaders.h"
 #include "Resources/ResourcesInterface.h"
+#include "TurnClock.h"
 
 using namespace openblack;
 using namespace openblack::lhscriptx;
@@ -74,8 +81,11 @@ Game* Game::sInstance = nullptr;
 Game::Game(Arguments&& args)
     : _gamePath(args.gamePath)
     , _eventManager(std::make_unique<EventManager>())
+    , _framePacer(std::make_unique<FramePacer>())
+    , _turnClock(std::make_unique<TurnClock>(k_TurnDuration))
     , _startMap(args.startLevel)
     , _handPose(glm::identity<glm::mat4>())
+    , _hoveredEntity(entt::null)
     , _requestScreenshot(args.requestScreenshot)
 {
 	std::function<std::shared_ptr<spdlog::logger>(const std::string&)> createLogger;
@@ -106,6 +116,10 @@ Game::Game(Arguments&& args)
 
 	std::string binaryPath = std::filesystem::path {args.executablePath}.parent_path().generic_string();
 	_config.numFramesToSimulate = args.numFramesToSimulate;
+	_config.frameRateLimit = args.frameRateLimit;
+	_config.backgroundFrameRateLimit = args.backgroundFrameRateLimit;
+	_config.skyCompression = args.skyCompression;
+	_config.skyResidency = args.skyResidency;
 	SPDLOG_LOGGER_INFO(spdlog::get("game"), "current binary path: {}", binaryPath);
 	if (args.rendererType != bgfx::RendererType::Noop)
 	{
@@ -119,7 +133,7 @@ Game::Game(Arguments&& args)
 	}
 	try
 	{
-		_renderer = std::make_unique<Renderer>(_window.get(), args.rendererType, args.vsync);
+		_renderer = std::make_unique<Renderer>(_window.get(), args.rendererType, args.vsync, args.renderThread);
 	}
 	catch (std::runtime_error& exception)
 	{
@@ -167,6 +181,7 @@ Game::~Game()
 	Locator::dynamicsSystem::reset();
 	Locator::cameraBookmarkSystem::reset();
 	Locator::livingActionSystem::reset();
+	Locator::villagerLifecycleSystem::reset();
 	Locator::townSystem::reset();
 	Locator::pathfindingSystem::reset();
 	Locator::terrainSystem::reset();
@@ -187,6 +202,11 @@ entt::entity Game::GetHand() const
 	return _handEntity;
 }
 
+entt::entity Game::GetHoveredEntity() const
+{
+	return _hoveredEntity;
+}
+
 bool Game::ProcessEvents(const SDL_Event& event)
 {
 	static bool leftMouseButton = false;
@@ -283,23 +303,33 @@ bool Game::ProcessEvents(const SDL_Event& event)
 
 bool Game::GameLogicLoop()
 {
-	using namespace ecs::components;
-	using namespace ecs::systems;
-
+	const auto currentTime = std::chrono::steady_clock::now();
+	const auto elapsed = currentTime - _lastGameLoopTime;
+	_lastGameLoopTime = currentTime;
 	if (_paused)
 	{
 		return false;
 	}
 
-	const auto currentTime = std::chrono::steady_clock::now();
-	const auto delta = currentTime - _lastGameLoopTime;
-	const auto turnDuration = k_TurnDuration * _gameSpeedMultiplier;
-	// NOLINTNEXTLINE(modernize-use-nullptr): clang-tidy bug
-	if (delta < turnDuration)
+	const auto turns = _turnClock->Advance(elapsed);
+	for (uint32_t i = 0; i < turns; ++i)
 	{
-		return false;
+		// The turns which don't fit in the frame's budget are owed to the next frames
+		if (i > 0 && std::chrono::steady_clock::now() - currentTime > _turnClock->GetFrameBudget())
+		{
+			break;
+		}
+		UpdateTurn();
+		_turnClock->ConsumeTurn();
 	}
 
+	return false;
+}
+
+void Game::UpdateTurn()
+{
+	using namespace ecs::systems;
+
 	// Build Map Grid Acceleration Structure
 	Locator::entitiesMap::value().Rebuild();
 
@@ -311,16 +341,28 @@ bool Game::GameLogicLoop()
 		auto actions = _profiler->BeginScoped(Profiler::Stage::LivingActionUpdate);
 		Locator::livingActionSystem::value().Update();
 	}
+	{
+		auto lifecycle = _profiler->BeginScoped(Profiler::Stage::VillagerLifecycleUpdate);
+		Locator::villagerLifecycleSystem::value().Update();
+	}
 
-	_lastGameLoopTime = currentTime;
-	_turnDeltaTime = delta;
+	_turnDeltaTime = _turnClock->GetTurnDuration();
 	++_turnCount;
-
-	return false;
 }
 
 bool Game::Update()
 {
+	// Wait before sampling the input so that it is as recent as possible when the simulation reads it
+	if (_window)
+	{
+		const auto flags = _window->GetFlags();
+		_framePacer->SetBackground((flags & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN)) != 0 ||
+		                           (flags & SDL_WINDOW_INPUT_FOCUS) == 0);
+	}
+	_framePacer->SetFrameRateLimit(_config.frameRateLimit);
+	_framePacer->SetBackgroundFrameRateLimit(_config.backgroundFrameRateLimit);
+	_framePacer->Wait();
+
 	_profiler->Frame();
 	auto previous = _profiler->GetEntries().at(_profiler->GetEntryIndex(-1)).frameStart;
 	auto current = _profiler->GetEntries().at(_profiler->GetEntryIndex(0)).frameStart;
@@ -331,6 +373,16 @@ bool Game::Update()
 	}
 	auto deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(current - previous);
 
+	// Input events
+	{
+		auto sdlInput = _profiler->BeginScoped(Profiler::Stage::SdlInput);
+		SDL_Event e;
+		while (SDL_PollEvent(&e) != 0)
+		{
+			_eventManager->Create<SDL_Event>(e);
+		}
+	}
+
 	// Physics
 	{
 		auto physics = _profiler->BeginScoped(Profiler::Stage::PhysicsUpdate);
@@ -342,16 +394,6 @@ bool Game::Update()
 		}
 	}
 
-	// Input events
-	{
-		auto sdlInput = _profiler->BeginScoped(Profiler::Stage::SdlInput);
-		SDL_Event e;
-		while (SDL_PollEvent(&e) != 0)
-		{
-			_eventManager->Create<SDL_Event>(e);
-		}
-	}
-
 	if (!this->_config.running)
 	{
 		return false;
@@ -378,6 +420,12 @@ bool Game::Update()
 		}
 	}
 
+	// Upload terrain edits made by the game logic or tools this frame
+	Locator::terrainSystem::value().UpdateDirtyBlocks();
+
+	// Refit entity bounds moved by the game logic so picking sees this frame's positions
+	Locator::spatialQuerySystem::value().Update();
+
 	// Update Uniforms
 	{
 		auto profilerScopedUpdateUniforms = _profiler->BeginScoped(Profiler::Stage::UpdateUniforms);
@@ -401,6 +449,10 @@ bool Game::Update()
 
 				if (!glm::any(glm::isnan(rayOrigin) || glm::isnan(rayDirection)))
 				{
+					const auto hovered =
+					    Locator::spatialQuerySystem::value().RayCastClosestHit(rayOrigin, rayDirection, 1e10f, _handEntity);
+					_hoveredEntity = hovered ? hovered->entity : entt::null;
+
 					if (auto hit = dynamicsSystem.RayCastClosestHit(rayOrigin, rayDirection, 1e10f))
 					{
 						intersectionTransform = hit->first;
@@ -431,14 +483,15 @@ bool Game::Update()
 		{
 			const glm::vec3 handOffset(0, 1.5f, 0);
 			const glm::mat4 modelRotationCorrection = glm::eulerAngleX(glm::radians(90.0f));
-			auto& handTransform = Locator::entitiesRegistry::value().Get<ecs::components::Transform>(_handEntity);
+			auto& registry = Locator::entitiesRegistry::value();
+			auto& handTransform = registry.Get<ecs::components::Transform>(_handEntity);
 			// TODO(#480): move using velocity rather than snapping hand to intersectionTransform
 			handTransform.position = intersectionTransform.position;
 			auto cameraRotation = _camera->GetRotation();
 			handTransform.rotation = glm::eulerAngleY(-cameraRotation.y) * modelRotationCorrection;
 			handTransform.rotation = intersectionTransform.rotation * handTransform.rotation;
 			handTransform.position += intersectionTransform.rotation * handOffset;
-			Locator::entitiesRegistry::value().SetDirty();
+			registry.SetMoved(_handEntity);
 		}
 
 		// Update Entities
@@ -447,7 +500,17 @@ bool Game::Update()
 			if (_config.drawEntities)
 			{
 				Locator::rendereringSystem::value().PrepareDraw(_config.drawBoundingBoxes, _config.drawFootpaths,
-				                                                _config.drawStreams);
+				                                                _config.drawStreams, _turnClock->GetProgress());
+			}
+		}
+
+		// Occlusion Culling
+		{
+			auto occlusionCulling = _profiler->BeginScoped(Profiler::Stage::OcclusionCulling);
+			if (_config.drawEntities)
+			{
+				Locator::rendereringSystem::value().PrepareOcclusionCulling(
+				    _config.occlusionCulling, _camera->GetViewProjectionMatrix(), _camera->GetPosition());
 			}
 		}
 	} // Update Uniforms
@@ -610,57 +673,55 @@ bool Game::Initialize()
 		meshManager.Load("metre_sphere", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "metre_sphere.l3d");
 	}
 
-	// TODO(raffclar): #400: Parse level files within the resource loader
 	// TODO(raffclar): #405: Determine campaign levels from the challenge script file
-	// Load the campaign levels
-	fileSystem.Iterate(fileSystem.GetPath<Path::Scripts>(), false, [&levelManager](const std::filesystem::path& f) {
-		const auto& name = f.stem().string();
-		if (f.extension() != ".txt" || name.rfind("InfoScript", 0) != std::string::npos)
-		{
-			return;
-		}
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading campaign level: {}", f.stem().string());
-		try
-		{
-			if (Level::IsLevelFile(f))
-			{
-				levelManager.Load(fmt::format("campaign/{}", name), resources::LevelLoader::FromDiskTag {}, f,
-				                  Level::LandType::Campaign);
-			}
-		}
-		catch (std::runtime_error& err)
-		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-		}
-	});
-	// Load Playgrounds
+	// Scripts are only read when they aren't in the level index or changed since it was written
+	const auto levelIndexPath = fileSystem.GetCachePath() / "levels.idx";
+	_levelCatalogue = std::make_unique<LevelCatalogue>();
+	if (fileSystem.Exists(levelIndexPath) && !_levelCatalogue->ReadIndex(fileSystem.ReadAll(levelIndexPath)))
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Level index {} is not valid, ignoring", levelIndexPath.string());
+	}
+	const auto isScript = [](const std::filesystem::path& f) { return f.extension() == ".txt"; };
+	const auto isCampaignScript = [&isScript](const std::filesystem::path& f) {
+		return isScript(f) && f.stem().string().rfind("InfoScript", 0) == std::string::npos;
+	};
+	auto readCount = _levelCatalogue->Scan(fileSystem.GetPath<Path::Scripts>(), Level::LandType::Campaign, isCampaignScript);
 	// Attempt to load additional levels as playgrounds
-	fileSystem.Iterate(fileSystem.GetPath<Path::Playgrounds>(), false, [&levelManager](const std::filesystem::path& f) {
-		if (f.extension() != ".txt")
+	readCount += _levelCatalogue->Scan(fileSystem.GetPath<Path::Playgrounds>(), Level::LandType::Skirmish, isScript);
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Read {} of {} level scripts", readCount,
+	                    _levelCatalogue->GetEntries().size());
+#if !__ANDROID__
+	if (_levelCatalogue->IsIndexOutOfDate())
+	{
+		try
 		{
-			return;
+			// The game directory may be read only, the index goes to the user's cache directory
+			std::filesystem::create_directories(levelIndexPath.parent_path());
+			_levelCatalogue->WriteIndex(levelIndexPath);
 		}
-		const auto& name = f.stem().string();
-		if (levelManager.Contains(fmt::format("playgrounds/{}", name)))
+		catch (std::exception& err)
 		{
-			// Already added
-			return;
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to write level index {}: {}", levelIndexPath.string(), err.what());
 		}
+	}
+#endif
 
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading custom level: {}", f.stem().string());
-		try
+	for (const auto& entry : _levelCatalogue->GetEntries())
+	{
+		if (!entry.isLevel)
 		{
-			if (Level::IsLevelFile(f))
-			{
-				levelManager.Load(fmt::format("playgrounds/{}", name), resources::LevelLoader::FromDiskTag {}, f,
-				                  Level::LandType::Skirmish);
-			}
+			continue;
 		}
-		catch (std::runtime_error& err)
+		const auto* prefix = entry.landType == Level::LandType::Campaign ? "campaign" : "playgrounds";
+		const auto id = fmt::format("{}/{}", prefix, entry.path.stem().string());
+		if (levelManager.Contains(id))
 		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
+			// Already added
+			continue;
 		}
-	});
+		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading level: {}", id);
+		levelManager.Load(id, resources::LevelLoader::FromCatalogueTag {}, entry);
+	}
 
 	// Create profiler
 	_profiler = std::make_unique<Profiler>();
@@ -677,7 +738,6 @@ bool Game::Initialize()
 		SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Opening sound pack {}", f.filename().string());
 		soundPack.Open(f);
 		const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		const auto& audioData = soundPack.GetAudioSamplesData();
 		auto soundName = std::filesystem::path(audioHeaders[0].name.data());
 
 		if (audioHeaders.empty())
@@ -698,19 +758,20 @@ bool Game::Initialize()
 		else
 		{
 			audioManager.CreateSoundGroup(groupName);
+			const auto waveDataOffset = soundPack.GetBlockOffset("LHAudioWaveData");
 			for (size_t i = 0; i < audioHeaders.size(); i++)
 			{
 				soundName = std::filesystem::path(audioHeaders[i].name.data());
-				if (audioData[i].empty())
+				if (audioHeaders[i].size == 0)
 				{
 					SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Empty sound buffer found for {}. Skipping", soundName.string());
 					return;
 				}
 
 				const entt::id_type id = entt::hashed_string(fmt::format("{}/{}", groupName, i).c_str());
-				const std::vector<std::vector<uint8_t>> buffer = {audioData[i]};
 				SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Loading sound {}/{}", groupName, i);
-				soundManager.Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[i], buffer);
+				const audio::SoundSegment segment {waveDataOffset + audioHeaders[i].offset, audioHeaders[i].size};
+				soundManager.Load(id, resources::SoundLoader::FromDiskTag {}, f, audioHeaders[i], std::vector {segment});
 				audioManager.AddToSoundGroup(groupName, id);
 			}
 		}
@@ -744,8 +805,13 @@ bool Game::Initialize()
 		}
 	});
 
-	_sky = std::make_unique<Sky>();
+	_sky = std::make_unique<Sky>(_config.skyCompression, _config.skyResidency);
 	_water = std::make_unique<Water>();
+
+	// Load checkpoint, the assets are uploaded before the first frame is timed
+	graphics::UploadManager::Flush();
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} frames forced by uploads while loading assets",
+	                    graphics::UploadManager::GetForcedFrameCount());
 	return true;
 }
 
@@ -811,6 +877,7 @@ bool Game::Run()
 		{
 			auto section = _profiler->BeginScoped(Profiler::Stage::SceneDraw);
 
+			_sky->SetAlignment(_config.skyAlignment);
 			Renderer::DrawSceneDesc drawDesc {
 			    /*profiler =*/*_profiler,
 			    /*camera =*/_camera.get(),
@@ -872,6 +939,7 @@ bool Game::Run()
 void Game::LoadMap(const std::filesystem::path& path)
 {
 	auto& fileSystem = Locator::filesystem::value();
+	const auto forcedFrameCount = graphics::UploadManager::GetForcedFrameCount();
 
 	if (!fileSystem.Exists(path))
 	{
@@ -883,13 +951,24 @@ void Game::LoadMap(const std::filesystem::path& path)
 
 	// Reset everything. Deletes all entities and their components
 	Locator::entitiesRegistry::value().Reset();
+	Locator::townSystem::value().Reset();
 
 	// We need a hand for the player
 	_handEntity = ecs::archetypes::HandArchetype::Create(glm::vec3(0.0f), glm::half_pi<float>(), 0.0f, glm::half_pi<float>(),
 	                                                     0.01f, false);
 
+	// Trees the script creates are queued and created together, keeping those before a failure
 	Script script;
-	script.Load(source);
+	try
+	{
+		script.Load(source);
+	}
+	catch (...)
+	{
+		FeatureScriptCommands::CreateQueuedTrees();
+		throw;
+	}
+	FeatureScriptCommands::CreateQueuedTrees();
 
 	// Each released map comes with an optional .fot file which contains the footpath information for the map
 	auto stem = string_utils::LowerCase(path.stem().generic_string());
@@ -906,7 +985,13 @@ void Game::LoadMap(const std::filesystem::path& path)
 		                   path.generic_string(), fotPath.generic_string());
 	}
 
+	// Load checkpoint
+	graphics::UploadManager::Flush();
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} frames forced by uploads while loading {}",
+	                    graphics::UploadManager::GetForcedFrameCount() - forcedFrameCount, path.generic_string());
+
 	_lastGameLoopTime = std::chrono::steady_clock::now();
+	_turnClock->Reset();
 	_turnDeltaTime = 0ns;
 	SetGameSpeed(Game::k_TurnDurationMultiplierNormal);
 	_turnCount = 0;
@@ -943,6 +1028,16 @@ bool Game::LoadVariables()
 	                             _infoConstants);
 }
 
+void Game::SetGameSpeed(float multiplier)
+{
+	_turnClock->SetSpeed(multiplier);
+}
+
+float Game::GetGameSpeed() const
+{
+	return _turnClock->GetSpeed();
+}
+
 void Game::SetTime(float time)
 {
 	GetSky().SetTime(time);
@@ -38,10 +38,13 @@ namespace openblack
 class Camera;
 class GameWindow;
 class EventManager;
+class FramePacer;
 class Profiler;
 class Renderer;
+class TurnClock;
 class L3DAnim;
 class L3DMesh;
+class LevelCatalogue;
 class Sky;
 class Water;
 
@@ -92,6 +95,11 @@ struct Arguments
 	int windowWidth;
 	int windowHeight;
 	bool vsync;
+	uint32_t frameRateLimit;
+	uint32_t backgroundFrameRateLimit;
+	bool renderThread;
+	bool skyCompression;
+	bool skyResidency;
 	openblack::DisplayMode displayMode;
 	bgfx::RendererType::Enum rendererType;
 	std::string gamePath;
@@ -128,6 +136,7 @@ class Game
 		bool drawBoundingBoxes {false};
 		bool drawFootpaths {false};
 		bool drawStreams {false};
+		bool occlusionCulling {true};
 
 		float timeOfDay {12.0f};
 		float skyAlignment {0.0f};
@@ -143,6 +152,13 @@ class Game
 		bool running {false};
 
 		uint32_t numFramesToSimulate {0};
+		/// Frames per second, 0 to not limit them
+		uint32_t frameRateLimit {0};
+		/// Frames per second while the window is hidden or unfocused, 0 to use the frame rate limit
+		uint32_t backgroundFrameRateLimit {0};
+		/// Read when the sky is created
+		bool skyCompression {false};
+		bool skyResidency {false};
 	};
 
 	explicit Game(Arguments&& args);
@@ -160,8 +176,9 @@ class Game
 	bool LoadVariables();
 
 	void SetTime(float time);
-	void SetGameSpeed(float multiplier) { _gameSpeedMultiplier = multiplier; }
-	[[nodiscard]] float GetGameSpeed() const { return _gameSpeedMultiplier; }
+	void SetGameSpeed(float multiplier);
+	[[nodiscard]] float GetGameSpeed() const;
+	[[nodiscard]] TurnClock& GetTurnClock() const { return *_turnClock; }
 
 	GameWindow* GetWindow() { return _window.get(); }
 	[[nodiscard]] const GameWindow& GetWindow() const { return *_window; }
@@ -171,7 +188,10 @@ class Game
 	[[nodiscard]] Camera& GetCamera() const { return *_camera; }
 	[[nodiscard]] Sky& GetSky() const { return *_sky; }
 	[[nodiscard]] Water& GetWater() const { return *_water; }
+	[[nodiscard]] const LevelCatalogue& GetLevelCatalogue() const { return *_levelCatalogue; }
 	[[nodiscard]] entt::entity GetHand() const;
+	/// Closest meshed entity under the mouse cursor, entt::null if there is none
+	[[nodiscard]] entt::entity GetHoveredEntity() const;
 	[[nodiscard]] const LHVM::LHVM& GetLhvm() const { return *_lhvm; }
 	LHVM::LHVM& GetLhvm() { return *_lhvm; }
 	const InfoConstants& GetInfoConstants() { return _infoConstants; } ///< Access should be only read-only
@@ -187,6 +207,9 @@ class Game
 	static Game* Instance() { return sInstance; }
 
 private:
+	/// Run one turn of the game logic
+	void UpdateTurn();
+
 	static Game* sInstance;
 
 	/// path to Lionhead Studios Ltd/Black & White folder
@@ -207,6 +230,9 @@ class Game
 	std::unique_ptr<Water> _water;
 	std::unique_ptr<lhscriptx::Script> _scriptx;
 	std::unique_ptr<LHVM::LHVM> _lhvm;
+	std::unique_ptr<LevelCatalogue> _levelCatalogue;
+	std::unique_ptr<FramePacer> _framePacer;
+	std::unique_ptr<TurnClock> _turnClock;
 
 	InfoConstants _infoConstants;
 	Config _config;
@@ -214,7 +240,6 @@ class Game
 
 	std::chrono::steady_clock::time_point _lastGameLoopTime;
 	std::chrono::steady_clock::duration _turnDeltaTime;
-	float _gameSpeedMultiplier {1.0f};
 	uint32_t _frameCount {0};
 	uint16_t _turnCount {0};
 	bool _paused {true};
@@ -223,6 +248,7 @@ class Game
 	glm::mat4 _handPose;
 
 	entt::entity _handEntity;
+	entt::entity _hoveredEntity;
 	bool _handGripping;
 
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> _requestScreenshot;
@@ -24,9 +24,7 @@ std::unique_ptr<Mesh> DebugLines::CreateDebugLines(const Vertex* data, uint32_t
 	decl.emplace_back(VertexAttrib::Attribute::Color0, static_cast<uint8_t>(4), VertexAttrib::Type::Float);
 
 	auto* vertexBuffer = new VertexBuffer("DebugLines", data, vertexCount, decl);
-	bgfx::frame();
 	auto mesh = std::make_unique<Mesh>(vertexBuffer, nullptr, Mesh::Topology::LineList);
-	bgfx::frame();
 
 	return mesh;
 }
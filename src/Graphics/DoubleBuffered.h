@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+
+namespace openblack::graphics
+{
+/// Two copies of CPU-side frame data which bgfx reads by reference (bgfx::makeRef) instead of copying.
+///
+/// The render thread consumes the references of frame N while the game thread prepares frame N + 1, so new data is
+/// written to the copy which isn't in flight. bgfx::frame only returns once the render thread is done with the previous
+/// frame, which makes the older copy safe to overwrite after at most one flip per frame.
+template <typename T>
+class DoubleBuffered
+{
+public:
+	/// Make the copy which isn't in flight the front one and return it to be filled, call at most once per frame
+	T& Flip()
+	{
+		_front ^= 1u;
+		return Front();
+	}
+
+	/// The most recently filled copy
+	[[nodiscard]] T& Front() { return _buffers[_front]; }
+	[[nodiscard]] const T& Front() const { return _buffers[_front]; }
+	/// The copy filled before the front one, which may still be in flight
+	[[nodiscard]] const T& Back() const { return _buffers[_front ^ 1u]; }
+
+private:
+	std::array<T, 2> _buffers;
+	uint8_t _front {0};
+};
+} // namespace openblack::graphics
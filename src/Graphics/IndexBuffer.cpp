@@ -14,6 +14,8 @@
 #include <string>
 #include <utility>
 
+#include "UploadManager.h"
+
 using namespace openblack::graphics;
 
 IndexBuffer::IndexBuffer(std::string name, const void* indices, uint32_t indexCount, Type type)
@@ -25,7 +27,7 @@ IndexBuffer::IndexBuffer(std::string name, const void* indices, uint32_t indexCo
 	assert(indices != nullptr);
 	assert(indexCount > 0);
 
-	const auto* mem = bgfx::makeRef(indices, indexCount * GetTypeSize(_type));
+	const auto* mem = UploadManager::Copy(indices, indexCount * GetTypeSize(_type));
 	_handle = bgfx::createIndexBuffer(mem, type == Type::Uint32 ? BGFX_BUFFER_INDEX32 : 0);
 	bgfx::setName(_handle, _name.c_str());
 }
@@ -36,6 +38,7 @@ IndexBuffer::IndexBuffer(std::string name, const bgfx::Memory* mem, Type type)
     , _handle(BGFX_INVALID_HANDLE)
 {
 	_count = mem->size / sizeof(uint16_t);
+	UploadManager::Stage(mem->size);
 
 	_handle = bgfx::createIndexBuffer(mem, type == Type::Uint32 ? BGFX_BUFFER_INDEX32 : 0);
 	bgfx::setName(_handle, _name.c_str());
@@ -0,0 +1,363 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "OcclusionCuller.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+
+#include <LNDFile.h>
+
+#include "3D/LandIslandInterface.h"
+
+using namespace openblack;
+using namespace openblack::graphics;
+
+namespace
+{
+constexpr float k_FarDepth = std::numeric_limits<float>::max();
+/// Pixels are processed in groups of this many so that the inner loop of the rasteriser is vectorised
+constexpr int k_Lanes = 8;
+static_assert(OcclusionCuller::k_Width % k_Lanes == 0);
+/// Cells covered by one quad of the terrain occluder on each axis
+constexpr uint16_t k_TerrainStep = 8;
+
+struct EdgeFunction
+{
+	float a;
+	float b;
+	float c;
+
+	/// Twice the signed area of the triangle p, q and the evaluated point
+	EdgeFunction(const glm::vec3& p, const glm::vec3& q)
+	    : a(p.y - q.y)
+	    , b(q.x - p.x)
+	    , c(p.x * q.y - p.y * q.x)
+	{
+	}
+};
+
+glm::vec3 ToScreen(const glm::vec4& clip)
+{
+	const auto inverseW = 1.0f / clip.w;
+	return {
+	    (clip.x * inverseW * 0.5f + 0.5f) * OcclusionCuller::k_Width,
+	    (0.5f - clip.y * inverseW * 0.5f) * OcclusionCuller::k_Height,
+	    clip.z * inverseW,
+	};
+}
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+    : _viewProjection(1.0f)
+{
+	for (uint8_t i = 0; i < k_LevelCount; ++i)
+	{
+		_levels[i].resize(static_cast<size_t>(k_Width >> i) * (k_Height >> i));
+	}
+}
+
+void OcclusionCuller::Begin(const glm::mat4& viewProjection)
+{
+	_viewProjection = viewProjection;
+	std::fill(_levels[0].begin(), _levels[0].end(), k_FarDepth);
+	_statistics = {};
+}
+
+void OcclusionCuller::RasterizeTriangles(const glm::mat4& model, std::span<const glm::vec3> vertices,
+                                         std::span<const uint16_t> indices)
+{
+	Rasterize(model, vertices, indices);
+}
+
+void OcclusionCuller::RasterizeTriangles(const glm::mat4& model, std::span<const glm::vec3> vertices,
+                                         std::span<const uint32_t> indices)
+{
+	Rasterize(model, vertices, indices);
+}
+
+template <typename Index>
+void OcclusionCuller::Rasterize(const glm::mat4& model, std::span<const glm::vec3> vertices, std::span<const Index> indices)
+{
+	const auto modelViewProjection = _viewProjection * model;
+	_clipVertices.resize(vertices.size());
+	std::transform(vertices.begin(), vertices.end(), _clipVertices.begin(),
+	               [&modelViewProjection](const glm::vec3& v) { return modelViewProjection * glm::vec4(v, 1.0f); });
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		const auto& a = _clipVertices[indices[i]];
+		const auto& b = _clipVertices[indices[i + 1]];
+		const auto& c = _clipVertices[indices[i + 2]];
+
+		// Trivially reject triangles entirely outside of one of the side planes or behind the near plane
+		if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+		    (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w) ||
+		    (a.z < 0.0f && b.z < 0.0f && c.z < 0.0f))
+		{
+			continue;
+		}
+		++_statistics.occluderTriangles;
+		RasterizeClipped(a, b, c);
+	}
+}
+
+void OcclusionCuller::RasterizeClipped(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+	// Clip against z = 0 which is the near plane for [0, 1] depth and slightly behind it for [-1, 1] depth. Occluders
+	// are only ever lost by clipping too much, never gained.
+	if (a.z >= 0.0f && b.z >= 0.0f && c.z >= 0.0f)
+	{
+		RasterizeScreen(ToScreen(a), ToScreen(b), ToScreen(c));
+		return;
+	}
+
+	std::array<glm::vec4, 4> polygon;
+	size_t count = 0;
+	const std::array<glm::vec4, 3> triangle = {a, b, c};
+	for (size_t i = 0; i < triangle.size(); ++i)
+	{
+		const auto& from = triangle[i];
+		const auto& to = triangle[(i + 1) % triangle.size()];
+		if (from.z >= 0.0f)
+		{
+			polygon[count++] = from;
+		}
+		if ((from.z >= 0.0f) != (to.z >= 0.0f))
+		{
+			polygon[count++] = glm::mix(from, to, from.z / (from.z - to.z));
+		}
+	}
+
+	for (size_t i = 2; i < count; ++i)
+	{
+		RasterizeScreen(ToScreen(polygon[0]), ToScreen(polygon[i - 1]), ToScreen(polygon[i]));
+	}
+}
+
+void OcclusionCuller::RasterizeScreen(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	auto area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	if (!std::isnormal(area))
+	{
+		return;
+	}
+	// Occluders are double sided, wind all triangles the same way
+	const auto& p1 = area > 0.0f ? b : c;
+	const auto& p2 = area > 0.0f ? c : b;
+	area = std::abs(area);
+
+	const auto lower = glm::min(glm::min(a, b), c);
+	const auto upper = glm::max(glm::max(a, b), c);
+	if (upper.x < 0.0f || lower.x > k_Width || upper.y < 0.0f || lower.y > k_Height)
+	{
+		return;
+	}
+	// Clamp before converting, vertices close to the camera plane project very far out
+	const auto minX = static_cast<int>(std::clamp(std::floor(lower.x), 0.0f, k_Width - 1.0f));
+	const auto maxX = static_cast<int>(std::clamp(std::ceil(upper.x), 0.0f, k_Width - 1.0f));
+	const auto minY = static_cast<int>(std::clamp(std::floor(lower.y), 0.0f, k_Height - 1.0f));
+	const auto maxY = static_cast<int>(std::clamp(std::ceil(upper.y), 0.0f, k_Height - 1.0f));
+
+	// Barycentric weights of p1 and p2 give the depth plane, the weight of a is implied
+	const EdgeFunction edge0(p1, p2);
+	const EdgeFunction edge1(p2, a);
+	const EdgeFunction edge2(a, p1);
+	const auto depth1 = (p1.z - a.z) / area;
+	const auto depth2 = (p2.z - a.z) / area;
+	const auto depthA = edge1.a * depth1 + edge2.a * depth2;
+	const auto depthB = edge1.b * depth1 + edge2.b * depth2;
+	const auto depthC = edge1.c * depth1 + edge2.c * depth2 + a.z;
+
+	auto& depth = _levels[0];
+	for (int y = minY; y <= maxY; ++y)
+	{
+		const auto pixelY = static_cast<float>(y) + 0.5f;
+		const auto row0 = edge0.b * pixelY + edge0.c;
+		const auto row1 = edge1.b * pixelY + edge1.c;
+		const auto row2 = edge2.b * pixelY + edge2.c;
+		const auto rowDepth = depthB * pixelY + depthC;
+		auto* row = &depth[static_cast<size_t>(y) * k_Width];
+
+		// Spans are aligned and the width is a multiple of the lane count so no span crosses the end of the row
+		for (int x = minX & ~(k_Lanes - 1); x <= maxX; x += k_Lanes)
+		{
+			auto* span = row + x;
+			for (int lane = 0; lane < k_Lanes; ++lane)
+			{
+				const auto pixelX = static_cast<float>(x + lane) + 0.5f;
+				const auto w0 = edge0.a * pixelX + row0;
+				const auto w1 = edge1.a * pixelX + row1;
+				const auto w2 = edge2.a * pixelX + row2;
+				const auto pixelDepth = depthA * pixelX + rowDepth;
+				const bool inside = (w0 >= 0.0f) & (w1 >= 0.0f) & (w2 >= 0.0f);
+				span[lane] = inside ? std::min(span[lane], pixelDepth) : span[lane];
+			}
+		}
+	}
+}
+
+void OcclusionCuller::End()
+{
+	for (uint8_t level = 1; level < k_LevelCount; ++level)
+	{
+		const auto& source = _levels[level - 1];
+		auto& destination = _levels[level];
+		const size_t sourceWidth = k_Width >> (level - 1);
+		const size_t width = k_Width >> level;
+		const size_t height = k_Height >> level;
+		for (size_t y = 0; y < height; ++y)
+		{
+			const auto* top = &source[2 * y * sourceWidth];
+			const auto* bottom = top + sourceWidth;
+			auto* row = &destination[y * width];
+			for (size_t x = 0; x < width; ++x)
+			{
+				row[x] = std::max(std::max(top[2 * x], top[2 * x + 1]), std::max(bottom[2 * x], bottom[2 * x + 1]));
+			}
+		}
+	}
+}
+
+bool OcclusionCuller::IsVisible(const AxisAlignedBoundingBox& localBox, const glm::mat4& model)
+{
+	++_statistics.testedBoxes;
+
+	const auto modelViewProjection = _viewProjection * model;
+	auto minimum = glm::vec3(std::numeric_limits<float>::max());
+	auto maximum = glm::vec3(std::numeric_limits<float>::lowest());
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		const auto corner = glm::vec3((i & 1u) != 0 ? localBox.maxima.x : localBox.minima.x,
+		                              (i & 2u) != 0 ? localBox.maxima.y : localBox.minima.y,
+		                              (i & 4u) != 0 ? localBox.maxima.z : localBox.minima.z);
+		const auto clip = modelViewProjection * glm::vec4(corner, 1.0f);
+		// Boxes reaching the near plane can't be projected, they're close enough to not bother
+		if (clip.z < 0.0f)
+		{
+			return true;
+		}
+		const auto screen = ToScreen(clip);
+		minimum = glm::min(minimum, screen);
+		maximum = glm::max(maximum, screen);
+	}
+
+	if (maximum.x < 0.0f || minimum.x > k_Width || maximum.y < 0.0f || minimum.y > k_Height)
+	{
+		++_statistics.outsideBoxes;
+		return false;
+	}
+
+	const auto x0 = static_cast<int>(std::clamp(minimum.x, 0.0f, k_Width - 1.0f));
+	const auto x1 = static_cast<int>(std::clamp(maximum.x, 0.0f, k_Width - 1.0f));
+	const auto y0 = static_cast<int>(std::clamp(minimum.y, 0.0f, k_Height - 1.0f));
+	const auto y1 = static_cast<int>(std::clamp(maximum.y, 0.0f, k_Height - 1.0f));
+
+	// Pick the level where the rectangle spans at most three texels on each axis
+	const auto extent = std::max(x1 - x0, y1 - y0);
+	uint8_t level = 0;
+	while ((extent >> level) > 1 && level + 1 < k_LevelCount)
+	{
+		++level;
+	}
+
+	const auto& depth = _levels[level];
+	const auto width = k_Width >> level;
+	for (auto y = y0 >> level; y <= (y1 >> level); ++y)
+	{
+		for (auto x = x0 >> level; x <= (x1 >> level); ++x)
+		{
+			if (minimum.z <= depth[static_cast<size_t>(y * width + x)])
+			{
+				return true;
+			}
+		}
+	}
+
+	++_statistics.occludedBoxes;
+	return false;
+}
+
+void OcclusionCuller::BuildTerrainOccluder(const LandIslandInterface& island, std::vector<glm::vec3>& vertices,
+                                           std::vector<uint32_t>& indices)
+{
+	vertices.clear();
+	indices.clear();
+
+	const auto extent = island.GetIndexExtent();
+	const auto cellMinimum = extent.minimum * static_cast<uint16_t>(LandIslandInterface::k_CellCount);
+	const auto cellCount =
+	    (extent.maximum - extent.minimum + glm::u16vec2(1, 1)) * static_cast<uint16_t>(LandIslandInterface::k_CellCount);
+	const auto quadCount = cellCount / k_TerrainStep;
+	const auto vertexCount = quadCount + glm::u16vec2(1, 1);
+
+	// Lowest altitude of the cells touched by each quad, edges included
+	std::vector<uint8_t> quadMinimum(static_cast<size_t>(quadCount.x) * quadCount.y);
+	for (uint16_t qx = 0; qx < quadCount.x; ++qx)
+	{
+		for (uint16_t qy = 0; qy < quadCount.y; ++qy)
+		{
+			uint8_t altitude = std::numeric_limits<uint8_t>::max();
+			for (uint16_t x = 0; x <= k_TerrainStep; ++x)
+			{
+				for (uint16_t y = 0; y <= k_TerrainStep; ++y)
+				{
+					const auto cell = cellMinimum + glm::u16vec2(qx * k_TerrainStep + x, qy * k_TerrainStep + y);
+					altitude = std::min(altitude, island.GetCell(cell).altitude);
+				}
+			}
+			quadMinimum[qx * quadCount.y + qy] = altitude;
+		}
+	}
+
+	// A vertex is the lowest of the quads it belongs to, which keeps the interpolated surface under every cell
+	std::vector<uint8_t> vertexAltitudes(static_cast<size_t>(vertexCount.x) * vertexCount.y);
+	vertices.reserve(vertexAltitudes.size());
+	for (uint16_t vx = 0; vx < vertexCount.x; ++vx)
+	{
+		for (uint16_t vy = 0; vy < vertexCount.y; ++vy)
+		{
+			uint8_t altitude = std::numeric_limits<uint8_t>::max();
+			for (int qx = vx - 1; qx <= vx; ++qx)
+			{
+				for (int qy = vy - 1; qy <= vy; ++qy)
+				{
+					if (qx >= 0 && qy >= 0 && qx < quadCount.x && qy < quadCount.y)
+					{
+						altitude = std::min(altitude, quadMinimum[qx * quadCount.y + qy]);
+					}
+				}
+			}
+			vertexAltitudes[vx * vertexCount.y + vy] = altitude;
+			const auto cell = glm::vec2(cellMinimum) + glm::vec2(vx, vy) * static_cast<float>(k_TerrainStep);
+			vertices.emplace_back(cell.x * LandIslandInterface::k_CellSize, altitude * LandIslandInterface::k_HeightUnit,
+			                      cell.y * LandIslandInterface::k_CellSize);
+		}
+	}
+
+	for (uint16_t qx = 0; qx < quadCount.x; ++qx)
+	{
+		for (uint16_t qy = 0; qy < quadCount.y; ++qy)
+		{
+			const uint32_t i00 = qx * vertexCount.y + qy;
+			const uint32_t i01 = i00 + 1;
+			const uint32_t i10 = i00 + vertexCount.y;
+			const uint32_t i11 = i10 + 1;
+			// Flat sea floor hides nothing worth the triangles
+			if (vertexAltitudes[i00] == 0 && vertexAltitudes[i01] == 0 && vertexAltitudes[i10] == 0 &&
+			    vertexAltitudes[i11] == 0)
+			{
+				continue;
+			}
+			indices.insert(indices.end(), {i00, i10, i11, i00, i11, i01});
+		}
+	}
+}
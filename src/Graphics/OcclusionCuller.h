@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+
+namespace openblack
+{
+class LandIslandInterface;
+}
+
+namespace openblack::graphics
+{
+struct OcclusionStatistics
+{
+	uint32_t occluderTriangles {0};
+	uint32_t testedBoxes {0};
+	uint32_t occludedBoxes {0};
+	/// Boxes entirely outside of the view, also rejected
+	uint32_t outsideBoxes {0};
+};
+
+/// Software occlusion culling against a low resolution depth buffer filled on the CPU.
+///
+/// Occluders are rasterised into the depth buffer between Begin and End, which then builds a hierarchical depth buffer
+/// where every texel holds the farthest depth of the texels it covers. Boxes are rejected only if their nearest point is
+/// behind the farthest occluder depth over their whole screen rectangle. Depths are the post-projection z / w which is
+/// linear in screen space and grows with distance for both the [-1, 1] and [0, 1] depth conventions.
+///
+/// Nothing here touches the GPU, which lets it run and be tested with the Noop renderer.
+class OcclusionCuller
+{
+public:
+	static constexpr uint16_t k_Width = 256;
+	static constexpr uint16_t k_Height = 128;
+	static constexpr uint8_t k_LevelCount = 8;
+
+	OcclusionCuller();
+
+	/// Clear the depth buffer and statistics for a new view
+	void Begin(const glm::mat4& viewProjection);
+	void RasterizeTriangles(const glm::mat4& model, std::span<const glm::vec3> vertices, std::span<const uint16_t> indices);
+	void RasterizeTriangles(const glm::mat4& model, std::span<const glm::vec3> vertices, std::span<const uint32_t> indices);
+	/// Build the hierarchical depth buffer, no more occluders can be added afterwards
+	void End();
+
+	/// Conservative test of the box \p localBox transformed by \p model against the occluders
+	[[nodiscard]] bool IsVisible(const AxisAlignedBoundingBox& localBox, const glm::mat4& model);
+
+	[[nodiscard]] const OcclusionStatistics& GetStatistics() const { return _statistics; }
+	[[nodiscard]] const std::vector<float>& GetDepth() const { return _levels[0]; }
+
+	/// A coarse world space mesh of \p island where every vertex is at or below all of the terrain around it, so it never
+	/// hides something that the full resolution terrain would not
+	static void BuildTerrainOccluder(const LandIslandInterface& island, std::vector<glm::vec3>& vertices,
+	                                 std::vector<uint32_t>& indices);
+
+private:
+	template <typename Index>
+	void Rasterize(const glm::mat4& model, std::span<const glm::vec3> vertices, std::span<const Index> indices);
+	void RasterizeClipped(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+	void RasterizeScreen(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+	glm::mat4 _viewProjection;
+	/// Level 0 is the depth buffer, each next level halves both dimensions
+	std::array<std::vector<float>, k_LevelCount> _levels;
+	/// Transformed vertices of the occluder being rasterised, kept to avoid allocating for each mesh
+	std::vector<glm::vec4> _clipVertices;
+	OcclusionStatistics _statistics;
+};
+} // namespace openblack::graphics
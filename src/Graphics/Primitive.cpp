@@ -38,9 +38,7 @@ std::unique_ptr<Mesh> Primitive::CreatePlane()
 	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
 
 	auto* vertexBuffer = new VertexBuffer("Plane", vertices.data(), static_cast<uint32_t>(vertices.size()), decl);
-	bgfx::frame();
 	auto mesh = std::make_unique<Mesh>(vertexBuffer, nullptr, Mesh::Topology::TriangleList);
-	bgfx::frame();
 
 	return mesh;
 }
@@ -9,6 +9,10 @@
 
 #include "ShaderProgram.h"
 
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
 #include <spdlog/spdlog.h>
 
 #include "FileSystem/FileSystemInterface.h"
@@ -17,37 +21,56 @@
 
 namespace openblack::graphics
 {
+namespace
+{
+constexpr std::array<std::string_view, static_cast<size_t>(ShaderProgram::Uniform::_Count)> k_UniformNames {
+    "s_diffuse",              // Diffuse
+    "s_alpha",                // Alpha
+    "s_reflection",           // Reflection
+    "s_heightmap",            // HeightMap
+    "s_footprint",            // Footprint
+    "s0_materials",           // Materials
+    "s1_bump",                // Bump
+    "s2_smallBump",           // SmallBump
+    "s3_footprints",          // Footprints
+    "u_islandExtent",         // IslandExtent
+    "u_skyAlphaThreshold",    // SkyAlphaThreshold
+    "u_typeAlignment",        // TypeAlignment
+    "u_sky",                  // Sky
+    "u_skyAndBump",           // SkyAndBump
+    "u_blockPositionAndSize", // BlockPositionAndSize
+    "u_sampleRect",           // SampleRect
+    "u_tint",                 // Tint
+};
+} // namespace
 
 ShaderProgram::ShaderProgram(const std::string& name, bgfx::ShaderHandle vertexShader, bgfx::ShaderHandle fragmentShader)
     : _name(name)
     , _program(BGFX_INVALID_HANDLE)
 {
-	uint16_t numShaderUniforms = 0;
-	bgfx::UniformInfo info = {};
-	std::vector<bgfx::UniformHandle> uniforms;
-
-	numShaderUniforms = bgfx::getShaderUniforms(vertexShader);
-	uniforms.resize(numShaderUniforms);
-	bgfx::getShaderUniforms(vertexShader, uniforms.data(), numShaderUniforms);
-	for (uint16_t i = 0; i < numShaderUniforms; ++i)
-	{
-		bgfx::getUniformInfo(uniforms[i], info);
-		_uniforms.emplace(std::string(info.name), uniforms[i]);
-	}
+	_bindings.fill(bgfx::UniformHandle {bgfx::kInvalidHandle});
 
-	numShaderUniforms = bgfx::getShaderUniforms(fragmentShader);
-	uniforms.resize(numShaderUniforms);
-	bgfx::getShaderUniforms(fragmentShader, uniforms.data(), numShaderUniforms);
-	for (uint16_t i = 0; i < numShaderUniforms; ++i)
+	std::vector<bgfx::UniformHandle> uniforms;
+	for (const auto shader : {vertexShader, fragmentShader})
 	{
-		bgfx::getUniformInfo(uniforms[i], info);
-		_uniforms.emplace(std::string(info.name), uniforms[i]);
+		const auto numShaderUniforms = bgfx::getShaderUniforms(shader);
+		uniforms.resize(numShaderUniforms);
+		bgfx::getShaderUniforms(shader, uniforms.data(), numShaderUniforms);
+		for (const auto uniform : uniforms)
+		{
+			bgfx::UniformInfo info = {};
+			bgfx::getUniformInfo(uniform, info);
+			const auto binding = std::find(k_UniformNames.cbegin(), k_UniformNames.cend(), std::string_view(info.name));
+			if (binding != k_UniformNames.cend())
+			{
+				_bindings[static_cast<size_t>(binding - k_UniformNames.cbegin())] = uniform;
+			}
+		}
 	}
 
 	_program = bgfx::createProgram(vertexShader, fragmentShader, true);
 	bgfx::setName(vertexShader, (name + "_vs").c_str());
 	bgfx::setName(fragmentShader, (name + "_fs").c_str());
-	bgfx::frame();
 }
 
 ShaderProgram::~ShaderProgram()
@@ -58,42 +81,36 @@ ShaderProgram::~ShaderProgram()
 	}
 }
 
-void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint, const Texture2D& texture) const
+void ShaderProgram::SetTextureSampler(Uniform sampler, uint8_t bindPoint, const Texture2D& texture) const
 {
-	auto uniform = _uniforms.find(samplerName);
-	if (uniform != _uniforms.cend())
-	{
-		bgfx::setTexture(bindPoint, uniform->second, texture.GetNativeHandle());
-	}
-	else
-	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Could not find texture sampler {}", samplerName);
-	}
+	SetTextureSampler(sampler, bindPoint, texture.GetNativeHandle());
 }
 
-void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint, const bgfx::TextureHandle& texture) const
+void ShaderProgram::SetTextureSampler(Uniform sampler, uint8_t bindPoint, const bgfx::TextureHandle& texture) const
 {
-	auto uniform = _uniforms.find(samplerName);
-	if (uniform != _uniforms.cend())
+	const auto handle = _bindings[static_cast<size_t>(sampler)];
+	if (bgfx::isValid(handle))
 	{
-		bgfx::setTexture(bindPoint, uniform->second, texture);
+		bgfx::setTexture(bindPoint, handle, texture);
 	}
 	else
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Could not find texture sampler {}", samplerName);
+		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Could not find texture sampler {} in {} Shader",
+		                   k_UniformNames[static_cast<size_t>(sampler)], _name);
 	}
 }
 
-void ShaderProgram::SetUniformValue(const char* uniformName, const void* value) const
+void ShaderProgram::SetUniformValue(Uniform uniform, const void* value) const
 {
-	auto uniform = _uniforms.find(uniformName);
-	if (uniform != _uniforms.cend())
+	const auto handle = _bindings[static_cast<size_t>(uniform)];
+	if (bgfx::isValid(handle))
 	{
-		bgfx::setUniform(uniform->second, value);
+		bgfx::setUniform(handle, value);
 	}
 	else
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Could not find uniform {} in {} Shader", uniformName, _name);
+		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Could not find uniform {} in {} Shader",
+		                   k_UniformNames[static_cast<size_t>(uniform)], _name);
 	}
 }
 
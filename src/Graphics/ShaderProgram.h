@@ -11,7 +11,7 @@
 
 #include <cstdint>
 
-#include <map>
+#include <array>
 #include <string>
 
 #include <bgfx/bgfx.h>
@@ -30,20 +30,45 @@ class ShaderProgram
 		Compute,
 	};
 
+	/// Uniforms and samplers set while drawing, resolved to their handles when the program is created
+	enum class Uniform : uint8_t
+	{
+		Diffuse,
+		Alpha,
+		Reflection,
+		HeightMap,
+		Footprint,
+		Materials,
+		Bump,
+		SmallBump,
+		Footprints,
+		IslandExtent,
+		SkyAlphaThreshold,
+		TypeAlignment,
+		Sky,
+		SkyAndBump,
+		BlockPositionAndSize,
+		SampleRect,
+		Tint,
+
+		_Count,
+	};
+
 	ShaderProgram() = delete;
 	ShaderProgram(const std::string& name, bgfx::ShaderHandle vertexShader, bgfx::ShaderHandle fragmentShader);
 	~ShaderProgram();
 
-	void SetTextureSampler(const char* samplerName, uint8_t bindPoint, const Texture2D& texture) const;
-	void SetTextureSampler(const char* samplerName, uint8_t bindPoint, const bgfx::TextureHandle& texture) const;
-	void SetUniformValue(const char* uniformName, const void* value) const;
+	void SetTextureSampler(Uniform sampler, uint8_t bindPoint, const Texture2D& texture) const;
+	void SetTextureSampler(Uniform sampler, uint8_t bindPoint, const bgfx::TextureHandle& texture) const;
+	void SetUniformValue(Uniform uniform, const void* value) const;
 
 	[[nodiscard]] bgfx::ProgramHandle GetRawHandle() const { return _program; }
 
 private:
 	std::string _name;
 	bgfx::ProgramHandle _program;
-	std::map<std::string, bgfx::UniformHandle> _uniforms;
+	/// Handles of the uniforms used by the program, invalid for the others
+	std::array<bgfx::UniformHandle, static_cast<size_t>(Uniform::_Count)> _bindings;
 };
 
 } // namespace openblack::graphics
@@ -17,6 +17,8 @@
 #include <spdlog/spdlog.h>
 #include <stb_image_write.h>
 
+#include "UploadManager.h"
+
 namespace openblack::graphics
 {
 constexpr std::array<bgfx::TextureFormat::Enum,
@@ -112,34 +114,61 @@ void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format
 		flags |= BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR;
 		break;
 	}
+	// Mipmap filters expect the memory to hold the full mip chain of each layer
+	bool hasMips = true;
 	switch (filter)
 	{
 	case Filter::Nearest:
 		flags |= BGFX_SAMPLER_POINT;
+		hasMips = false;
 		break;
 	case Filter::Linear:
+		hasMips = false;
+		break;
+	case Filter::NearestMipmapNearest:
+		flags |= BGFX_SAMPLER_POINT;
+		break;
+	case Filter::LinearMipmapNearest:
+		flags |= BGFX_SAMPLER_MIP_POINT;
+		break;
+	case Filter::NearestMipmapLinear:
+		flags |= BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT;
+		break;
+	case Filter::LinearMipmapLinear:
 		break;
-	default:
-		assert(false);
 	}
-	_handle = bgfx::createTexture2D(width, height, false, layers, getBgfxTextureFormat(format), flags, memory);
+	_handle = bgfx::createTexture2D(width, height, hasMips, layers, getBgfxTextureFormat(format), flags, memory);
 	bgfx::setName(_handle, _name.c_str());
-	bgfx::frame();
 
-	bgfx::calcTextureSize(_info, width, height, 1, false, false, layers, getBgfxTextureFormat(format));
-	bgfx::frame();
+	bgfx::calcTextureSize(_info, width, height, 1, false, hasMips, layers, getBgfxTextureFormat(format));
 }
 
 void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
                        const void* data, uint32_t size)
 {
 
-	Texture2D::Create(width, height, layers, format, wrapping, filter, bgfx::makeRef(data, size));
+	// bgfx textures created with memory are immutable, leave it empty so it can be filled with Update
+	const auto* memory = data != nullptr ? UploadManager::Copy(data, size) : nullptr;
+	Texture2D::Create(width, height, layers, format, wrapping, filter, memory);
+}
+
+void Texture2D::Update(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const void* data, uint32_t size,
+                       uint16_t layer, uint8_t mip)
+{
+	assert(bgfx::isValid(_handle));
+	assert(x + width <= std::max(_info.width >> mip, 1) && y + height <= std::max(_info.height >> mip, 1));
+	bgfx::updateTexture2D(_handle, layer, mip, x, y, width, height, bgfx::copy(data, size));
 }
 
 void Texture2D::DumpTexture() const
 {
 	assert(!_name.empty());
+	if (_info.format == bgfx::TextureFormat::BC1 || _info.format == bgfx::TextureFormat::BC2 ||
+	    _info.format == bgfx::TextureFormat::BC3)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Cannot dump block compressed texture {}.", _name);
+		return;
+	}
 	std::vector<uint8_t> pixels;
 	pixels.resize(_info.storageSize);
 	bgfx::readTexture(_handle, pixels.data());
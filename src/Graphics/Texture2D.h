@@ -111,6 +111,9 @@ class Texture2D
 	void Create(uint16_t width, uint16_t height, uint16_t layers, Format format = Format::RGBA8,
 	            Wrapping wrapping = Wrapping::ClampEdge, Filter filter = Filter::Linear, const void* data = nullptr,
 	            uint32_t size = 0);
+	/// Replace a rectangle of texels. Only textures created without initial data are mutable.
+	void Update(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const void* data, uint32_t size, uint16_t layer = 0,
+	            uint8_t mip = 0);
 
 	[[nodiscard]] const std::string& GetName() const { return _name; }
 	[[nodiscard]] const bgfx::TextureHandle& GetNativeHandle() const { return _handle; }
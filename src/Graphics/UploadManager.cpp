@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "UploadManager.h"
+
+using namespace openblack::graphics;
+
+namespace
+{
+struct Staging
+{
+	uint64_t bytes;
+	uint32_t count;
+	uint32_t forcedFrameCount;
+};
+
+// Resources are only created from the thread which submits frames
+Staging& GetStaging()
+{
+	static Staging staging {};
+	return staging;
+}
+} // namespace
+
+const bgfx::Memory* UploadManager::Copy(const void* data, uint32_t size)
+{
+	Stage(size);
+	return bgfx::copy(data, size);
+}
+
+void UploadManager::Stage(uint32_t size)
+{
+	if (GetStaging().bytes + size > k_MaxStagedBytes)
+	{
+		Flush();
+	}
+	auto& staging = GetStaging();
+	staging.bytes += size;
+	++staging.count;
+}
+
+void UploadManager::Flush()
+{
+	auto& staging = GetStaging();
+	if (staging.count == 0)
+	{
+		return;
+	}
+	bgfx::frame();
+	++staging.forcedFrameCount;
+	OnFrame();
+}
+
+void UploadManager::OnFrame()
+{
+	auto& staging = GetStaging();
+	staging.bytes = 0;
+	staging.count = 0;
+}
+
+uint32_t UploadManager::GetForcedFrameCount()
+{
+	return GetStaging().forcedFrameCount;
+}
+
+uint64_t UploadManager::GetStagedBytes()
+{
+	return GetStaging().bytes;
+}
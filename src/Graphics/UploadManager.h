@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <utility>
+#include <vector>
+
+#include <bgfx/bgfx.h>
+
+namespace openblack::graphics
+{
+/// Memory for the creation of bgfx resources which stays valid until bgfx is done with it.
+///
+/// bgfx only uploads the data of created resources when the next frame is submitted. Instead of submitting a frame after
+/// each creation to be able to free the data, the data is copied or handed over to bgfx, which releases it once it is
+/// uploaded. Creations are then flushed together by the next real frame, or by a frame forced when too much memory is
+/// staged or a load step needs its resources uploaded.
+class UploadManager
+{
+public:
+	/// Staged memory above which a frame is forced before staging more
+	static constexpr uint64_t k_MaxStagedBytes = 256 * 1024 * 1024;
+
+	/// A copy of \p data, which can be freed as soon as this returns
+	[[nodiscard]] static const bgfx::Memory* Copy(const void* data, uint32_t size);
+	/// Memory owning \p data, released by bgfx once it is uploaded
+	template <typename T>
+	[[nodiscard]] static const bgfx::Memory* Take(std::vector<T>&& data)
+	{
+		const auto size = static_cast<uint32_t>(data.size() * sizeof(T));
+		Stage(size);
+		auto* owned = new std::vector<T>(std::move(data));
+		return bgfx::makeRef(owned->data(), size, [](void* /*unused*/, void* userData) {
+			delete static_cast<std::vector<T>*>(userData);
+		}, owned);
+	}
+	/// Count memory allocated for bgfx (bgfx::alloc) by the caller
+	static void Stage(uint32_t size);
+
+	/// Submit a frame if anything was staged since the last one, for load steps which need their resources uploaded
+	static void Flush();
+	/// Let the manager know a frame was submitted, staged memory is uploaded by then
+	static void OnFrame();
+
+	/// Number of frames submitted by Flush rather than by the renderer
+	[[nodiscard]] static uint32_t GetForcedFrameCount();
+	/// Memory staged since the last frame
+	[[nodiscard]] static uint64_t GetStagedBytes();
+};
+} // namespace openblack::graphics
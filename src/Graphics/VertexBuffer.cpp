@@ -13,6 +13,8 @@
 
 #include <array>
 
+#include "UploadManager.h"
+
 using namespace openblack::graphics;
 
 namespace
@@ -65,7 +67,7 @@ VertexBuffer::VertexBuffer(std::string name, const void* vertices, uint32_t vert
 	layout.end();
 	assert(layout.m_stride == _strideBytes);
 
-	const auto* mem = bgfx::makeRef(vertices, vertexCount * layout.m_stride);
+	const auto* mem = UploadManager::Copy(vertices, vertexCount * layout.m_stride);
 	_handle = bgfx::createVertexBuffer(mem, layout);
 	_layoutHandle = bgfx::createVertexLayout(layout);
 	bgfx::setName(_handle, _name.c_str());
@@ -103,6 +105,7 @@ VertexBuffer::VertexBuffer(std::string name, const bgfx::Memory* mem, VertexDecl
 	assert(layout.m_stride == _strideBytes);
 
 	_vertexCount = mem->size / static_cast<uint32_t>(_strideBytes);
+	UploadManager::Stage(mem->size);
 
 	_handle = bgfx::createVertexBuffer(mem, layout);
 	_layoutHandle = bgfx::createVertexLayout(layout);
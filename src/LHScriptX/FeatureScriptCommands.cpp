@@ -37,6 +37,7 @@
 #include "ECS/Components/Stream.h"
 #include "ECS/Registry.h"
 #include "ECS/Systems/PlayerSystemInterface.h"
+#include "ECS/Systems/TownSystemInterface.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Game.h"
 #include "Locator.h"
@@ -62,6 +63,13 @@ constexpr std::unordered_map<std::string_view, C> makeLookup(std::array<std::str
 	return table;
 }
 
+/// Trees of the scripts being run, which are created together once the script has run
+std::vector<TreeArchetype::Definition>& QueuedTrees()
+{
+	static std::vector<TreeArchetype::Definition> trees;
+	return trees;
+}
+
 const auto k_PlayerLookup = makeLookup<PlayerNames>(k_PlayerNamesStrs);
 const auto k_TribeLookup = makeLookup<Tribe>(k_TribeStrs);
 const auto k_VillagerNumberLookup = makeLookup<VillagerNumber>(k_VillagerNumberStrs);
@@ -261,8 +269,7 @@ void FeatureScriptCommands::SetTownBelief(int32_t townId, const std::string& pla
 	auto& registry = Locator::entitiesRegistry::value();
 	auto& registryContext = registry.Context();
 
-	Town& town = registry.Get<Town>(registryContext.towns.at(townId));
-	town.beliefs.insert({playerOwner, belief});
+	Locator::townSystem::value().SetBelief(registryContext.towns.at(townId), GetPlayerName(playerOwner), belief);
 }
 
 void FeatureScriptCommands::SetTownBeliefCap(int32_t townId, const std::string& playerOwner, float belief)
@@ -428,7 +435,21 @@ void FeatureScriptCommands::CreateDeadTree(glm::vec3 position, [[maybe_unused]]
 void FeatureScriptCommands::CreateNewTree(int32_t forestId, glm::vec3 position, TreeInfo treeType, int32_t isNonScenic,
                                           float rotation, float currentSize, float maxSize)
 {
-	TreeArchetype::Create(forestId, position, treeType, static_cast<bool>(isNonScenic), rotation, maxSize, currentSize);
+	// Levels have thousands of trees, they are created all at once with CreateQueuedTrees
+	QueuedTrees().push_back({static_cast<uint32_t>(forestId), position, treeType, static_cast<bool>(isNonScenic), rotation,
+	                         maxSize, currentSize});
+}
+
+void FeatureScriptCommands::CreateQueuedTrees()
+{
+	auto& trees = QueuedTrees();
+	if (trees.empty())
+	{
+		return;
+	}
+	std::vector<entt::entity> entities(trees.size());
+	TreeArchetype::Create(trees, entities);
+	trees.clear();
 }
 
 void FeatureScriptCommands::CreateField(glm::vec3 position, FieldTypeInfo type)
@@ -61,6 +61,8 @@ class FeatureScriptCommands
 	                           float yaw, float pitch);
 	static void CreateNewTree(int32_t forestId, glm::vec3 position, TreeInfo treeType, int32_t isNonScenic, float rotation,
 	                          float currentSize, float maxSize);
+	/// Create the trees of the scripts which have run so far, to be called once a feature script has run
+	static void CreateQueuedTrees();
 	static void CreateField(glm::vec3 position, FieldTypeInfo type);
 	static void CreateTownField(int32_t townId, glm::vec3 position, FieldTypeInfo type);
 	static void CreateFishFarm(glm::vec3 position, int32_t);
@@ -9,10 +9,13 @@
 
 #include "MapScriptCommands.h"
 
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 #include <string>
 
+#include "ECS/Systems/VillagerLifecycleSystemInterface.h"
+#include "Locator.h"
 #include "ScriptingBindingUtils.h"
 
 using namespace openblack::lhscriptx;
@@ -70,10 +73,9 @@ void MapScriptCommands::SetTime(int32_t, int32_t, int32_t)
 	                       std::to_string(__LINE__));
 }
 
-void MapScriptCommands::SetTurnsPerYear([[maybe_unused]] int32_t turnsPerYear)
+void MapScriptCommands::SetTurnsPerYear(int32_t turnsPerYear)
 {
-	throw std::logic_error(std::string {} + "Function " + __func__ + " not implemented. " + __FILE__ + ":" +
-	                       std::to_string(__LINE__));
+	Locator::villagerLifecycleSystem::value().SetTurnsPerYear(static_cast<uint32_t>(std::max(turnsPerYear, 1)));
 }
 
 void MapScriptCommands::SetGameTickTime([[maybe_unused]] int32_t gameTickTime)
@@ -11,8 +11,8 @@
 
 #include <utility>
 
-#include "Common/StringUtils.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "LevelCatalogue.h"
 #include "Locator.h"
 
 using namespace openblack;
@@ -51,50 +51,10 @@ bool Level::IsValid() const
 	return _isValid;
 }
 
-bool Level::IsLevelFile(const std::filesystem::path& path)
-{
-	const std::string loadLandscapeLine("LOAD_LANDSCAPE");
-	auto levelFile = Locator::filesystem::value().Open(path, filesystem::Stream::Mode::Read);
-	while (!levelFile->IsEndOfFile())
-	{
-		const std::string line = levelFile->GetLine();
-		if (line.find(loadLandscapeLine) != std::string::npos)
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
 Level Level::ParseLevel(const std::filesystem::path& path, Level::LandType landType)
 {
-	std::string description;
-	std::string levelName(path.stem().filename().string());
-	bool isValid(false);
-
-	const std::string loadLandscapeLine("LOAD_LANDSCAPE");
-	const std::string startMessageLine("START_GAME_MESSAGE");
-	const std::string gameMessageLine("ADD_GAME_MESSAGE_LINE");
-
-	auto levelFile = Locator::filesystem::value().Open(path, filesystem::Stream::Mode::Read);
-	while (!levelFile->IsEndOfFile())
-	{
-		std::string line = levelFile->GetLine();
-		if (!isValid && line.find(loadLandscapeLine) != std::string::npos)
-		{
-			const std::filesystem::path landscapePath(string_utils::ExtractQuote(line));
-			isValid = Locator::filesystem::value().Exists(filesystem::FileSystemInterface::FixPath(landscapePath));
-		}
-		if (line.find(startMessageLine) != std::string::npos)
-		{
-			levelName = string_utils::ExtractQuote(line);
-		}
-		if (line.find(gameMessageLine) != std::string::npos)
-		{
-			description = string_utils::ExtractQuote(line);
-		}
-	}
-
-	return {levelName, path, description, landType, isValid};
+	auto stream = Locator::filesystem::value().Open(path, filesystem::Stream::Mode::Read);
+	const auto script = stream->View(0, stream->Size());
+	return LevelCatalogue::ToLevel(
+	    LevelCatalogue::Parse(path, {reinterpret_cast<const char*>(script.data()), script.size()}, landType));
 }
@@ -31,7 +31,6 @@ class Level
 	[[nodiscard]] const std::string& GetDescription() const;
 	[[nodiscard]] bool IsValid() const;
 
-	static bool IsLevelFile(const std::filesystem::path& path);
 	static Level ParseLevel(const std::filesystem::path& path, Level::LandType landType);
 
 private:
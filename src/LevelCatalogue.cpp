@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LevelCatalogue.h"
+
+#include <cstring>
+
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <spdlog/spdlog.h>
+
+#include "FileSystem/FileSystemInterface.h"
+#include "Locator.h"
+
+using namespace openblack;
+
+namespace
+{
+constexpr std::string_view k_LoadLandscape = "LOAD_LANDSCAPE";
+constexpr std::string_view k_StartMessage = "START_GAME_MESSAGE";
+constexpr std::string_view k_GameMessageLine = "ADD_GAME_MESSAGE_LINE";
+
+/// Text between the first two quotes of the line containing \p position
+std::string_view QuoteOfLine(std::string_view script, size_t position)
+{
+	const auto lineEnd = script.find('\n', position);
+	const auto lineStart = script.rfind('\n', position);
+	const auto begin = lineStart == std::string_view::npos ? 0 : lineStart + 1;
+	const auto line = script.substr(begin, lineEnd == std::string_view::npos ? lineEnd : lineEnd - begin);
+	const auto first = line.find('"');
+	if (first == std::string_view::npos)
+	{
+		return {};
+	}
+	return line.substr(first + 1, line.find('"', first + 1) - first - 1);
+}
+
+class IndexReader
+{
+public:
+	explicit IndexReader(const std::vector<uint8_t>& buffer)
+	    : _buffer(buffer)
+	{
+	}
+
+	template <typename T>
+	T Read()
+	{
+		T value;
+		std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	std::string ReadString()
+	{
+		const auto length = Read<uint32_t>();
+		return {reinterpret_cast<const char*>(Take(length)), length};
+	}
+
+private:
+	const uint8_t* Take(size_t length)
+	{
+		if (_buffer.size() - _position < length)
+		{
+			throw std::runtime_error("Level index is truncated");
+		}
+		const auto* data = _buffer.data() + _position;
+		_position += length;
+		return data;
+	}
+
+	const std::vector<uint8_t>& _buffer;
+	size_t _position {0};
+};
+
+template <typename T>
+void WriteValue(std::ofstream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void WriteString(std::ofstream& stream, const std::string& string)
+{
+	WriteValue(stream, static_cast<uint32_t>(string.size()));
+	stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+}
+} // namespace
+
+LevelCatalogue::Entry LevelCatalogue::Parse(const std::filesystem::path& path, std::string_view script,
+                                            Level::LandType landType)
+{
+	Entry entry {path, 0, 0, landType, false, path.stem().filename().string(), {}, {}};
+
+	const auto landscape = script.find(k_LoadLandscape);
+	if (landscape != std::string_view::npos)
+	{
+		entry.isLevel = true;
+		entry.landscape = QuoteOfLine(script, landscape);
+	}
+	// Later messages replace earlier ones
+	const auto startMessage = script.rfind(k_StartMessage);
+	if (startMessage != std::string_view::npos)
+	{
+		entry.name = QuoteOfLine(script, startMessage);
+	}
+	const auto gameMessageLine = script.rfind(k_GameMessageLine);
+	if (gameMessageLine != std::string_view::npos)
+	{
+		entry.description = QuoteOfLine(script, gameMessageLine);
+	}
+
+	return entry;
+}
+
+Level LevelCatalogue::ToLevel(const Entry& entry)
+{
+	const bool isValid = !entry.landscape.empty() &&
+	                     Locator::filesystem::value().Exists(filesystem::FileSystemInterface::FixPath(entry.landscape));
+	return {entry.name, entry.path, entry.description, entry.landType, isValid};
+}
+
+bool LevelCatalogue::ReadIndex(const std::vector<uint8_t>& buffer)
+{
+	std::unordered_map<std::string, Entry> indexed;
+	try
+	{
+		IndexReader reader(buffer);
+		if (reader.Read<uint32_t>() != k_Magic || reader.Read<uint32_t>() != k_Version)
+		{
+			return false;
+		}
+		const auto count = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Entry entry {};
+			entry.path = reader.ReadString();
+			entry.size = reader.Read<uint64_t>();
+			entry.modified = reader.Read<int64_t>();
+			entry.landType = reader.Read<uint8_t>() != 0 ? Level::LandType::Campaign : Level::LandType::Skirmish;
+			entry.isLevel = reader.Read<uint8_t>() != 0;
+			entry.name = reader.ReadString();
+			entry.description = reader.ReadString();
+			entry.landscape = reader.ReadString();
+			auto key = entry.path.generic_string();
+			indexed.insert_or_assign(std::move(key), std::move(entry));
+		}
+	}
+	catch (std::runtime_error&)
+	{
+		return false;
+	}
+
+	_indexed = std::move(indexed);
+	return true;
+}
+
+void LevelCatalogue::WriteIndex(const std::filesystem::path& path) const
+{
+	std::ofstream stream(path, std::ios::binary);
+	if (!stream.is_open())
+	{
+		throw std::runtime_error("Could not open file " + path.string());
+	}
+
+	WriteValue(stream, k_Magic);
+	WriteValue(stream, k_Version);
+	WriteValue(stream, static_cast<uint32_t>(_entries.size()));
+	for (const auto& entry : _entries)
+	{
+		WriteString(stream, entry.path.generic_string());
+		WriteValue(stream, entry.size);
+		WriteValue(stream, entry.modified);
+		WriteValue(stream, static_cast<uint8_t>(entry.landType == Level::LandType::Campaign));
+		WriteValue(stream, static_cast<uint8_t>(entry.isLevel));
+		WriteString(stream, entry.name);
+		WriteString(stream, entry.description);
+		WriteString(stream, entry.landscape);
+	}
+}
+
+uint32_t LevelCatalogue::Scan(const std::filesystem::path& directory, Level::LandType landType,
+                              const std::function<bool(const std::filesystem::path&)>& filter)
+{
+	auto& fileSystem = Locator::filesystem::value();
+	uint32_t readCount = 0;
+	fileSystem.Iterate(directory, false, [this, &fileSystem, &readCount, landType, &filter](const std::filesystem::path& f) {
+		if (!filter(f))
+		{
+			return;
+		}
+
+		// Files which can't be stat'd, such as Android assets, are read every time
+		std::error_code ec;
+		const uint64_t size = std::filesystem::file_size(f, ec);
+		const bool sizeKnown = !ec;
+		const int64_t modified = std::filesystem::last_write_time(f, ec).time_since_epoch().count();
+		const bool stamped = sizeKnown && !ec;
+
+		const auto indexed = _indexed.find(f.generic_string());
+		if (indexed != _indexed.end())
+		{
+			auto entry = std::move(indexed->second);
+			_indexed.erase(indexed);
+			if (stamped && entry.size == size && entry.modified == modified && entry.landType == landType)
+			{
+				_entries.emplace_back(std::move(entry));
+				return;
+			}
+		}
+
+		try
+		{
+			auto stream = fileSystem.Open(f, filesystem::Stream::Mode::Read);
+			const auto script = stream->View(0, stream->Size());
+			auto entry = Parse(f, {reinterpret_cast<const char*>(script.data()), script.size()}, landType);
+			entry.size = stamped ? size : 0;
+			entry.modified = stamped ? modified : 0;
+			_entries.emplace_back(std::move(entry));
+			_indexOutOfDate = true;
+			++readCount;
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to read level script {}: {}", f.string(), err.what());
+		}
+	});
+	return readCount;
+}
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Level.h"
+
+namespace openblack
+{
+/// The level scripts found in the script directories, with the names and descriptions of their levels.
+///
+/// Each script is read once and searched in memory. What was found is kept in an index keyed by path, size and
+/// modification time, which is written to the user's cache directory so that unchanged scripts aren't read again on the
+/// next launch. Levels can be listed from the catalogue without loading any of them.
+class LevelCatalogue
+{
+public:
+	struct Entry
+	{
+		std::filesystem::path path;
+		uint64_t size;
+		int64_t modified;
+		Level::LandType landType;
+		/// The script loads a landscape
+		bool isLevel;
+		std::string name;
+		std::string description;
+		/// Path of the landscape loaded by the script, as written in the script
+		std::string landscape;
+	};
+
+	static constexpr uint32_t k_Magic = 0x43'4C'42'4F; // OBLC
+	static constexpr uint32_t k_Version = 1;
+
+	/// Find the level values in the \p script at \p path, the name is the file's stem unless the script names it
+	[[nodiscard]] static Entry Parse(const std::filesystem::path& path, std::string_view script, Level::LandType landType);
+	/// The level of a script, which is only valid if its landscape can be found
+	[[nodiscard]] static Level ToLevel(const Entry& entry);
+
+	/// Reuse the entries of a previously written index, a malformed index is ignored
+	bool ReadIndex(const std::vector<uint8_t>& buffer);
+	void WriteIndex(const std::filesystem::path& path) const;
+
+	/// Add the scripts in \p directory which pass \p filter, returns the number of scripts which had to be read
+	uint32_t Scan(const std::filesystem::path& directory, Level::LandType landType,
+	              const std::function<bool(const std::filesystem::path&)>& filter);
+
+	[[nodiscard]] const std::vector<Entry>& GetEntries() const { return _entries; }
+	/// Whether the scanned entries differ from the index that was read
+	[[nodiscard]] bool IsIndexOutOfDate() const { return _indexOutOfDate || !_indexed.empty(); }
+
+private:
+	std::vector<Entry> _entries;
+	/// Entries read from the index which weren't scanned yet, by generic path
+	std::unordered_map<std::string, Entry> _indexed;
+	bool _indexOutOfDate {false};
+};
+} // namespace openblack
@@ -28,7 +28,9 @@
 #include "ECS/Systems/Implementations/PathfindingSystem.h"
 #include "ECS/Systems/Implementations/PlayerSystem.h"
 #include "ECS/Systems/Implementations/RenderingSystem.h"
+#include "ECS/Systems/Implementations/SpatialQuerySystem.h"
 #include "ECS/Systems/Implementations/TownSystem.h"
+#include "ECS/Systems/Implementations/VillagerLifecycleSystem.h"
 #if __ANDROID__
 #include "FileSystem/AndroidFileSystem.h"
 #else
@@ -46,7 +48,9 @@ using openblack::ecs::systems::LivingActionSystem;
 using openblack::ecs::systems::PathfindingSystem;
 using openblack::ecs::systems::PlayerSystem;
 using openblack::ecs::systems::RenderingSystem;
+using openblack::ecs::systems::SpatialQuerySystem;
 using openblack::ecs::systems::TownSystem;
+using openblack::ecs::systems::VillagerLifecycleSystem;
 using openblack::resources::Resources;
 
 namespace openblack::ecs::systems
@@ -81,9 +85,11 @@ void InitializeLevel(const std::filesystem::path& path)
 	Locator::entitiesMap::emplace<MapProduction>();
 	Locator::dynamicsSystem::emplace<DynamicsSystem>();
 	Locator::livingActionSystem::emplace<LivingActionSystem>();
+	Locator::villagerLifecycleSystem::emplace<VillagerLifecycleSystem>();
 	Locator::townSystem::emplace<TownSystem>();
 	Locator::pathfindingSystem::emplace<PathfindingSystem>();
 	Locator::cameraBookmarkSystem::emplace<CameraBookmarkSystem>();
+	Locator::spatialQuerySystem::emplace<SpatialQuerySystem>();
 	Locator::terrainSystem::emplace<LandIsland>(path);
 }
 } // namespace openblack::ecs::systems
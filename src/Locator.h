@@ -49,6 +49,8 @@ class LivingActionSystemInterface;
 class TownSystemInterface;
 class PathfindingSystemInterface;
 class PlayerSystemInterface;
+class SpatialQuerySystemInterface;
+class VillagerLifecycleSystemInterface;
 
 void InitializeGame();
 void InitializeLevel(const std::filesystem::path& path);
@@ -65,11 +67,13 @@ struct Locator
 	using dynamicsSystem = entt::locator<ecs::systems::DynamicsSystemInterface>;
 	using cameraBookmarkSystem = entt::locator<ecs::systems::CameraBookmarkSystemInterface>;
 	using livingActionSystem = entt::locator<ecs::systems::LivingActionSystemInterface>;
+	using villagerLifecycleSystem = entt::locator<ecs::systems::VillagerLifecycleSystemInterface>;
 	using townSystem = entt::locator<ecs::systems::TownSystemInterface>;
 	using pathfindingSystem = entt::locator<ecs::systems::PathfindingSystemInterface>;
 	using entitiesRegistry = entt::locator<ecs::Registry>;
 	using entitiesMap = entt::locator<ecs::MapInterface>;
 	using playerSystem = entt::locator<ecs::systems::PlayerSystemInterface>;
+	using spatialQuerySystem = entt::locator<ecs::systems::SpatialQuerySystemInterface>;
 	using temple = entt::locator<TempleInteriorInterface>;
 };
 } // namespace openblack
@@ -10,6 +10,9 @@
 #include "Profiler.h"
 
 #include <cassert>
+#include <cmath>
+
+#include <algorithm>
 
 void openblack::Profiler::Begin(Stage stage)
 {
@@ -38,3 +41,29 @@ void openblack::Profiler::Frame()
 	_currentEntry = (_currentEntry + 1) % k_BufferSize;
 	prevEntry.frameEnd = _entries.at(_currentEntry).frameStart = std::chrono::system_clock::now();
 }
+
+openblack::Profiler::FrameTimes openblack::Profiler::GetFrameTimes() const
+{
+	float sum = 0.0f;
+	float squaredSum = 0.0f;
+	uint32_t count = 0;
+	for (const auto& entry : _entries)
+	{
+		// The current frame and the ones not recorded yet haven't ended
+		if (entry.frameEnd <= entry.frameStart)
+		{
+			continue;
+		}
+		const std::chrono::duration<float, std::milli> duration = entry.frameEnd - entry.frameStart;
+		sum += duration.count();
+		squaredSum += duration.count() * duration.count();
+		++count;
+	}
+	if (count == 0)
+	{
+		return {};
+	}
+	const auto mean = sum / static_cast<float>(count);
+	const auto variance = std::max(squaredSum / static_cast<float>(count) - mean * mean, 0.0f);
+	return {std::chrono::duration<float, std::milli>(mean), std::chrono::duration<float, std::milli>(std::sqrt(variance))};
+}
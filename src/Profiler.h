@@ -27,9 +27,11 @@ class Profiler
 		PhysicsUpdate,
 		PathfindingUpdate,
 		LivingActionUpdate,
+		VillagerLifecycleUpdate,
 		SdlInput,
 		UpdateUniforms,
 		UpdateEntities,
+		OcclusionCulling,
 		UpdateAudio,
 		GuiLoop,
 		GameLogic,
@@ -59,9 +61,11 @@ class Profiler
 	    "Physics Update",       //
 	    "Pathfinding Update",   //
 	    "Living Action Update", //
+	    "Villager Lifecycle",   //
 	    "SDL Input",            //
 	    "Update Uniforms",      //
 	    "Entities",             //
+	    "Occlusion Culling",    //
 	    "Audio",                //
 	    "GUI Loop",             //
 	    "Game Logic",           //
@@ -116,6 +120,12 @@ class Profiler
 		std::array<Scope, static_cast<uint8_t>(Stage::_count)> stages;
 	};
 
+	struct FrameTimes
+	{
+		std::chrono::duration<float, std::milli> mean;
+		std::chrono::duration<float, std::milli> standardDeviation;
+	};
+
 	void Frame();
 	void Begin(Stage stage);
 	void End(Stage stage);
@@ -126,6 +136,8 @@ class Profiler
 	constexpr static uint8_t k_BufferSize = 100;
 	std::array<Entry, k_BufferSize>& GetEntries() { return _entries; }
 	[[nodiscard]] const std::array<Entry, k_BufferSize>& GetEntries() const { return _entries; }
+	/// Mean and standard deviation of the durations of the recorded frames, including the time spent pacing them
+	[[nodiscard]] FrameTimes GetFrameTimes() const;
 
 private:
 	std::array<Entry, k_BufferSize> _entries;
@@ -9,6 +9,8 @@
 
 #include "Renderer.h"
 
+#include <future>
+
 #include <SDL_video.h>
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
@@ -35,6 +37,7 @@
 #include "Graphics/IndexBuffer.h"
 #include "Graphics/Primitive.h"
 #include "Graphics/ShaderManager.h"
+#include "Graphics/UploadManager.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
 #include "Profiler.h"
@@ -44,6 +47,7 @@
 using namespace openblack;
 using namespace openblack::graphics;
 using namespace openblack::ecs::systems;
+using Uniform = ShaderProgram::Uniform;
 
 namespace openblack
 {
@@ -167,7 +171,7 @@ struct BgfxCallback: public bgfx::CallbackI
 
 } // namespace openblack
 
-Renderer::Renderer(const GameWindow* window, bgfx::RendererType::Enum rendererType, bool vsync)
+Renderer::Renderer(const GameWindow* window, bgfx::RendererType::Enum rendererType, bool vsync, bool renderThread)
     : _shaderManager(std::make_unique<ShaderManager>())
     , _bgfxCallback(std::make_unique<BgfxCallback>())
 {
@@ -195,14 +199,62 @@ Renderer::Renderer(const GameWindow* window, bgfx::RendererType::Enum rendererTy
 	init.resolution.reset = _bgfxReset;
 	init.callback = dynamic_cast<bgfx::CallbackI*>(_bgfxCallback.get());
 
+#ifdef __APPLE__
+	// Cocoa only lets the main thread present, which is the game thread
+	if (renderThread)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "A dedicated render thread isn't supported on macOS, ignoring it");
+		renderThread = false;
+	}
+#endif
+
+	if (renderThread)
+	{
+		// Calling renderFrame before init makes its thread the render thread and the one calling init the API thread
+		std::promise<void> started;
+		auto startedFuture = started.get_future();
+		_renderThread = std::thread([this, &started]() {
+			bgfx::renderFrame();
+			started.set_value();
+			while (true)
+			{
+				const auto result = bgfx::renderFrame();
+				if (result == bgfx::RenderFrame::Exiting)
+				{
+					break;
+				}
+				if (result == bgfx::RenderFrame::NoContext)
+				{
+					if (_stopRenderThread)
+					{
+						break;
+					}
+					std::this_thread::yield();
+				}
+			}
+		});
+		startedFuture.wait();
+	}
+
 	if (!bgfx::init(init))
 	{
+		if (_renderThread.joinable())
+		{
+			_stopRenderThread = true;
+			_renderThread.join();
+		}
 		throw std::runtime_error("Failed to initialize bgfx.");
 	}
 
 	const bgfx::Caps* caps = bgfx::getCaps();
 	if ((caps->supported & BGFX_CAPS_TEXTURE_2D_ARRAY) == 0 || caps->limits.maxTextureLayers < 9)
 	{
+		// The destructor won't run, the render thread exits once bgfx is shut down
+		bgfx::shutdown();
+		if (_renderThread.joinable())
+		{
+			_renderThread.join();
+		}
 		throw std::runtime_error("Graphics device must support texture layers.");
 	}
 
@@ -227,6 +279,10 @@ Renderer::~Renderer()
 	_debugCross.reset();
 	bgfx::frame();
 	bgfx::shutdown();
+	if (_renderThread.joinable())
+	{
+		_renderThread.join();
+	}
 }
 
 void Renderer::ConfigureView(graphics::RenderPass viewId, uint16_t width, uint16_t height, uint32_t clearColor) const
@@ -314,12 +370,12 @@ void Renderer::DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const
 			}
 			if (texture != nullptr)
 			{
-				desc.program->SetTextureSampler("s_diffuse", 0, *texture);
+				desc.program->SetTextureSampler(Uniform::Diffuse, 0, *texture);
 			}
 			if (desc.morphWithTerrain)
 			{
-				desc.program->SetTextureSampler("s_heightmap", 1, heightMap);   // vs
-				desc.program->SetUniformValue("u_islandExtent", &islandExtent); // vs
+				desc.program->SetTextureSampler(Uniform::HeightMap, 1, heightMap);   // vs
+				desc.program->SetUniformValue(Uniform::IslandExtent, &islandExtent); // vs
 			}
 			if (!desc.isSky)
 			{
@@ -329,7 +385,7 @@ void Renderer::DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const
 				    0.0f,
 				    0.0f,
 				};
-				desc.program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
+				desc.program->SetUniformValue(Uniform::SkyAlphaThreshold, &u_skyAlphaThreshold);
 			}
 		}
 		else
@@ -422,7 +478,7 @@ void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 				continue;
 			}
 			const auto& footprint = mesh->GetFootprints()[0];
-			footprintShaderInstanced->SetTextureSampler("s_footprint", 0, *footprint.texture);
+			footprintShaderInstanced->SetTextureSampler(Uniform::Footprint, 0, *footprint.texture);
 			footprint.mesh->GetVertexBuffer().Bind();
 			bgfx::setInstanceDataBuffer(renderCtx.instanceUniformBuffer, placers.offset, placers.count);
 			const uint64_t state = 0u                       //
@@ -499,11 +555,10 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 		if (desc.drawSky)
 		{
 			const auto modelMatrix = glm::mat4(1.0f);
-			const glm::vec4 u_typeAlignment = {desc.sky.GetCurrentSkyType(), Game::Instance()->GetConfig().skyAlignment + 1.0f,
-			                                   0.0f, 0.0f};
+			const auto u_typeAlignment = desc.sky.GetTypeAlignmentUniform();
 
-			skyShader->SetTextureSampler("s_diffuse", 0, *desc.sky._texture);
-			skyShader->SetUniformValue("u_typeAlignment", &u_typeAlignment);
+			skyShader->SetTextureSampler(Uniform::Diffuse, 0, *desc.sky._texture);
+			skyShader->SetUniformValue(Uniform::TypeAlignment, &u_typeAlignment);
 
 			L3DMeshSubmitDesc submitDesc = {};
 			submitDesc.viewId = desc.viewId;
@@ -533,11 +588,11 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			bgfx::setState(BGFX_STATE_DEFAULT);
 			auto diffuse = Locator::resources::value().GetTextures().Handle(Water::k_DiffuseTextureId);
 			auto alpha = Locator::resources::value().GetTextures().Handle(Water::k_AlphaTextureId);
-			waterShader->SetTextureSampler("s_diffuse", 0, *diffuse);
-			waterShader->SetTextureSampler("s_alpha", 1, *alpha);
-			waterShader->SetTextureSampler("s_reflection", 2, desc.water.GetFrameBuffer().GetColorAttachment());
+			waterShader->SetTextureSampler(Uniform::Diffuse, 0, *diffuse);
+			waterShader->SetTextureSampler(Uniform::Alpha, 1, *alpha);
+			waterShader->SetTextureSampler(Uniform::Reflection, 2, desc.water.GetFrameBuffer().GetColorAttachment());
 			const glm::vec4 u_sky = {desc.sky.GetCurrentSkyType(), 0.0f, 0.0f, 0.0f};
-			waterShader->SetUniformValue("u_sky", &u_sky); // fs
+			waterShader->SetUniformValue(Uniform::Sky, &u_sky); // fs
 			bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), waterShader->GetRawHandle());
 		}
 	}
@@ -554,13 +609,13 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			const glm::vec4 u_skyAndBump = {desc.sky.GetCurrentSkyType(), desc.bumpMapStrength, desc.smallBumpMapStrength,
 			                                0.0f};
 
-			terrainShader->SetTextureSampler("s0_materials", 0, island.GetAlbedoArray());
-			terrainShader->SetTextureSampler("s1_bump", 1, island.GetBump());
-			terrainShader->SetTextureSampler("s2_smallBump", 2, *texture);
-			terrainShader->SetTextureSampler("s3_footprints", 3, island.GetFootprintFramebuffer().GetColorAttachment());
+			terrainShader->SetTextureSampler(Uniform::Materials, 0, island.GetAlbedoArray());
+			terrainShader->SetTextureSampler(Uniform::Bump, 1, island.GetBump());
+			terrainShader->SetTextureSampler(Uniform::SmallBump, 2, *texture);
+			terrainShader->SetTextureSampler(Uniform::Footprints, 3, island.GetFootprintFramebuffer().GetColorAttachment());
 
-			terrainShader->SetUniformValue("u_skyAndBump", &u_skyAndBump);
-			terrainShader->SetUniformValue("u_islandExtent", &islandExtent);
+			terrainShader->SetUniformValue(Uniform::SkyAndBump, &u_skyAndBump);
+			terrainShader->SetUniformValue(Uniform::IslandExtent, &islandExtent);
 
 			// clang-format off
 			constexpr auto defaultState = 0u
@@ -583,7 +638,7 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			{
 				// pack uniforms
 				const glm::vec4 mapPositionAndSize = glm::vec4(block.GetMapPosition(), 160.0f, 160.0f);
-				terrainShader->SetUniformValue("u_blockPositionAndSize", &mapPositionAndSize);
+				terrainShader->SetUniformValue(Uniform::BlockPositionAndSize, &mapPositionAndSize);
 
 				block.GetMesh().GetVertexBuffer().Bind();
 
@@ -608,13 +663,18 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			                   | BGFX_STATE_MSAA            //
 			    ;
 			const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
+			// Occlusion is computed from the main camera, other views see what it hides
+			const bool occlusionCulled = renderCtx.occlusionCulled && desc.viewId == graphics::RenderPass::Main;
+			const auto& drawDescs = occlusionCulled ? renderCtx.visibleDrawDescs : renderCtx.instancedDrawDescs;
+			const auto& instanceBuffer =
+			    occlusionCulled ? renderCtx.visibleInstanceUniformBuffer : renderCtx.instanceUniformBuffer;
 
 			// Instance meshes
-			for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
+			for (const auto& [meshId, placers] : drawDescs)
 			{
 				auto mesh = meshManager.Handle(meshId);
 
-				submitDesc.instanceBuffer = &renderCtx.instanceUniformBuffer;
+				submitDesc.instanceBuffer = &instanceBuffer;
 				submitDesc.instanceStart = placers.offset;
 				submitDesc.instanceCount = placers.count;
 				if (mesh->IsBoned())
@@ -651,8 +711,8 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 				}
 				if (renderCtx.boundingBox)
 				{
-					const auto boundBoxOffset = static_cast<uint32_t>(renderCtx.instanceUniforms.size() / 2);
-					const auto boundBoxCount = static_cast<uint32_t>(renderCtx.instanceUniforms.size() / 2);
+					const auto boundBoxOffset = static_cast<uint32_t>(renderCtx.instanceUniforms.Front().size() / 2);
+					const auto boundBoxCount = static_cast<uint32_t>(renderCtx.instanceUniforms.Front().size() / 2);
 					renderCtx.boundingBox->GetVertexBuffer().Bind();
 					bgfx::setInstanceDataBuffer(renderCtx.instanceUniformBuffer, boundBoxOffset, boundBoxCount);
 					bgfx::setState(BGFX_STATE_DEFAULT | BGFX_STATE_PT_LINES);
@@ -693,9 +753,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 					    glm::vec4 u_sampleRect(sprite.uvExtent, sprite.uvMin);
 
 					    bgfx::setTransform(glm::value_ptr(modelMatrix));
-					    spriteShader->SetUniformValue("u_sampleRect", glm::value_ptr(u_sampleRect));
-					    spriteShader->SetUniformValue("u_tint", glm::value_ptr(sprite.tint));
-					    spriteShader->SetTextureSampler("s_diffuse", 0, sprite.texture);
+					    spriteShader->SetUniformValue(Uniform::SampleRect, glm::value_ptr(u_sampleRect));
+					    spriteShader->SetUniformValue(Uniform::Tint, glm::value_ptr(sprite.tint));
+					    spriteShader->SetTextureSampler(Uniform::Diffuse, 0, sprite.texture);
 
 					    _plane->GetVertexBuffer().Bind();
 
@@ -772,6 +832,7 @@ void Renderer::Frame()
 {
 	// Advance to next frame. Process submitted rendering primitives.
 	bgfx::frame();
+	graphics::UploadManager::OnFrame();
 }
 
 void Renderer::RequestScreenshot(const std::filesystem::path& filepath)
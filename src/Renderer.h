@@ -12,10 +12,12 @@
 #include <cstdint>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <memory>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include <SDL.h>
@@ -100,7 +102,10 @@ class Renderer
 	};
 
 	Renderer() = delete;
-	explicit Renderer(const GameWindow* window, bgfx::RendererType::Enum rendererType, bool vsync);
+	/// When \p renderThread is set, bgfx renders on a thread owned by the renderer and the calling thread only submits.
+	/// Otherwise bgfx picks on its own whether it spawns its render thread. It is ignored on macOS, where only the main
+	/// thread may present.
+	explicit Renderer(const GameWindow* window, bgfx::RendererType::Enum rendererType, bool vsync, bool renderThread);
 
 	virtual ~Renderer();
 
@@ -117,6 +122,8 @@ class Renderer
 
 	void Reset(uint16_t width, uint16_t height) const;
 
+	[[nodiscard]] bool HasRenderThread() const { return _renderThread.joinable(); }
+
 private:
 	void DrawFootprintPass(const DrawSceneDesc& drawDesc) const;
 	void DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc, bool preserveState) const;
@@ -125,6 +132,9 @@ class Renderer
 	std::unique_ptr<graphics::ShaderManager> _shaderManager;
 	std::unique_ptr<BgfxCallback> _bgfxCallback;
 	uint32_t _bgfxReset;
+	std::thread _renderThread;
+	/// Lets the render thread give up if bgfx never gets initialised
+	std::atomic<bool> _stopRenderThread {false};
 
 	std::unique_ptr<graphics::Mesh> _debugCross;
 	std::unique_ptr<graphics::Mesh> _plane;
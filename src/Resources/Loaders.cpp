@@ -41,22 +41,19 @@ L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem:
 
 	if (pathExt == ".l3d")
 	{
-#if __ANDROID__
-		mesh->LoadFromBuffer(Locator::filesystem::value().ReadAll(path));
-#else
-		if (!mesh->LoadFromFile(path))
+		// Viewed in place in the mapped file, which is only read while loading
+		auto stream = Locator::filesystem::value().Open(path, Stream::Mode::Read);
+		if (!mesh->LoadFromBuffer(stream->View(0, stream->Size())))
 		{
 			throw std::runtime_error("Unable to load mesh");
 		}
-#endif
 	}
 	else if (pathExt == ".zzz")
 	{
 		auto stream = Locator::filesystem::value().Open(path, Stream::Mode::Read);
 		uint32_t decompressedSize = 0;
 		stream->Read(&decompressedSize);
-		auto buffer = std::vector<uint8_t>(stream->Size() - sizeof(decompressedSize));
-		stream->Read(buffer.data(), buffer.size());
+		const auto buffer = stream->View(sizeof(decompressedSize), stream->Size() - sizeof(decompressedSize));
 		auto decompressedBuffer = zip::Inflate(buffer, decompressedSize);
 		if (!mesh->LoadFromBuffer(decompressedBuffer))
 		{
@@ -171,14 +168,19 @@ LevelLoader::result_type LevelLoader::operator()(FromDiskTag, const std::filesys
 	return std::make_shared<Level>(Level::ParseLevel(path, landType));
 }
 
+LevelLoader::result_type LevelLoader::operator()(FromCatalogueTag, const LevelCatalogue::Entry& entry) const
+{
+	return std::make_shared<Level>(LevelCatalogue::ToLevel(entry));
+}
+
 CreatureMindLoader::result_type CreatureMindLoader::operator()(FromDiskTag, const std::filesystem::path& /*unused*/) const
 {
 	return std::make_shared<creature::CreatureMind>();
 }
 
-SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromBufferTag,
+SoundLoader::result_type SoundLoader::operator()(FromDiskTag, const std::filesystem::path& packPath,
                                                  const pack::AudioBankSampleHeader& header,
-                                                 const std::vector<std::vector<uint8_t>>& buffer) const
+                                                 std::vector<audio::SoundSegment> segments) const
 {
 	auto sound = std::make_shared<audio::Sound>();
 	// Let's clean up the names as they're very difficult to read from the debug GUI
@@ -190,6 +192,12 @@ SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromB
 	sound->pitch = header.pitch;
 	sound->pitchDeviation = header.pitchDeviation;
 	sound->playType = static_cast<audio::PlayType>(header.loopType);
-	sound->buffer = buffer;
+	sound->channelLayout = audio::ChannelLayout::Mono;
+	// Only known once decoded, which is deferred until the sound is first played
+	sound->bufferId = 0;
+	sound->duration = -1.0f;
+	sound->sizeInBytes = 0;
+	sound->packPath = packPath;
+	sound->segments = std::move(segments);
 	return sound;
 }
@@ -19,6 +19,7 @@
 #include "Audio/Sound.h"
 #include "Creature/CreatureMind.h"
 #include "Level.h"
+#include "LevelCatalogue.h"
 
 namespace openblack::resources
 {
@@ -62,6 +63,11 @@ struct L3DAnimLoader final: BaseLoader<L3DAnim>
 
 struct LevelLoader final: BaseLoader<Level>
 {
+	struct FromCatalogueTag
+	{
+	};
+
+	[[nodiscard]] result_type operator()(FromCatalogueTag, const LevelCatalogue::Entry& entry) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path, Level::LandType landType) const;
 };
 
@@ -72,7 +78,8 @@ struct CreatureMindLoader final: BaseLoader<creature::CreatureMind>
 
 struct SoundLoader final: BaseLoader<audio::Sound>
 {
-	[[nodiscard]] result_type operator()(FromBufferTag, const pack::AudioBankSampleHeader& header,
-	                                     const std::vector<std::vector<uint8_t>>& buffer) const;
+	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& packPath,
+	                                     const pack::AudioBankSampleHeader& header,
+	                                     std::vector<audio::SoundSegment> segments) const;
 };
 } // namespace openblack::resources
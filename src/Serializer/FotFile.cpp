@@ -9,6 +9,12 @@
 
 #include "FotFile.h"
 
+#include <cassert>
+
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
 #include <spdlog/spdlog.h>
 
 #include "3D/LandIslandInterface.h"
@@ -31,53 +37,64 @@ void FotFile::Load(const std::filesystem::path& path)
 {
 	auto stream = Locator::filesystem::value().Open(path, Stream::Mode::Read);
 	serializer::GameThingSerializer serializer(*stream);
-	auto footpathLinkSaves = serializer.DeserializeList<serializer::GameThingSerializer::FootpathLinkSave>();
-	auto footpaths = serializer.DeserializeList<serializer::GameThingSerializer::Footpath>();
+	const auto footpathLinkSaves = serializer.DeserializeList<serializer::GameThingSerializer::FootpathLinkSave>();
+	const auto footpaths = serializer.DeserializeList<serializer::GameThingSerializer::Footpath>();
 	auto& registry = Locator::entitiesRegistry::value();
 	const auto& island = Locator::terrainSystem::value();
 
-	// Keep track of footpath entities in order to associate them to the footpath link saves later
-	std::vector<ecs::components::Footpath::Id> footpathEntities;
+	const auto toPosition = [](const serializer::MapCoords& coords) {
+		return glm::vec3 {
+		    10.0f * coords.x / static_cast<float>(0xFFFF),
+		    coords.altitude,
+		    10.0f * coords.z / static_cast<float>(0xFFFF),
+		};
+	};
 
-	for (const auto& footpath : footpaths)
+	std::vector<entt::entity> footpathEntities(footpaths.size());
+	registry.Create(footpathEntities.begin(), footpathEntities.end());
+	std::vector<ecs::components::Footpath> footpathComponents(footpaths.size());
+	// Links refer to the footpaths by their id in the file
+	std::unordered_map<uint32_t, ecs::components::Footpath::Id> footpathIds;
+	footpathIds.reserve(footpaths.size());
+	for (size_t i = 0; i < footpaths.size(); ++i)
 	{
-		const auto entity = registry.Create();
-		auto& footpathEntt = registry.Assign<ecs::components::Footpath>(entity);
-		footpathEntt.nodes.reserve(footpath.nodes.size());
-		for (const auto& node : footpath.nodes)
+		auto& nodes = footpathComponents[i].nodes;
+		nodes.reserve(footpaths[i]->nodes.size());
+		for (const auto* node : footpaths[i]->nodes)
 		{
-			glm::vec3 position = glm::vec3 {
-			    10.0f * node.coords.x / static_cast<float>(0xFFFF),
-			    node.coords.altitude,
-			    10.0f * node.coords.z / static_cast<float>(0xFFFF),
-			};
+			auto position = toPosition(node->coords);
 
 			// This bit is mainly for visualization, it could be that using these offsets causes uses for path planning
 			// if that is the case, this bit should be moved to rendering code
 			position.y += island.GetHeightAt({position.x, position.z});
 
-			footpathEntt.nodes.push_back({position});
+			nodes.push_back({position});
 		}
-		footpathEntities.push_back(static_cast<ecs::components::Footpath::Id>(entity));
+		footpathIds.emplace(footpaths[i]->id, static_cast<ecs::components::Footpath::Id>(footpathEntities[i]));
 	}
+	registry.Insert<ecs::components::Footpath>(footpathEntities.begin(), footpathEntities.end(),
+	                                           std::make_move_iterator(footpathComponents.begin()));
 
-	for (const auto& save : footpathLinkSaves)
+	std::vector<entt::entity> linkEntities(footpathLinkSaves.size());
+	registry.Create(linkEntities.begin(), linkEntities.end());
+	std::vector<ecs::components::FootpathLink> linkComponents(footpathLinkSaves.size());
+	for (size_t i = 0; i < footpathLinkSaves.size(); ++i)
 	{
-		std::vector<ecs::components::Footpath::Id> linkFootpathEntities;
-		for (const auto& footpath : save.link.footpaths)
+		const auto& save = *footpathLinkSaves[i];
+		auto& link = linkComponents[i];
+		link.position = toPosition(save.coords);
+		link.footpaths.reserve(save.link->footpaths.size());
+		for (const auto* footpath : save.link->footpaths)
 		{
-			// Save links have duplicates to entries in footpaths
-			const auto footpathListItr = std::find(footpaths.cbegin(), footpaths.cend(), footpath);
-			assert(footpathListItr != footpaths.cend());
-			const auto footpathIndex = std::distance(footpaths.cbegin(), footpathListItr);
-			linkFootpathEntities.push_back(footpathEntities[footpathIndex]);
+			// Save links refer to the same things as the footpath list
+			const auto footpathId = footpathIds.find(footpath->id);
+			assert(footpathId != footpathIds.end());
+			if (footpathId != footpathIds.end())
+			{
+				link.footpaths.push_back(footpathId->second);
+			}
 		}
-		glm::vec3 position = glm::vec3 {
-		    10.0f * save.coords.x / static_cast<float>(0xFFFF),
-		    save.coords.altitude,
-		    10.0f * save.coords.z / static_cast<float>(0xFFFF),
-		};
-		const auto entity = registry.Create();
-		registry.Assign<ecs::components::FootpathLink>(entity, position, std::move(linkFootpathEntities));
 	}
+	registry.Insert<ecs::components::FootpathLink>(linkEntities.begin(), linkEntities.end(),
+	                                               std::make_move_iterator(linkComponents.begin()));
 }
@@ -11,6 +11,8 @@
 
 #include <cassert>
 
+#include <array>
+
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
@@ -34,11 +36,31 @@ template <>
 constexpr GameThingType openblack::serializer::k_GameThingTypeEnum<GameThingSerializer::FootpathLinkSave> =
     GameThingType::FootpathLinkSave;
 
+namespace
+{
+using Allocator = GameThingSerializer::GameThing* (GameThingSerializer::*)();
+} // namespace
+
 GameThingSerializer::GameThingSerializer(Stream& stream)
     : _stream(stream)
 {
 }
 
+GameThingSerializer::~GameThingSerializer()
+{
+	// The arena releases the memory at once, the things only need to be destroyed
+	for (auto* thing : _things)
+	{
+		std::destroy_at(thing);
+	}
+}
+
+template <typename T>
+GameThingSerializer::GameThing* GameThingSerializer::Allocate()
+{
+	return new (_arena.allocate(sizeof(T), alignof(T))) T();
+}
+
 template <typename T>
 T GameThingSerializer::ReadValue()
 {
@@ -59,12 +81,21 @@ void GameThingSerializer::ReadChecksum()
 	}
 }
 
-std::shared_ptr<GameThingSerializer::GameThing> GameThingSerializer::DeserializeOne(std::optional<GameThingType> requiredType)
+GameThingSerializer::GameThing* GameThingSerializer::DeserializeOne(std::optional<GameThingType> requiredType)
 {
+	// Indexed by type, new types of things only need an entry here
+	static const std::array<Allocator, 5> k_Allocators = {
+	    nullptr,                                          // Invalid
+	    &GameThingSerializer::Allocate<Footpath>,         // Footpath
+	    &GameThingSerializer::Allocate<FootpathLink>,     // FootpathLink
+	    &GameThingSerializer::Allocate<FootpathNode>,     // FootpathNode
+	    &GameThingSerializer::Allocate<FootpathLinkSave>, // FootpathLinkSave
+	};
+
 	[[maybe_unused]] const auto offset = _stream.Position();
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "offset={}", offset);
 	auto index = ReadValue<uint32_t>();
-	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "index={}, len={}", index, _cache.size());
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "index={}, len={}", index, _things.size());
 
 	if (index == 0)
 	{
@@ -72,7 +103,7 @@ std::shared_ptr<GameThingSerializer::GameThing> GameThingSerializer::Deserialize
 		return nullptr;
 	}
 
-	if (index == _cache.size() + 1)
+	if (index == _things.size() + 1)
 	{
 		auto type = ReadValue<GameThingType>();
 		if (type != requiredType.value_or(type))
@@ -85,27 +116,17 @@ std::shared_ptr<GameThingSerializer::GameThing> GameThingSerializer::Deserialize
 		ReadChecksum();
 		// TODO(#479): validate checksum by adding up first byte of every read
 
-		std::shared_ptr<GameThing> thing;
-
-		switch (type)
+		const auto typeIndex = static_cast<uint32_t>(type);
+		if (typeIndex >= k_Allocators.size() || k_Allocators[typeIndex] == nullptr)
 		{
-		case GameThingType::Footpath:
-			thing = std::make_unique<Footpath>();
-			break;
-		case GameThingType::FootpathLink:
-			thing = std::make_unique<FootpathLink>();
-			break;
-		case GameThingType::FootpathNode:
-			thing = std::make_unique<FootpathNode>();
-			break;
-		case GameThingType::FootpathLinkSave:
-			thing = std::make_unique<FootpathLinkSave>();
-			break;
-		default:
-			assert(false);
+			throw std::runtime_error(fmt::format("Unsupported GameThing type {} at 0x{:08x}", typeIndex,
+			                                     _stream.Position() - sizeof(GameThingType)));
 		}
 
-		_cache.push_back(thing);
+		auto* thing = (this->*k_Allocators[typeIndex])();
+		thing->id = index;
+		thing->type = type;
+		_things.push_back(thing);
 
 		if (!thing->Deserialize(*this))
 		{
@@ -116,28 +137,28 @@ std::shared_ptr<GameThingSerializer::GameThing> GameThingSerializer::Deserialize
 
 		return thing;
 	}
-	if (index > _cache.size())
+	if (index > _things.size())
 	{
 		assert(false); // weird case
 		return nullptr;
 	}
 	// referring to a previously seen entry
-	return _cache[index - 1];
+	return _things[index - 1];
 }
 
 template <typename T>
-std::vector<T> GameThingSerializer::DeserializeList()
+std::vector<const T*> GameThingSerializer::DeserializeList()
 {
 	auto count = ReadValue<uint32_t>();
-	std::vector<T> list;
+	std::vector<const T*> list;
 	list.reserve(count);
 	for (uint32_t i = 0; i < count; ++i)
 	{
 		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "i={}", i);
-		auto ptr = std::dynamic_pointer_cast<T>(DeserializeOne(k_GameThingTypeEnum<T>));
-		if (ptr)
+		const auto* thing = DeserializeOne(k_GameThingTypeEnum<T>);
+		if (thing != nullptr && thing->type == k_GameThingTypeEnum<T>)
 		{
-			list.push_back(*ptr);
+			list.push_back(static_cast<const T*>(thing));
 		}
 	}
 	return list;
@@ -150,16 +171,6 @@ bool GameThingSerializer::GameThing::Deserialize(GameThingSerializer& deserializ
 	return true;
 }
 
-bool GameThingSerializer::GameThing::operator==(const GameThingSerializer::GameThing& rhs) const
-{
-	return unknown1 == rhs.unknown1 && unknown2 == rhs.unknown2;
-}
-
-bool GameThingSerializer::GameThing::operator!=(const GameThingSerializer::GameThing& rhs) const
-{
-	return !(*this == rhs);
-}
-
 bool GameThingSerializer::Footpath::Deserialize(GameThingSerializer& deserializer)
 {
 	GameThing::Deserialize(deserializer);
@@ -168,17 +179,6 @@ bool GameThingSerializer::Footpath::Deserialize(GameThingSerializer& deserialize
 	return true;
 }
 
-bool GameThingSerializer::Footpath::operator==(const GameThingSerializer::Footpath& rhs) const
-{
-	return static_cast<const GameThing&>(*this) == static_cast<const GameThing&>(rhs) && nodes == rhs.nodes &&
-	       unknown == rhs.unknown;
-}
-
-bool GameThingSerializer::Footpath::operator!=(const GameThingSerializer::Footpath& rhs) const
-{
-	return !(*this == rhs);
-}
-
 bool GameThingSerializer::FootpathLink::Deserialize(GameThingSerializer& deserializer)
 {
 	GameThing::Deserialize(deserializer);
@@ -194,30 +194,19 @@ bool GameThingSerializer::FootpathNode::Deserialize(GameThingSerializer& deseria
 	return true;
 }
 
-bool GameThingSerializer::FootpathNode::operator==(const GameThingSerializer::FootpathNode& rhs) const
-{
-	return static_cast<const GameThing&>(*this) == static_cast<const GameThing&>(rhs) && coords == rhs.coords &&
-	       unknown == rhs.unknown;
-}
-
-bool GameThingSerializer::FootpathNode::operator!=(const GameThingSerializer::FootpathNode& rhs) const
-{
-	return !(*this == rhs);
-}
-
 bool GameThingSerializer::FootpathLinkSave::Deserialize(GameThingSerializer& deserializer)
 {
 	GameThing::Deserialize(deserializer);
 	coords = deserializer.ReadValue<MapCoords>();
-	auto thing = deserializer.DeserializeOne(GameThingType::FootpathLink);
-	if (thing)
+	const auto* thing = deserializer.DeserializeOne(GameThingType::FootpathLink);
+	if (thing != nullptr && thing->type == GameThingType::FootpathLink)
 	{
-		assert(dynamic_cast<FootpathLink*>(thing.get()));
-		link = *dynamic_cast<FootpathLink*>(thing.get());
+		link = static_cast<const FootpathLink*>(thing);
 		return true;
 	}
 	return false;
 }
 
 // Force initialization of template function
-template std::vector<GameThingSerializer::FootpathLinkSave> GameThingSerializer::DeserializeList();
+template std::vector<const GameThingSerializer::FootpathLinkSave*> GameThingSerializer::DeserializeList();
+template std::vector<const GameThingSerializer::Footpath*> GameThingSerializer::DeserializeList();
@@ -11,7 +11,7 @@
 
 #include <cstdint>
 
-#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -38,19 +38,24 @@ enum class GameThingType : uint32_t
 template <typename T>
 static const GameThingType k_GameThingTypeEnum = GameThingType::Invalid;
 
+/// Reads the game things of a file, such as a .fot or a saved game.
+///
+/// Things are allocated in an arena owned by the serializer and refer to each other by pointer, they stay valid until
+/// the serializer is destroyed. Each thing is stored once in the file, later references to it use its index.
 class GameThingSerializer
 {
 public:
 	struct GameThing
 	{
+		/// Index of the thing in the file, unique per file
+		uint32_t id;
+		GameThingType type;
 		uint32_t unknown1;
 		uint8_t unknown2;
 
 		virtual ~GameThing() = default;
 
 		virtual bool Deserialize(GameThingSerializer& deserializer);
-		bool operator==(const GameThing& rhs) const;
-		bool operator!=(const GameThing& rhs) const;
 	};
 
 	struct FootpathNode final: GameThing
@@ -59,23 +64,19 @@ class GameThingSerializer
 		uint8_t unknown;
 
 		bool Deserialize(GameThingSerializer& deserializer) override;
-		bool operator==(const FootpathNode& rhs) const;
-		bool operator!=(const FootpathNode& rhs) const;
 	};
 
 	struct Footpath final: GameThing
 	{
-		std::vector<FootpathNode> nodes;
+		std::vector<const FootpathNode*> nodes;
 		uint32_t unknown;
 
 		bool Deserialize(GameThingSerializer& deserializer) override;
-		bool operator==(const Footpath& rhs) const;
-		bool operator!=(const Footpath& rhs) const;
 	};
 
 	struct FootpathLink final: GameThing
 	{
-		std::vector<Footpath> footpaths;
+		std::vector<const Footpath*> footpaths;
 
 		bool Deserialize(GameThingSerializer& deserializer) override;
 	};
@@ -83,25 +84,33 @@ class GameThingSerializer
 	struct FootpathLinkSave final: GameThing
 	{
 		MapCoords coords;
-		FootpathLink link;
+		const FootpathLink* link;
 
 		bool Deserialize(GameThingSerializer& deserializer) override;
 	};
 
 	explicit GameThingSerializer(filesystem::Stream& stream);
+	~GameThingSerializer();
 
 	template <typename T>
 	T ReadValue();
 
 	void ReadChecksum();
 
-	std::shared_ptr<GameThing> DeserializeOne(std::optional<GameThingType> requiredType = std::nullopt);
+	GameThing* DeserializeOne(std::optional<GameThingType> requiredType = std::nullopt);
 	template <typename T>
-	std::vector<T> DeserializeList();
+	std::vector<const T*> DeserializeList();
+
+	[[nodiscard]] size_t GetThingCount() const { return _things.size(); }
 
 private:
+	template <typename T>
+	GameThing* Allocate();
+
 	filesystem::Stream& _stream;
 	uint32_t _checkSum {0};
-	std::vector<std::shared_ptr<GameThing>> _cache;
+	std::pmr::monotonic_buffer_resource _arena;
+	/// Indexed by id - 1
+	std::vector<GameThing*> _things;
 };
 } // namespace openblack::serializer
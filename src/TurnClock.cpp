@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TurnClock.h"
+
+#include <algorithm>
+
+using namespace openblack;
+
+TurnClock::TurnClock(Duration turnDuration)
+    : _turnDuration(turnDuration)
+{
+}
+
+TurnClock::Duration TurnClock::GetTurnDuration() const
+{
+	return std::max(std::chrono::duration_cast<Duration>(_turnDuration * _speed), Duration(1));
+}
+
+uint32_t TurnClock::Advance(Duration elapsed)
+{
+	if (_fastForwardTurns != 0)
+	{
+		_accumulated = Duration::zero();
+		return _fastForwardTurns;
+	}
+
+	const auto turnDuration = GetTurnDuration();
+	_accumulated = std::min(_accumulated + elapsed, turnDuration * std::max(_maxTurnsPerFrame, 1u));
+	return static_cast<uint32_t>(_accumulated / turnDuration);
+}
+
+void TurnClock::ConsumeTurn()
+{
+	_accumulated = std::max(_accumulated - GetTurnDuration(), Duration::zero());
+}
+
+float TurnClock::GetProgress() const
+{
+	// Fast forwarding owes no time, the last turn is the one to draw
+	if (_fastForwardTurns != 0)
+	{
+		return 1.0f;
+	}
+	const auto progress = std::chrono::duration<float>(_accumulated) / std::chrono::duration<float>(GetTurnDuration());
+	return std::clamp(progress, 0.0f, 1.0f);
+}
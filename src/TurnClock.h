@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+
+namespace openblack
+{
+/// Decides how many turns of fixed length the game logic runs each frame.
+///
+/// The time passed between frames is accumulated and each turn run takes its duration off. Slow frames are followed by
+/// several turns, up to a limit past which the game slows down rather than owing more turns than it can run. Fast
+/// forwarding runs a set number of turns every frame, whatever the time.
+class TurnClock
+{
+public:
+	using Duration = std::chrono::steady_clock::duration;
+
+	static constexpr uint32_t k_DefaultMaxTurnsPerFrame = 5;
+	static constexpr auto k_DefaultFrameBudget = std::chrono::milliseconds(50);
+
+	explicit TurnClock(Duration turnDuration);
+
+	/// Turn duration multiplier, higher is slower
+	void SetSpeed(float multiplier) { _speed = multiplier; }
+	[[nodiscard]] float GetSpeed() const { return _speed; }
+	/// Duration of a turn at the current speed
+	[[nodiscard]] Duration GetTurnDuration() const;
+
+	void SetMaxTurnsPerFrame(uint32_t turns) { _maxTurnsPerFrame = turns; }
+	[[nodiscard]] uint32_t GetMaxTurnsPerFrame() const { return _maxTurnsPerFrame; }
+	/// Turns run every frame whatever the time, 0 to follow the time
+	void SetFastForward(uint32_t turnsPerFrame) { _fastForwardTurns = turnsPerFrame; }
+	[[nodiscard]] uint32_t GetFastForward() const { return _fastForwardTurns; }
+	/// Time the turns of a frame may take, the turns left wait for the next frame
+	void SetFrameBudget(Duration budget) { _frameBudget = budget; }
+	[[nodiscard]] Duration GetFrameBudget() const { return _frameBudget; }
+
+	/// Forget the time owed, for when the game starts
+	void Reset() { _accumulated = Duration::zero(); }
+	/// Add the time passed since the last frame, returns the number of turns due
+	[[nodiscard]] uint32_t Advance(Duration elapsed);
+	/// Take a turn which was run off the time owed
+	void ConsumeTurn();
+	/// Time owed to the game logic, a turn or more means it is running behind
+	[[nodiscard]] Duration GetLag() const { return _accumulated; }
+	/// How far into the next turn the time owed is, from 0 to 1, for drawing between the last two turns
+	[[nodiscard]] float GetProgress() const;
+
+private:
+	const Duration _turnDuration;
+	float _speed {1.0f};
+	uint32_t _maxTurnsPerFrame {k_DefaultMaxTurnsPerFrame};
+	uint32_t _fastForwardTurns {0};
+	Duration _frameBudget {k_DefaultFrameBudget};
+	Duration _accumulated {Duration::zero()};
+};
+} // namespace openblack
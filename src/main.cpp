@@ -50,6 +50,11 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		("u,ui-scale", "Scaling of the GUI", cxxopts::value<float>()->default_value("1.0"))
 		("s,start-level", "Level that is loaded at start-up", cxxopts::value<std::string>()->default_value("Land1.txt"))
 		("V,vsync", "Enable Vertical Sync.")
+		("fps-limit", "Maximum frames per second, 0 for no limit.", cxxopts::value<uint32_t>()->default_value("0"))
+		("background-fps-limit", "Maximum frames per second while the window is hidden or unfocused, 0 for the fps limit.", cxxopts::value<uint32_t>()->default_value("10"))
+		("render-thread", "Render on a dedicated thread while the game thread only submits. Not supported on macOS.")
+		("compressed-sky", "Upload the sky textures as BC1 with mips, encoded once and cached in the user cache directory.")
+		("sky-residency", "Only keep the sky textures blended at the current time and alignment on the GPU.")
 		("m,window-mode", "Which mode to run window.", cxxopts::value<std::string>()->default_value("windowed"))
 		("b,backend-type", "Which backend to use for rendering.", cxxopts::value<std::string>())
 		("n,num-frames-to-simulate", "Number of frames to simulate before quitting.", cxxopts::value<uint32_t>()->default_value("0"))
@@ -186,6 +191,11 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		args.windowHeight = result["height"].as<uint16_t>();
 		args.scale = result["ui-scale"].as<float>();
 		args.vsync = result["vsync"].as<bool>();
+		args.frameRateLimit = result["fps-limit"].as<uint32_t>();
+		args.backgroundFrameRateLimit = result["background-fps-limit"].as<uint32_t>();
+		args.renderThread = result["render-thread"].as<bool>();
+		args.skyCompression = result["compressed-sky"].as<bool>();
+		args.skyResidency = result["sky-residency"].as<bool>();
 		args.displayMode = displayMode;
 		args.rendererType = rendererType;
 		args.numFramesToSimulate = result["num-frames-to-simulate"].as<uint32_t>();
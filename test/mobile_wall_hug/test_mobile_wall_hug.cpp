@@ -11,6 +11,8 @@
 #include <fstream>
 #include <tuple>
 
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Mobile.h>
 #include <ECS/Components/Transform.h>
 #include <ECS/Components/Villager.h>
 #include <ECS/Components/WallHug.h>
@@ -221,18 +223,29 @@ class MobileWallHugWalks: public ::testing::Test
 		map.Rebuild();
 		registry.Each<ecs::components::WallHug>([&registry, this](entt::entity entity, ecs::components::WallHug& wallHug) {
 			using namespace openblack::ecs::components;
-			registry.Assign<MoveStateLinearTag>(entity);
+			auto& movement = registry.Get<WallHugState>(entity);
+			movement.state = MoveState::Linear;
+			movement.clockwise = MoveStateClockwise::Undefined;
+			movement.stepGoal = {};
 			wallHug.speed = _expectedStates[0].speed;
 			wallHug.step = _expectedStates[0].step;
 			wallHug.goal = _expectedStates[0].goal;
 		});
 
+		// Movement state changes are done in place, no component is added or removed while walking. The tag component
+		// layout swapped a tag per state change, and added or removed the obstacle reference as it changed.
+		PoolMutations mutations;
+		ConnectPoolMutations<ecs::components::WallHugState, ecs::components::WallHug, ecs::components::Transform,
+		                     ecs::components::Fixed, ecs::components::Mobile>(registry, mutations);
+		uint32_t tagLayoutMutations = 0;
+
 		for (uint32_t turn = _startTurn; turn < _lastTurn; ++turn)
 		{
 			const auto& villagerComp = registry.Get<ecs::components::Villager>(_villagerEntt);
 			const auto& villagerTransform = registry.Get<ecs::components::Transform>(_villagerEntt);
 			const auto& villagerWallhug = registry.Get<ecs::components::WallHug>(_villagerEntt);
-			bool villagerHasObstacle = registry.AnyOf<ecs::components::WallHugObjectReference>(_villagerEntt);
+			const auto& villagerState = registry.Get<ecs::components::WallHugState>(_villagerEntt);
+			bool villagerHasObstacle = villagerState.reference.has_value();
 			const auto& state = _expectedStates[turn - _startTurn];
 			const auto msg = std::string("on turn ") + std::to_string(turn) + " in range " + std::to_string(_startTurn) + "-" +
 			                 std::to_string(_lastTurn);
@@ -247,8 +260,7 @@ class MobileWallHugWalks: public ::testing::Test
 			case MOVE_STATE_LINEAR_CW:
 			case MOVE_STATE_LINEAR_CCW:
 			{
-				ASSERT_TRUE(registry.AllOf<ecs::components::MoveStateLinearTag>(_villagerEntt)) << msg;
-				const auto& villagerState = registry.Get<ecs::components::MoveStateLinearTag>(_villagerEntt);
+				ASSERT_EQ(villagerState.state, ecs::components::MoveState::Linear) << msg;
 				if (state.move_state == MOVE_STATE_LINEAR)
 				{
 					ASSERT_EQ(villagerState.clockwise, ecs::components::MoveStateClockwise::Undefined) << msg;
@@ -266,8 +278,7 @@ class MobileWallHugWalks: public ::testing::Test
 			case MOVE_STATE_ORBIT_CW:
 			case MOVE_STATE_ORBIT_CCW:
 			{
-				ASSERT_TRUE(registry.AllOf<ecs::components::MoveStateOrbitTag>(_villagerEntt)) << msg;
-				const auto& villagerState = registry.Get<ecs::components::MoveStateOrbitTag>(_villagerEntt);
+				ASSERT_EQ(villagerState.state, ecs::components::MoveState::Orbit) << msg;
 				if (state.move_state == MOVE_STATE_ORBIT_CW)
 				{
 					ASSERT_EQ(villagerState.clockwise, ecs::components::MoveStateClockwise::Clockwise) << msg;
@@ -281,8 +292,7 @@ class MobileWallHugWalks: public ::testing::Test
 			case MOVE_STATE_EXIT_CIRCLE_CW:
 			case MOVE_STATE_EXIT_CIRCLE_CCW:
 			{
-				ASSERT_TRUE(registry.AllOf<ecs::components::MoveStateExitCircleTag>(_villagerEntt)) << msg;
-				const auto& villagerState = registry.Get<ecs::components::MoveStateExitCircleTag>(_villagerEntt);
+				ASSERT_EQ(villagerState.state, ecs::components::MoveState::ExitCircle) << msg;
 				if (state.move_state == MOVE_STATE_EXIT_CIRCLE_CW)
 				{
 					ASSERT_EQ(villagerState.clockwise, ecs::components::MoveStateClockwise::Clockwise) << msg;
@@ -294,13 +304,13 @@ class MobileWallHugWalks: public ::testing::Test
 			}
 			break;
 			case MOVE_STATE_ARRIVED:
-				ASSERT_TRUE(registry.AllOf<ecs::components::MoveStateArrivedTag>(_villagerEntt)) << msg;
+				ASSERT_EQ(villagerState.state, ecs::components::MoveState::Arrived) << msg;
 				break;
 			case MOVE_STATE_FINAL_STEP:
-				ASSERT_TRUE(registry.AllOf<ecs::components::MoveStateFinalStepTag>(_villagerEntt)) << msg;
+				ASSERT_EQ(villagerState.state, ecs::components::MoveState::FinalStep) << msg;
 				break;
 			case MOVE_STATE_STEP_THROUGH:
-				ASSERT_TRUE(registry.AllOf<ecs::components::MoveStateStepThroughTag>(_villagerEntt)) << msg;
+				ASSERT_EQ(villagerState.state, ecs::components::MoveState::StepThrough) << msg;
 				break;
 			}
 			ASSERT_FLOAT_EQ(villagerTransform.position.x, state.pos.x) << msg;
@@ -316,12 +326,53 @@ class MobileWallHugWalks: public ::testing::Test
 			if (state.circle_hug_info.turns_to_obstacle != 0xFF || state.circle_hug_info.obj_index.has_value())
 			{
 				ASSERT_TRUE(villagerHasObstacle) << msg;
-				const auto& ref = registry.Get<ecs::components::WallHugObjectReference>(_villagerEntt);
+				const auto& ref = *villagerState.reference;
 				// ASSERT_EQ(ref.stepsAway, state.circle_hug_info.turns_to_obstacle) << msg;
 			}
 
+			const auto previousState = villagerState.state;
+			const auto previousClockwise = villagerState.clockwise;
 			ASSERT_NO_THROW(Locator::pathfindingSystem::value().Update()) << msg;
+			// Sorting the states by the update may have moved the component
+			const auto& updatedState = registry.Get<ecs::components::WallHugState>(_villagerEntt);
+			if (updatedState.state != previousState || updatedState.clockwise != previousClockwise)
+			{
+				tagLayoutMutations += 2;
+			}
+			if (updatedState.reference.has_value() != villagerHasObstacle)
+			{
+				++tagLayoutMutations;
+			}
 		}
+
+		DisconnectPoolMutations<ecs::components::WallHugState, ecs::components::WallHug, ecs::components::Transform,
+		                        ecs::components::Fixed, ecs::components::Mobile>(registry, mutations);
+		const auto turns = _lastTurn - _startTurn;
+		RecordProperty("turns", std::to_string(turns));
+		RecordProperty("pool_mutations", std::to_string(mutations.count));
+		RecordProperty("tag_layout_pool_mutations", std::to_string(tagLayoutMutations));
+		ASSERT_EQ(mutations.count, 0u);
+	}
+
+	/// Counts the components constructed and destroyed
+	struct PoolMutations
+	{
+		void Count(entt::registry& /*unused*/, entt::entity /*unused*/) { ++count; }
+		uint32_t count {0};
+	};
+
+	template <typename... Components>
+	static void ConnectPoolMutations(ecs::Registry& registry, PoolMutations& mutations)
+	{
+		(registry.OnConstruct<Components>().template connect<&PoolMutations::Count>(mutations), ...);
+		(registry.OnDestroy<Components>().template connect<&PoolMutations::Count>(mutations), ...);
+	}
+
+	template <typename... Components>
+	static void DisconnectPoolMutations(ecs::Registry& registry, PoolMutations& mutations)
+	{
+		(registry.OnConstruct<Components>().disconnect(&mutations), ...);
+		(registry.OnDestroy<Components>().disconnect(&mutations), ...);
 	}
 
 	static constexpr std::string_view k_ScenarioPath = TEST_BINARY_DIR "/mobile_wall_hug/scenarios";
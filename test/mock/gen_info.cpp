@@ -88,6 +88,15 @@ int main(int argc, char* argv[]) noexcept
 	std::memcpy(constants.abode[12].debugString.data(), townCentreDebugName.c_str(), townCentreDebugName.length());
 	constants.abode[12].meshId = openblack::MeshId::BuildingCelticVillageCentre;
 
+	// Needs of the villager used in the lifecycle test, so that villagers can go hungry and die
+	auto& housewife = constants.villager[static_cast<size_t>(openblack::VillagerInfo::CelticHousewifeFemale)];
+	housewife.gameTurnReducesFoodInBellyBy = 1.0f;
+	housewife.hungryForFood = 50.0f;
+	housewife.starvingForFood = 20.0f;
+	housewife.hungerToLifeMultiplier = 0.5f;
+	housewife.starvingToLifeMultiplier = 5.0f;
+	housewife.grownUpAge = 18;
+
 	std::ofstream output(args.outFilename, std::ios::binary);
 	output.write(reinterpret_cast<const char*>(&constants), sizeof(constants));
 
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include <3D/DynamicAabbTree.h>
+#include <glm/geometric.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+class TestDynamicAabbTree: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> distribution(0.0f, 1000.0f);
+		for (uint32_t i = 0; i < 2000; ++i)
+		{
+			const auto position = glm::vec3(distribution(generator), distribution(generator) * 0.01f, distribution(generator));
+			_boxes.push_back({position - 2.0f, position + 2.0f});
+			_proxies.push_back(_tree.CreateProxy(_boxes.back(), i));
+		}
+	}
+
+	[[nodiscard]] std::vector<uint32_t> QueryTree(const AxisAlignedBoundingBox& box) const
+	{
+		std::vector<uint32_t> result;
+		_tree.Query([&box](const AxisAlignedBoundingBox& node) { return DynamicAabbTree::Overlaps(node, box); },
+		            [this, &box, &result](int32_t proxy) {
+			            const auto index = _tree.GetUserData(proxy);
+			            if (DynamicAabbTree::Overlaps(_boxes[index], box))
+			            {
+				            result.push_back(index);
+			            }
+			            return true;
+		            });
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	[[nodiscard]] std::vector<uint32_t> QueryBruteForce(const AxisAlignedBoundingBox& box) const
+	{
+		std::vector<uint32_t> result;
+		for (uint32_t i = 0; i < _boxes.size(); ++i)
+		{
+			if (_proxies[i] != DynamicAabbTree::k_NullNode && DynamicAabbTree::Overlaps(_boxes[i], box))
+			{
+				result.push_back(i);
+			}
+		}
+		return result;
+	}
+
+	DynamicAabbTree _tree {0.5f};
+	std::vector<AxisAlignedBoundingBox> _boxes;
+	std::vector<int32_t> _proxies;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDynamicAabbTree, balanced)
+{
+	ASSERT_EQ(_tree.GetProxyCount(), _boxes.size());
+	// A perfectly balanced tree of 2000 leaves has a height of 11
+	ASSERT_LE(_tree.GetHeight(), 22);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDynamicAabbTree, boxQueryAfterMovesAndRemovals)
+{
+	for (size_t i = 0; i < _boxes.size(); i += 3)
+	{
+		const auto offset = glm::vec3(static_cast<float>(i % 7), 0.0f, 3.0f);
+		_boxes[i] = {_boxes[i].minima + offset, _boxes[i].maxima + offset};
+		_tree.MoveProxy(_proxies[i], _boxes[i]);
+	}
+	for (size_t i = 0; i < _boxes.size(); i += 5)
+	{
+		_tree.DestroyProxy(_proxies[i]);
+		_proxies[i] = DynamicAabbTree::k_NullNode;
+	}
+
+	for (float x = 0.0f; x < 1000.0f; x += 125.0f)
+	{
+		const auto box = AxisAlignedBoundingBox {{x, 0.0f, x}, {x + 150.0f, 10.0f, x + 150.0f}};
+		ASSERT_EQ(QueryTree(box), QueryBruteForce(box));
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestDynamicAabbTree, rayCastClosest)
+{
+	const auto origin = glm::vec3(0.0f, 5.0f, 0.0f);
+	const auto direction = glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f));
+	const auto inverseDirection = 1.0f / direction;
+
+	auto closest = std::numeric_limits<uint32_t>::max();
+	_tree.RayCast(origin, direction, 2000.0f, [this, &origin, &inverseDirection, &closest](int32_t proxy, float tMax) {
+		const auto index = _tree.GetUserData(proxy);
+		float distance;
+		if (DynamicAabbTree::RayIntersects(_boxes[index], origin, inverseDirection, tMax, distance))
+		{
+			closest = index;
+			return distance;
+		}
+		return tMax;
+	});
+
+	auto expected = std::numeric_limits<uint32_t>::max();
+	auto expectedDistance = 2000.0f;
+	for (uint32_t i = 0; i < _boxes.size(); ++i)
+	{
+		float distance;
+		if (DynamicAabbTree::RayIntersects(_boxes[i], origin, inverseDirection, expectedDistance, distance))
+		{
+			expected = i;
+			expectedDistance = distance;
+		}
+	}
+	ASSERT_NE(expected, std::numeric_limits<uint32_t>::max());
+	ASSERT_EQ(closest, expected);
+}
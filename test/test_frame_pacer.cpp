@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <FramePacer.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace std::chrono_literals;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestFramePacer, lateFramesDontCatchUp)
+{
+	const auto start = FramePacer::Clock::time_point(1s);
+	constexpr auto k_Period = 10ms;
+
+	ASSERT_EQ(FramePacer::Schedule(start, start + 2ms, k_Period), start + k_Period);
+	// A frame which ended past its successor's deadline is followed immediately, and the next ones are paced from there
+	ASSERT_EQ(FramePacer::Schedule(start, start + 25ms, k_Period), start + 25ms);
+	ASSERT_EQ(FramePacer::Schedule(start + 25ms, start + 26ms, k_Period), start + 35ms);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestFramePacer, limitsFrameRate)
+{
+	FramePacer pacer;
+	ASSERT_EQ(pacer.GetFramePeriod(), FramePacer::Clock::duration::zero());
+
+	pacer.SetFrameRateLimit(200);
+	pacer.SetBackgroundFrameRateLimit(10);
+	ASSERT_EQ(pacer.GetFramePeriod(), 5ms);
+	pacer.SetBackground(true);
+	ASSERT_EQ(pacer.GetFramePeriod(), 100ms);
+	pacer.SetBackground(false);
+
+	pacer.Wait();
+	const auto start = FramePacer::Clock::now();
+	for (int i = 0; i < 10; ++i)
+	{
+		pacer.Wait();
+	}
+	ASSERT_GE(FramePacer::Clock::now() - start, 45ms);
+}
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <Debug/LabelPlacer.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::debug::gui;
+
+namespace
+{
+constexpr glm::vec2 k_DisplaySize {640.0f, 480.0f};
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLabelPlacer, movesOverlappingLabelsUp)
+{
+	LabelPlacer placer;
+	placer.Begin(k_DisplaySize, 0.0f);
+
+	glm::vec4 first {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(1, first));
+	ASSERT_FLOAT_EQ(first.y, 200.0f);
+
+	// Just above the first label, with a pixel between them
+	glm::vec4 second {110.0f, 205.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(2, second));
+	ASSERT_FLOAT_EQ(second.x, 110.0f);
+	ASSERT_FLOAT_EQ(second.y, 179.0f);
+
+	// Labels which don't overlap stay where they are
+	glm::vec4 apart {300.0f, 205.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(3, apart));
+	ASSERT_FLOAT_EQ(apart.y, 205.0f);
+	ASSERT_EQ(placer.GetPlacedCount(), 3);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLabelPlacer, rejectsLabelsMovedAboveMinY)
+{
+	LabelPlacer placer;
+	placer.Begin(k_DisplaySize, 150.0f);
+
+	glm::vec4 first {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(1, first));
+	glm::vec4 second {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(2, second));
+	ASSERT_FLOAT_EQ(second.y, 179.0f);
+
+	// Above the second label would reach past minY
+	glm::vec4 third {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_FALSE(placer.Place(3, third));
+	ASSERT_EQ(placer.GetPlacedCount(), 2);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLabelPlacer, capsSearchStepsPerFrame)
+{
+	constexpr float k_Height = 10.0f;
+	constexpr glm::vec2 k_TallDisplay {640.0f, 100'000.0f};
+	constexpr uint32_t k_LabelCount = 100;
+
+	LabelPlacer placer;
+	placer.Begin(k_TallDisplay, 0.0f);
+
+	// Stacked on the same anchor, the nth label moves past the n labels before it
+	uint32_t placed = 0;
+	for (uint32_t i = 0; i < k_LabelCount; ++i)
+	{
+		glm::vec4 box {100.0f, 90'000.0f, 50.0f, k_Height};
+		if (placer.Place(i, box))
+		{
+			ASSERT_EQ(placed, i);
+			ASSERT_FLOAT_EQ(box.y, 90'000.0f - static_cast<float>(i) * (k_Height + 1.0f));
+			++placed;
+		}
+	}
+	// The first n labels take n * (n - 1) / 2 steps, the rest are dropped once the steps run out
+	uint32_t expected = 0;
+	while ((expected + 1) * expected / 2 <= LabelPlacer::k_MaxSearchSteps)
+	{
+		++expected;
+	}
+	ASSERT_EQ(placed, expected);
+	ASSERT_EQ(placer.GetPlacedCount(), expected);
+
+	// Steps are given back every frame
+	placer.Begin(k_TallDisplay, 0.0f);
+	glm::vec4 box {100.0f, 90'000.0f, 50.0f, k_Height};
+	ASSERT_TRUE(placer.Place(0, box));
+	ASSERT_TRUE(placer.Place(1, box));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLabelPlacer, reusesPreviousFrameLift)
+{
+	LabelPlacer placer;
+	placer.Begin(k_DisplaySize, 0.0f);
+
+	glm::vec4 first {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(1, first));
+	glm::vec4 second {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(2, second));
+	ASSERT_FLOAT_EQ(second.y, 179.0f);
+
+	// Placed first this time, the second label keeps its lift rather than taking the free anchor
+	placer.Begin(k_DisplaySize, 0.0f);
+	second = {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(2, second));
+	ASSERT_FLOAT_EQ(second.y, 179.0f);
+	first = {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(1, first));
+	ASSERT_FLOAT_EQ(first.y, 200.0f);
+
+	// A lift which now overlaps another label is searched for again
+	placer.Begin(k_DisplaySize, 0.0f);
+	glm::vec4 blocker {100.0f, 175.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(3, blocker));
+	second = {100.0f, 200.0f, 50.0f, 20.0f};
+	ASSERT_TRUE(placer.Place(2, second));
+	ASSERT_FLOAT_EQ(second.y, 200.0f);
+}
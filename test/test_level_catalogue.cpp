@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <FileSystem/FileSystemInterface.h>
+#include <Game.h>
+#include <LevelCatalogue.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLevelCatalogue, parsesScriptOnce)
+{
+	const std::string_view script = "LOAD_LANDSCAPE(\"Data\\\\Landscape\\\\Land2.lnd\")\r\n"
+	                                "START_GAME_MESSAGE(\"First\")\r\n"
+	                                "ADD_GAME_MESSAGE_LINE(\"Ignored\")\r\n"
+	                                "START_GAME_MESSAGE(\"Two Gods\")\r\n"
+	                                "ADD_GAME_MESSAGE_LINE(\"Fight\")";
+	const auto entry = LevelCatalogue::Parse("Scripts/Playgrounds/TwoGods.txt", script, Level::LandType::Skirmish);
+	ASSERT_TRUE(entry.isLevel);
+	ASSERT_EQ(entry.landscape, "Data\\\\Landscape\\\\Land2.lnd");
+	ASSERT_EQ(entry.name, "Two Gods");
+	ASSERT_EQ(entry.description, "Fight");
+
+	const auto notLevel =
+	    LevelCatalogue::Parse("Scripts/Playgrounds/Helpers.txt", "RUN_SCRIPT(\"x\")", Level::LandType::Skirmish);
+	ASSERT_FALSE(notLevel.isLevel);
+	ASSERT_EQ(notLevel.name, "Helpers");
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestLevelCatalogue, ignoresMalformedIndex)
+{
+	LevelCatalogue catalogue;
+	ASSERT_FALSE(catalogue.ReadIndex({}));
+	ASSERT_FALSE(catalogue.ReadIndex({'O', 'B', 'L', 'C', 1, 0, 0, 0, 1, 0, 0, 0, 0xFF}));
+	ASSERT_FALSE(catalogue.IsIndexOutOfDate());
+}
+
+class LevelCatalogueOnDisk: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		_directory = std::filesystem::temp_directory_path() / "openblack_test_level_catalogue";
+		std::filesystem::remove_all(_directory);
+		std::filesystem::create_directories(_directory / "Scripts");
+		WriteScript("TwoGods.txt", "LOAD_LANDSCAPE(\"Data\\\\Landscape\\\\Land2.lnd\")\r\n"
+		                           "START_GAME_MESSAGE(\"Two Gods\")\r\n"
+		                           "ADD_GAME_MESSAGE_LINE(\"Fight\")");
+		WriteScript("Helpers.txt", "RUN_SCRIPT(\"x\")");
+	}
+	void TearDown() override
+	{
+		_game.reset();
+		std::filesystem::remove_all(_directory);
+	}
+
+	void WriteScript(const std::string& name, const std::string& script) const
+	{
+		std::ofstream stream(_directory / "Scripts" / name, std::ios::binary);
+		stream << script;
+	}
+
+	uint32_t Scan(LevelCatalogue& catalogue) const
+	{
+		return catalogue.Scan(_directory / "Scripts", Level::LandType::Skirmish,
+		                      [](const std::filesystem::path& f) { return f.extension() == ".txt"; });
+	}
+
+	[[nodiscard]] std::filesystem::path IndexPath() const { return _directory / "levels.idx"; }
+
+	std::unique_ptr<openblack::Game> _game;
+	std::filesystem::path _directory;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LevelCatalogueOnDisk, indexRoundTrips)
+{
+	LevelCatalogue written;
+	ASSERT_EQ(Scan(written), 2);
+	ASSERT_TRUE(written.IsIndexOutOfDate());
+	written.WriteIndex(IndexPath());
+
+	LevelCatalogue read;
+	ASSERT_TRUE(read.ReadIndex(Locator::filesystem::value().ReadAll(IndexPath())));
+	ASSERT_EQ(Scan(read), 0);
+	ASSERT_FALSE(read.IsIndexOutOfDate());
+	ASSERT_EQ(read.GetEntries().size(), written.GetEntries().size());
+	for (const auto& entry : written.GetEntries())
+	{
+		const auto& entries = read.GetEntries();
+		const auto found = std::find_if(entries.cbegin(), entries.cend(),
+		                                [&entry](const auto& other) { return other.path == entry.path; });
+		ASSERT_NE(found, entries.cend());
+		ASSERT_EQ(found->size, entry.size);
+		ASSERT_EQ(found->modified, entry.modified);
+		ASSERT_EQ(found->landType, entry.landType);
+		ASSERT_EQ(found->isLevel, entry.isLevel);
+		ASSERT_EQ(found->name, entry.name);
+		ASSERT_EQ(found->description, entry.description);
+		ASSERT_EQ(found->landscape, entry.landscape);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LevelCatalogueOnDisk, reusesUnchangedScripts)
+{
+	LevelCatalogue first;
+	ASSERT_EQ(Scan(first), 2);
+	first.WriteIndex(IndexPath());
+
+	// Only the script which changed size is read again
+	WriteScript("Helpers.txt", "RUN_SCRIPT(\"longer\")");
+	LevelCatalogue second;
+	ASSERT_TRUE(second.ReadIndex(Locator::filesystem::value().ReadAll(IndexPath())));
+	ASSERT_EQ(Scan(second), 1);
+	ASSERT_TRUE(second.IsIndexOutOfDate());
+
+	const auto& entries = second.GetEntries();
+	const auto level = std::find_if(entries.cbegin(), entries.cend(), [](const auto& entry) { return entry.isLevel; });
+	ASSERT_NE(level, entries.cend());
+	ASSERT_EQ(level->name, "Two Gods");
+	ASSERT_EQ(level->description, "Fight");
+}
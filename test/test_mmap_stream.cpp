@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <fstream>
+
+#include <FileSystem/MMapStream.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::filesystem;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMMapStream, readsAndViewsFile)
+{
+	const auto path = std::filesystem::temp_directory_path() / "openblack_test_mmap_stream.txt";
+	std::ofstream(path, std::ios::binary) << "LOAD_LANDSCAPE\nend";
+
+	MMapStream stream(path);
+	ASSERT_EQ(stream.Size(), 18);
+	ASSERT_EQ(stream.GetLine(), "LOAD_LANDSCAPE");
+	const auto view = stream.View(5, 4);
+	ASSERT_EQ(std::string(view.begin(), view.end()), "LAND");
+	// Views don't move the position
+	ASSERT_EQ(stream.ReadValue<char>(), 'e');
+	ASSERT_EQ(stream.GetLine(), "nd");
+	ASSERT_TRUE(stream.IsEndOfFile());
+	ASSERT_THROW(stream.ReadValue<char>(), std::runtime_error);
+	ASSERT_THROW((void)stream.View(16, 3), std::runtime_error);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMMapStream, opensEmptyFile)
+{
+	const auto path = std::filesystem::temp_directory_path() / "openblack_test_mmap_stream_empty.txt";
+	std::ofstream(path, std::ios::binary).flush();
+
+	MMapStream stream(path);
+	ASSERT_EQ(stream.Size(), 0);
+	ASSERT_TRUE(stream.IsEndOfFile());
+	ASSERT_TRUE(stream.View(0, 0).empty());
+}
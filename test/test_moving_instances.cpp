@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+
+#include <ECS/Archetypes/HandArchetype.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/RenderingSystemInterface.h>
+#include <Game.h>
+#include <LHScriptX/Script.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+class MovingInstancesOnMockLevel: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+		openblack::lhscriptx::Script script;
+		script.Load(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+)"""");
+	}
+	void TearDown() override { _game.reset(); }
+
+	/// Move \p entity to \p position, prepare a frame and tell whether its instance was uploaded on its own
+	static bool MoveAndPrepare(entt::entity entity, const glm::vec3& position)
+	{
+		Locator::entitiesRegistry::value().Get<Transform>(entity).position = position;
+		auto& renderingSystem = Locator::rendereringSystem::value();
+		renderingSystem.PrepareDraw(false, false, false, 0.0f);
+
+		const auto& context = renderingSystem.GetContext();
+		const auto instance = std::find_if(context.movingInstances.cbegin(), context.movingInstances.cend(),
+		                                   [entity](const auto& moving) { return moving.entity == entity; });
+		EXPECT_NE(instance, context.movingInstances.cend());
+		return std::any_of(context.movedRanges.cbegin(), context.movedRanges.cend(), [instance](const auto& range) {
+			return instance->index >= range.first && instance->index < range.first + range.second;
+		});
+	}
+
+	std::unique_ptr<openblack::Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(MovingInstancesOnMockLevel, handMovedBackIsUploaded)
+{
+	const auto a = glm::vec3(100.0f, 10.0f, 100.0f);
+	const auto b = glm::vec3(200.0f, 10.0f, 200.0f);
+	const auto hand = archetypes::HandArchetype::Create(a, glm::half_pi<float>(), 0.0f, glm::half_pi<float>(), 0.01f, false);
+
+	// The whole list is uploaded on the first frame, after which the hand only goes up when it moves
+	Locator::entitiesRegistry::value().SetDirty();
+	auto& renderingSystem = Locator::rendereringSystem::value();
+	renderingSystem.PrepareDraw(false, false, false, 0.0f);
+	ASSERT_TRUE(renderingSystem.GetContext().movedRanges.empty());
+	ASSERT_FALSE(MoveAndPrepare(hand, a));
+
+	// The copy written back to A still held A, the GPU held B
+	ASSERT_TRUE(MoveAndPrepare(hand, b));
+	ASSERT_TRUE(MoveAndPrepare(hand, a));
+	ASSERT_FALSE(MoveAndPrepare(hand, a));
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+
+#include <ECS/ObstacleScan.h>
+#include <entt/entity/entity.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs;
+
+namespace
+{
+// More obstacles than fit in one block, the nearest is not the first
+constexpr std::array<float, 10> k_CenterX = {40.0f, 20.0f, -10.0f, 30.0f, 50.0f, 60.0f, 70.0f, 80.0f, 90.0f, 15.0f};
+constexpr std::array<float, 10> k_CenterZ = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+constexpr std::array<float, 10> k_Radius = {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f};
+constexpr std::array<entt::entity, 10> k_Entities = {
+    entt::entity {0}, entt::entity {1}, entt::entity {2}, entt::entity {3}, entt::entity {4},
+    entt::entity {5}, entt::entity {6}, entt::entity {7}, entt::entity {8}, entt::entity {9},
+};
+const FixedObstacles k_Obstacles = {k_CenterX, k_CenterZ, k_Radius, k_Entities};
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestObstacleScan, rayHitsClosestInFront)
+{
+	const auto hit = CastRayAtObstacles(k_Obstacles, {0.0f, 0.0f}, {1.0f, 0.0f});
+	ASSERT_TRUE(hit.has_value());
+	ASSERT_EQ(hit->entity, entt::entity {9});
+
+	// Obstacles behind the ray are ignored
+	const auto behind = CastRayAtObstacles(k_Obstacles, {0.0f, 0.0f}, {-1.0f, 0.0f});
+	ASSERT_TRUE(behind.has_value());
+	ASSERT_EQ(behind->entity, entt::entity {2});
+	ASSERT_FLOAT_EQ(behind->distance, 8.0f);
+
+	ASSERT_FALSE(CastRayAtObstacles(k_Obstacles, {0.0f, 0.0f}, {0.0f, 1.0f}).has_value());
+	ASSERT_FALSE(CastRayAtObstacles({}, {0.0f, 0.0f}, {1.0f, 0.0f}).has_value());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestObstacleScan, overlapIgnoresOrbitedObstacle)
+{
+	const auto nearest = FindOverlappingObstacle(k_Obstacles, {17.0f, 0.0f}, 2.0f, entt::entity {2});
+	ASSERT_TRUE(nearest.has_value());
+	ASSERT_EQ(nearest->entity, entt::entity {9});
+
+	const auto hit = FindOverlappingObstacle(k_Obstacles, {17.0f, 0.0f}, 2.0f, entt::entity {9});
+	ASSERT_TRUE(hit.has_value());
+	ASSERT_EQ(hit->entity, entt::entity {1});
+	ASSERT_FLOAT_EQ(hit->distance, 3.0f);
+
+	ASSERT_FALSE(FindOverlappingObstacle(k_Obstacles, {-10.0f, 0.0f}, 2.0f, entt::entity {2}).has_value());
+}
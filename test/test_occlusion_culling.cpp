@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cmath>
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <Graphics/OcclusionCuller.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::graphics;
+
+class TestOcclusionCulling: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		// Looking down -z at a 40 by 40 wall 50 units away
+		const auto projection = glm::perspective(glm::radians(70.0f), 2.0f, 1.0f, 1000.0f);
+		const auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		_culler.Begin(projection * view);
+		_culler.RasterizeTriangles(glm::mat4(1.0f), _wallVertices, _wallIndices);
+		_culler.End();
+	}
+
+	[[nodiscard]] bool IsVisible(const glm::vec3& center, float size)
+	{
+		const auto box = AxisAlignedBoundingBox {glm::vec3(-size * 0.5f), glm::vec3(size * 0.5f)};
+		return _culler.IsVisible(box, glm::translate(glm::mat4(1.0f), center));
+	}
+
+	OcclusionCuller _culler;
+	const std::array<glm::vec3, 4> _wallVertices {
+	    glm::vec3(-20.0f, -20.0f, -50.0f),
+	    glm::vec3(20.0f, -20.0f, -50.0f),
+	    glm::vec3(20.0f, 20.0f, -50.0f),
+	    glm::vec3(-20.0f, 20.0f, -50.0f),
+	};
+	const std::array<uint16_t, 6> _wallIndices {0, 1, 2, 0, 2, 3};
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestOcclusionCulling, hiddenBehindOccluder)
+{
+	ASSERT_EQ(_culler.GetStatistics().occluderTriangles, 2);
+	ASSERT_FALSE(IsVisible({0.0f, 0.0f, -100.0f}, 4.0f));
+	ASSERT_FALSE(IsVisible({10.0f, -10.0f, -300.0f}, 10.0f));
+	ASSERT_EQ(_culler.GetStatistics().occludedBoxes, 2);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestOcclusionCulling, visibleAroundOccluder)
+{
+	// In front of the wall
+	ASSERT_TRUE(IsVisible({0.0f, 0.0f, -30.0f}, 4.0f));
+	// Behind the wall but next to it
+	ASSERT_TRUE(IsVisible({60.0f, 0.0f, -100.0f}, 4.0f));
+	// Behind the wall but larger than it
+	ASSERT_TRUE(IsVisible({0.0f, 0.0f, -100.0f}, 100.0f));
+	// Crossing the wall
+	ASSERT_TRUE(IsVisible({0.0f, 0.0f, -50.0f}, 4.0f));
+	// Behind the camera can't be projected and is kept
+	ASSERT_TRUE(IsVisible({0.0f, 0.0f, 100.0f}, 4.0f));
+	ASSERT_EQ(_culler.GetStatistics().occludedBoxes, 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestOcclusionCulling, outsideView)
+{
+	ASSERT_FALSE(IsVisible({500.0f, 0.0f, -100.0f}, 4.0f));
+	ASSERT_EQ(_culler.GetStatistics().outsideBoxes, 1);
+	ASSERT_EQ(_culler.GetStatistics().occludedBoxes, 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestOcclusionCullingTiming, cullsTensOfThousandsOfBoxes)
+{
+	constexpr uint32_t k_GridSize = 128;
+	constexpr float k_Spacing = 10.0f;
+	constexpr uint32_t k_BoxCount = 20'000;
+	constexpr uint32_t k_FrameCount = 10;
+
+	// Rolling ground seen from above it at a shallow angle, like the terrain occluder
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32_t> indices;
+	for (uint32_t z = 0; z <= k_GridSize; ++z)
+	{
+		for (uint32_t x = 0; x <= k_GridSize; ++x)
+		{
+			const auto height = 5.0f * std::sin(static_cast<float>(x) * 0.3f) + 5.0f * std::cos(static_cast<float>(z) * 0.2f);
+			vertices.emplace_back((static_cast<float>(x) - k_GridSize * 0.5f) * k_Spacing, height,
+			                      -static_cast<float>(z) * k_Spacing);
+		}
+	}
+	for (uint32_t z = 0; z < k_GridSize; ++z)
+	{
+		for (uint32_t x = 0; x < k_GridSize; ++x)
+		{
+			const auto i = z * (k_GridSize + 1) + x;
+			indices.insert(indices.end(), {i, i + 1, i + k_GridSize + 2, i, i + k_GridSize + 2, i + k_GridSize + 1});
+		}
+	}
+
+	// Every other box is buried under the ground
+	const auto box = AxisAlignedBoundingBox {glm::vec3(-2.0f), glm::vec3(2.0f)};
+	std::vector<glm::mat4> models;
+	models.reserve(k_BoxCount);
+	for (uint32_t i = 0; i < k_BoxCount; ++i)
+	{
+		const auto x = (static_cast<float>(i % 100) - 50.0f) * 12.0f;
+		const auto z = -static_cast<float>(i / 100) * 6.0f;
+		models.emplace_back(glm::translate(glm::mat4(1.0f), glm::vec3(x, i % 2 == 0 ? -30.0f : 30.0f, z)));
+	}
+
+	const auto projection = glm::perspective(glm::radians(70.0f), 2.0f, 1.0f, 2000.0f);
+	const auto view = glm::lookAt(glm::vec3(0.0f, 60.0f, 20.0f), glm::vec3(0.0f, 0.0f, -300.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	OcclusionCuller culler;
+	int64_t rasterizeTime = 0;
+	int64_t testTime = 0;
+	uint32_t visibleCount = 0;
+	for (uint32_t frame = 0; frame < k_FrameCount; ++frame)
+	{
+		auto start = std::chrono::steady_clock::now();
+		culler.Begin(projection * view);
+		culler.RasterizeTriangles(glm::mat4(1.0f), vertices, indices);
+		culler.End();
+		auto end = std::chrono::steady_clock::now();
+		rasterizeTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+		start = end;
+		visibleCount = 0;
+		for (const auto& model : models)
+		{
+			visibleCount += culler.IsVisible(box, model) ? 1 : 0;
+		}
+		end = std::chrono::steady_clock::now();
+		testTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	}
+
+	const auto& statistics = culler.GetStatistics();
+	ASSERT_EQ(statistics.occluderTriangles, k_GridSize * k_GridSize * 2);
+	ASSERT_EQ(statistics.testedBoxes, k_BoxCount);
+	ASSERT_GT(statistics.occludedBoxes, 0);
+	ASSERT_EQ(visibleCount + statistics.occludedBoxes + statistics.outsideBoxes, k_BoxCount);
+	RecordProperty("rasterize_us_per_frame_" + std::to_string(statistics.occluderTriangles) + "_triangles",
+	               std::to_string(rasterizeTime / k_FrameCount));
+	RecordProperty("test_us_per_frame_" + std::to_string(k_BoxCount) + "_boxes", std::to_string(testTime / k_FrameCount));
+}
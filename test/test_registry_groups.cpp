@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ECS/Archetypes/TreeArchetype.h>
+#include <ECS/Archetypes/VillagerArchetype.h>
+#include <ECS/Map.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/VillagerLifecycleSystemInterface.h>
+#include <Game.h>
+#include <LHScriptX/Script.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+namespace
+{
+/// Registry which doesn't need a rendering system to be dirtied
+class GroupTestRegistry final: public Registry
+{
+public:
+	void SetDirty() override {}
+};
+
+void Populate(GroupTestRegistry& registry, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const auto entity = registry.Create();
+		registry.Assign<Transform>(entity, glm::vec3(static_cast<float>(i)), glm::mat3(1.0f), glm::vec3(1.0f));
+		if (i % 2 == 0)
+		{
+			registry.Assign<Fixed>(entity, glm::vec2(static_cast<float>(i)), 1.0f);
+		}
+		else
+		{
+			registry.Assign<Mobile>(entity);
+		}
+	}
+}
+
+template <typename Func>
+int64_t TimeMicroseconds(Func func)
+{
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Iterate \p Components through a view and through Registry::Each, which goes through their group, and record both
+template <typename... Components>
+void RecordViewAndGroupTimes(const std::string& name, uint32_t count)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	// An empty exclusion list keeps Each on a view. The group is created before it is timed.
+	size_t groupCount = 0;
+	registry.Each<Components...>([&groupCount](const Components&... /*unused*/) { ++groupCount; });
+
+	size_t viewCount = 0;
+	const auto viewTime = TimeMicroseconds([&registry, &viewCount]() {
+		registry.Each<Components...>([&viewCount](const Components&... /*unused*/) { ++viewCount; }, entt::exclude<>);
+	});
+	groupCount = 0;
+	const auto groupTime = TimeMicroseconds([&registry, &groupCount]() {
+		registry.Each<Components...>([&groupCount](const Components&... /*unused*/) { ++groupCount; });
+	});
+	ASSERT_EQ(groupCount, viewCount);
+
+	::testing::Test::RecordProperty(name + "_view_us_" + std::to_string(count), std::to_string(viewTime));
+	::testing::Test::RecordProperty(name + "_group_us_" + std::to_string(count), std::to_string(groupTime));
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestRegistryGroups, layoutsMatchInAnyOrder)
+{
+	ASSERT_EQ((k_RegistryGroupIndex<const Transform, const Fixed>), (k_RegistryGroupIndex<Fixed, Transform>));
+	ASSERT_LT((k_RegistryGroupIndex<const Mobile, const Transform>), std::tuple_size_v<RegistryGroups>);
+	ASSERT_LT((k_RegistryGroupIndex<Villager, VillagerNeeds>), std::tuple_size_v<RegistryGroups>);
+	ASSERT_EQ((k_RegistryGroupIndex<const Mobile, const Transform, const Fixed>), std::tuple_size_v<RegistryGroups>);
+	ASSERT_EQ((k_RegistryGroupIndex<const Transform>), std::tuple_size_v<RegistryGroups>);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestRegistryGroups, groupsVisitWhatViewsVisit)
+{
+	GroupTestRegistry registry;
+	Populate(registry, 1'000);
+
+	// A const registry can't create the group, it iterates a view until the group exists
+	const auto& constRegistry = registry;
+	size_t viewCount = 0;
+	constRegistry.Each<const Fixed, const Transform>(
+	    [&viewCount](const Fixed& /*unused*/, const Transform& /*unused*/) { ++viewCount; });
+
+	// Components are handed over in the order asked for, whatever the order of the layout
+	size_t fixedCount = 0;
+	registry.Each<const Transform, const Fixed>([&fixedCount](entt::entity /*unused*/, const Transform& transform,
+	                                                         const Fixed& fixed) {
+		ASSERT_FLOAT_EQ(transform.position.x, fixed.boundingCenter.x);
+		++fixedCount;
+	});
+	size_t groupCount = 0;
+	constRegistry.Each<const Fixed, const Transform>(
+	    [&groupCount](const Fixed& /*unused*/, const Transform& /*unused*/) { ++groupCount; });
+
+	size_t mobileCount = 0;
+	registry.Each<const Transform, const Mobile>(
+	    [&mobileCount](const Transform& /*unused*/, const Mobile& /*unused*/) { ++mobileCount; });
+
+	ASSERT_EQ(viewCount, 500);
+	ASSERT_EQ(fixedCount, 500);
+	ASSERT_EQ(groupCount, 500);
+	ASSERT_EQ(mobileCount, 500);
+}
+
+class RegistryGroupsOnMockLevel: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+		openblack::lhscriptx::Script script;
+		script.Load(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+)"""");
+	}
+	void TearDown() override { _game.reset(); }
+
+	/// Add trees and villagers, which the map and the villager lifecycle iterate, until there are \p count of them
+	void PopulateTo(uint32_t count)
+	{
+		const auto position = [](uint32_t i) {
+			return glm::vec3(static_cast<float>(i % 256) * 10.0f, 0.0f, static_cast<float>(i / 256 % 256) * 10.0f);
+		};
+		std::vector<archetypes::TreeArchetype::Definition> trees;
+		for (; _populated < count; ++_populated)
+		{
+			if (_populated % 2 == 0)
+			{
+				trees.push_back({0, position(_populated), TreeInfo::Beech, false, 0.0f, 1.0f, 1.0f});
+			}
+			else
+			{
+				archetypes::VillagerArchetype::Create(position(_populated), position(_populated),
+				                                      VillagerInfo::CelticHousewifeFemale, _populated % 60);
+			}
+		}
+		std::vector<entt::entity> entities(trees.size());
+		archetypes::TreeArchetype::Create(trees, entities);
+	}
+
+	std::unique_ptr<openblack::Game> _game;
+	uint32_t _populated {0};
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistryGroupsOnMockLevel, systemLoopsThroughGroupsAndViews)
+{
+	for (const uint32_t count : {1'000u, 10'000u, 50'000u})
+	{
+		PopulateTo(count);
+
+		RecordViewAndGroupTimes<Fixed, Transform>("fixed_transform", count);
+		RecordViewAndGroupTimes<Mobile, Transform>("mobile_transform", count);
+		RecordViewAndGroupTimes<VillagerNeeds, Villager>("villager_needs", count);
+
+		// The systems themselves, which iterate these combinations every turn
+		const auto mapTime = TimeMicroseconds([]() { Locator::entitiesMap::value().Rebuild(); });
+		const auto lifecycleTime = TimeMicroseconds([]() { Locator::villagerLifecycleSystem::value().Update(); });
+		RecordProperty("map_rebuild_us_" + std::to_string(count), std::to_string(mapTime));
+		RecordProperty("villager_lifecycle_us_" + std::to_string(count), std::to_string(lifecycleTime));
+	}
+}
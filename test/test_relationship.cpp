@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <string>
+
+#include <ECS/Relationship.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestRelationship, reassignsChildrenEveryTurn)
+{
+	constexpr uint32_t k_ParentCount = 64;
+	constexpr uint32_t k_ChildCount = 4096;
+	constexpr uint32_t k_TurnCount = 100;
+
+	Relationship relationship;
+	const auto parent = [](uint32_t i) { return static_cast<entt::entity>(i); };
+	const auto child = [](uint32_t i) { return static_cast<entt::entity>(k_ParentCount + i); };
+	for (uint32_t i = 0; i < k_ChildCount; ++i)
+	{
+		relationship.Link(parent(i % k_ParentCount), child(i));
+	}
+
+	// Move every other child to the next parent each turn
+	for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+	{
+		for (uint32_t i = turn % 2; i < k_ChildCount; i += 2)
+		{
+			const auto previous = static_cast<uint32_t>(relationship.GetParent(child(i)));
+			relationship.Link(parent((previous + 1) % k_ParentCount), child(i));
+		}
+	}
+
+	uint32_t total = 0;
+	for (uint32_t i = 0; i < k_ParentCount; ++i)
+	{
+		for (const auto c : relationship.GetChildren(parent(i)))
+		{
+			ASSERT_EQ(relationship.GetParent(c), parent(i));
+		}
+		total += relationship.GetChildCount(parent(i));
+	}
+	ASSERT_EQ(total, k_ChildCount);
+	ASSERT_EQ(relationship.GetParent(child(0)), parent(k_TurnCount / 2 % k_ParentCount));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestRelationship, reassignsTensOfThousandsOfChildren)
+{
+	constexpr uint32_t k_ParentCount = 2'000;
+	constexpr uint32_t k_ChildCount = 50'000;
+	constexpr uint32_t k_TurnCount = 100;
+
+	Relationship relationship;
+	const auto parent = [](uint32_t i) { return static_cast<entt::entity>(i); };
+	const auto child = [](uint32_t i) { return static_cast<entt::entity>(k_ParentCount + i); };
+	for (uint32_t i = 0; i < k_ChildCount; ++i)
+	{
+		relationship.Link(parent(i % k_ParentCount), child(i));
+	}
+
+	// Every villager moves abode on its own turn, a tenth of them each turn
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+	{
+		for (uint32_t i = turn % 10; i < k_ChildCount; i += 10)
+		{
+			const auto previous = static_cast<uint32_t>(relationship.GetParent(child(i)));
+			relationship.Link(parent((previous + 7) % k_ParentCount), child(i));
+		}
+	}
+	const auto time =
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	RecordProperty("reassign_us_" + std::to_string(k_ChildCount) + "_children_" + std::to_string(k_TurnCount) + "_turns",
+	               std::to_string(time));
+
+	uint32_t total = 0;
+	for (uint32_t i = 0; i < k_ParentCount; ++i)
+	{
+		total += relationship.GetChildCount(parent(i));
+	}
+	ASSERT_EQ(total, k_ChildCount);
+	ASSERT_EQ(relationship.GetParent(child(0)), parent(k_TurnCount / 10 * 7 % k_ParentCount));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestRelationship, unlinksAndClears)
+{
+	Relationship relationship;
+	const auto abode = static_cast<entt::entity>(0);
+	const auto villagers = {static_cast<entt::entity>(1), static_cast<entt::entity>(2), static_cast<entt::entity>(3)};
+	for (const auto villager : villagers)
+	{
+		relationship.Link(abode, villager);
+	}
+
+	ASSERT_TRUE(relationship.Unlink(static_cast<entt::entity>(1)));
+	ASSERT_FALSE(relationship.Unlink(static_cast<entt::entity>(1)));
+	ASSERT_TRUE(relationship.GetParent(static_cast<entt::entity>(1)) == entt::null);
+	// The last child takes the slot of the unlinked one
+	ASSERT_EQ(relationship.GetChildCount(abode), 2);
+	ASSERT_EQ(relationship.GetChildren(abode)[0], static_cast<entt::entity>(3));
+	ASSERT_EQ(relationship.GetChildren(abode)[1], static_cast<entt::entity>(2));
+
+	relationship.Clear(abode);
+	ASSERT_EQ(relationship.GetChildCount(abode), 0);
+	ASSERT_TRUE(relationship.GetParent(static_cast<entt::entity>(3)) == entt::null);
+	ASSERT_FALSE(relationship.Unlink(static_cast<entt::entity>(2)));
+	// Unknown entities have no links
+	ASSERT_EQ(relationship.GetChildCount(static_cast<entt::entity>(100)), 0);
+}
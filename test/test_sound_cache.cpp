@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <Audio/SoundCache.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::audio;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestSoundCache, evictsLeastRecentlyUsed)
+{
+	SoundCache cache(300);
+	cache.Insert(1, 11, 100, {}, 0);
+	cache.Insert(2, 12, 100, {}, 0);
+	cache.Insert(3, 13, 100, {}, 0);
+	ASSERT_TRUE(cache.Evict().empty());
+
+	// Playing the first sound makes the second one the least recently used
+	ASSERT_EQ(cache.Acquire(1), 11);
+	cache.Release(1);
+	cache.Insert(4, 14, 100, {}, 0);
+	const auto evicted = cache.Evict();
+	ASSERT_EQ(evicted.size(), 1);
+	ASSERT_EQ(evicted[0].first, 2);
+	ASSERT_EQ(evicted[0].second, 12);
+
+	ASSERT_FALSE(cache.Acquire(2).has_value());
+	ASSERT_EQ(cache.GetStatistics().hits, 1);
+	ASSERT_EQ(cache.GetStatistics().misses, 1);
+	ASSERT_EQ(cache.GetStatistics().evictions, 1);
+	ASSERT_EQ(cache.GetStatistics().residentBytes, 300);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestSoundCache, keepsBuffersInUse)
+{
+	SoundCache cache(100);
+	cache.Insert(1, 11, 100, {}, 1);
+	cache.Insert(2, 12, 100, {}, 0);
+	ASSERT_TRUE(cache.Acquire(2).has_value());
+
+	// Everything is in use, the cache goes over budget rather than deleting queued buffers
+	ASSERT_TRUE(cache.Evict().empty());
+	ASSERT_EQ(cache.GetStatistics().residentBytes, 200);
+
+	cache.Release(1);
+	const auto evicted = cache.Evict();
+	ASSERT_EQ(evicted.size(), 1);
+	ASSERT_EQ(evicted[0].first, 1);
+	ASSERT_TRUE(cache.Contains(2));
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <3D/LandIslandInterface.h>
+#include <Game.h>
+#include <LHScriptX/Script.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+class TestTerrainEdit: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		lhscriptx::Script script;
+		script.Load(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+)"""");
+	}
+	void TearDown() override { _game.reset(); }
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestTerrainEdit, setCellAltitude)
+{
+	auto& island = Locator::terrainSystem::value();
+	island.SetCellAltitude({3, 4}, 42);
+	ASSERT_FLOAT_EQ(island.GetHeightAt({30.0f, 40.0f}), 42 * LandIslandInterface::k_HeightUnit);
+	island.UpdateDirtyBlocks();
+	ASSERT_FLOAT_EQ(island.GetHeightAt({30.0f, 40.0f}), 42 * LandIslandInterface::k_HeightUnit);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestTerrainEdit, adjustAltitudeFalloff)
+{
+	auto& island = Locator::terrainSystem::value();
+	const auto before = island.GetHeightAt({80.0f, 80.0f});
+	island.AdjustAltitude({80.0f, 80.0f}, 40.0f, 10.0f);
+	const auto centre = island.GetHeightAt({80.0f, 80.0f});
+	const auto edge = island.GetHeightAt({110.0f, 80.0f});
+	ASSERT_GT(centre, before);
+	ASSERT_GE(centre, edge);
+	ASSERT_FLOAT_EQ(island.GetHeightAt({130.0f, 80.0f}), before);
+	island.UpdateDirtyBlocks();
+}
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ECS/TownBeliefs.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs;
+
+namespace
+{
+template <typename Func>
+int64_t TimeMicroseconds(Func&& func)
+{
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<float> MakeInfluence(uint32_t townCount)
+{
+	std::vector<float> influence(static_cast<size_t>(townCount) * TownBeliefs::k_PlayerStride);
+	for (uint32_t town = 0; town < townCount; ++town)
+	{
+		for (uint32_t player = 0; player < TownBeliefs::k_PlayerStride; ++player)
+		{
+			influence[town * TownBeliefs::k_PlayerStride + player] = static_cast<float>(player);
+		}
+	}
+	return influence;
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTownBeliefs, accumulatesOverAllTownsAndPlayers)
+{
+	constexpr uint32_t k_TownCount = 1024;
+	constexpr uint32_t k_TurnCount = 100;
+
+	TownBeliefs beliefs;
+	for (uint32_t i = 0; i < k_TownCount; ++i)
+	{
+		ASSERT_EQ(beliefs.AddTown(), i);
+	}
+	beliefs.Set(3, PlayerNames::PLAYER_TWO, 10.0f);
+
+	const auto influence = MakeInfluence(k_TownCount);
+	for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+	{
+		beliefs.Accumulate(influence, 0.5f);
+	}
+
+	ASSERT_FLOAT_EQ(beliefs.Get(0, PlayerNames::PLAYER_ONE), 0.0f);
+	ASSERT_FLOAT_EQ(beliefs.Get(3, PlayerNames::PLAYER_TWO), 10.0f + k_TurnCount * 0.5f);
+	ASSERT_FLOAT_EQ(beliefs.Get(k_TownCount - 1, PlayerNames::NEUTRAL), k_TurnCount * 3.5f);
+
+	// New towns start without beliefs and leave the others in place
+	const auto town = beliefs.AddTown();
+	ASSERT_FLOAT_EQ(beliefs.Get(town, PlayerNames::NEUTRAL), 0.0f);
+	ASSERT_FLOAT_EQ(beliefs.Get(3, PlayerNames::PLAYER_TWO), 10.0f + k_TurnCount * 0.5f);
+	ASSERT_EQ(beliefs.GetTownCount(), k_TownCount + 1);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTownBeliefs, accumulationTimings)
+{
+	constexpr uint32_t k_TurnCount = 100;
+
+	for (const uint32_t townCount : {256u, 4096u, 65536u})
+	{
+		TownBeliefs beliefs;
+		// Towns used to hold their beliefs in a map each
+		std::vector<std::unordered_map<PlayerNames, float>> maps(townCount);
+		for (uint32_t i = 0; i < townCount; ++i)
+		{
+			beliefs.AddTown();
+			for (uint32_t player = 0; player < TownBeliefs::k_PlayerStride; ++player)
+			{
+				maps[i][static_cast<PlayerNames>(player)] = 0.0f;
+			}
+		}
+		const auto influence = MakeInfluence(townCount);
+
+		const auto denseTime = TimeMicroseconds([&]() {
+			for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+			{
+				beliefs.Accumulate(influence, 0.5f);
+			}
+		});
+		const auto mapTime = TimeMicroseconds([&]() {
+			for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+			{
+				for (uint32_t town = 0; town < townCount; ++town)
+				{
+					for (auto& [player, belief] : maps[town])
+					{
+						belief += influence[town * TownBeliefs::k_PlayerStride + static_cast<uint32_t>(player)] * 0.5f;
+					}
+				}
+			}
+		});
+
+		RecordProperty("dense_us_" + std::to_string(townCount), std::to_string(denseTime));
+		RecordProperty("map_us_" + std::to_string(townCount), std::to_string(mapTime));
+
+		// Both layouts end on the same beliefs
+		const auto last = townCount - 1;
+		ASSERT_FLOAT_EQ(beliefs.Get(last, PlayerNames::NEUTRAL), maps[last][PlayerNames::NEUTRAL]);
+		ASSERT_FLOAT_EQ(beliefs.Get(last, PlayerNames::NEUTRAL), k_TurnCount * 3.5f);
+	}
+}
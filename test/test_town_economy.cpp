@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <ECS/TownEconomy.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTownEconomy, keepsTotalsAsContributorsChange)
+{
+	const auto town = static_cast<entt::entity>(0);
+	const auto otherTown = static_cast<entt::entity>(1);
+	const auto abode = static_cast<entt::entity>(2);
+	const auto villager = static_cast<entt::entity>(3);
+
+	TownEconomy economy;
+	economy.Set(abode, town, {10, 5, 0, 0, 4, 0});
+	economy.Set(villager, town, {0, 0, 1, 1, 0, 0});
+	ASSERT_EQ(economy.GetStock(town).population, 1);
+	ASSERT_EQ(economy.GetStock(town).homeless, 1);
+	ASSERT_EQ(economy.GetFreeHousing(town), 4);
+
+	// The villager moves into the abode, then to another town
+	economy.Set(villager, town, {0, 0, 1, 0, 0, 1});
+	ASSERT_EQ(economy.GetStock(town).homeless, 0);
+	ASSERT_EQ(economy.GetFreeHousing(town), 3);
+	economy.Set(villager, otherTown, {0, 0, 1, 1, 0, 0});
+	ASSERT_EQ(economy.GetStock(town).population, 0);
+	ASSERT_EQ(economy.GetStock(otherTown).population, 1);
+
+	economy.Set(abode, town, {7, 5, 0, 0, 4, 0});
+	ASSERT_EQ(economy.GetStock(town).food, 7);
+	economy.Remove(abode);
+	economy.Remove(abode);
+	ASSERT_EQ(economy.GetStock(town).food, 0);
+	ASSERT_EQ(economy.GetFreeHousing(town), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTownEconomy, findsNearestStorageWithWood)
+{
+	const auto town = static_cast<entt::entity>(0);
+	const auto nearPit = static_cast<entt::entity>(1);
+	const auto farPit = static_cast<entt::entity>(2);
+	const auto nearPile = static_cast<entt::entity>(3);
+	const auto farPile = static_cast<entt::entity>(4);
+
+	TownEconomy economy;
+	economy.AddStorage(nearPit, town, glm::vec3(1.0f, 0.0f, 0.0f));
+	economy.AddStorage(farPit, town, glm::vec3(10.0f, 0.0f, 0.0f));
+	ASSERT_TRUE(economy.FindNearestStorageWithWood(town, glm::vec3(0.0f)) == entt::null);
+
+	economy.Set(farPile, town, {0, 20, 0, 0, 0, 0}, farPit);
+	economy.Set(nearPile, town, {15, 0, 0, 0, 0, 0}, nearPit);
+	ASSERT_EQ(economy.FindNearestStorageWithWood(town, glm::vec3(0.0f)), farPit);
+	ASSERT_EQ(economy.GetStock(town).wood, 20);
+	ASSERT_EQ(economy.GetStock(town).food, 15);
+
+	economy.Set(nearPile, town, {0, 3, 0, 0, 0, 0}, nearPit);
+	ASSERT_EQ(economy.FindNearestStorageWithWood(town, glm::vec3(0.0f)), nearPit);
+
+	// Piles left behind by a pit no longer count towards it
+	economy.RemoveStorage(nearPit);
+	ASSERT_EQ(economy.FindNearestStorageWithWood(town, glm::vec3(0.0f)), farPit);
+	ASSERT_EQ(economy.GetStock(town).wood, 20);
+	ASSERT_EQ(economy.GetStock(town).food, 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTownEconomy, destroyedPitMatchesRecount)
+{
+	const auto town = static_cast<entt::entity>(0);
+	const auto abode = static_cast<entt::entity>(1);
+	const auto keptPit = static_cast<entt::entity>(2);
+	const auto destroyedPit = static_cast<entt::entity>(3);
+	const auto keptPile = static_cast<entt::entity>(4);
+	const auto foodPile = static_cast<entt::entity>(5);
+	const auto woodPile = static_cast<entt::entity>(6);
+
+	const auto build = [&](TownEconomy& economy, bool withDestroyedPit) {
+		economy.Set(abode, town, {10, 5, 0, 0, 4, 0});
+		economy.AddStorage(keptPit, town, glm::vec3(10.0f, 0.0f, 0.0f));
+		economy.Set(keptPile, town, {0, 20, 0, 0, 0, 0}, keptPit);
+		if (withDestroyedPit)
+		{
+			economy.AddStorage(destroyedPit, town, glm::vec3(1.0f, 0.0f, 0.0f));
+			economy.Set(foodPile, town, {30, 0, 0, 0, 0, 0}, destroyedPit);
+			economy.Set(woodPile, town, {0, 40, 0, 0, 0, 0}, destroyedPit);
+		}
+	};
+
+	TownEconomy economy;
+	build(economy, true);
+	ASSERT_EQ(economy.FindNearestStorageWithWood(town, glm::vec3(0.0f)), destroyedPit);
+	economy.RemoveStorage(destroyedPit);
+
+	TownEconomy recount;
+	build(recount, false);
+	const auto stock = economy.GetStock(town);
+	const auto expected = recount.GetStock(town);
+	ASSERT_EQ(stock.food, expected.food);
+	ASSERT_EQ(stock.wood, expected.wood);
+	ASSERT_EQ(stock.housing, expected.housing);
+	ASSERT_EQ(economy.FindNearestStorageWithWood(town, glm::vec3(0.0f)), keptPit);
+
+	// The piles going away after their pit aren't taken away twice
+	economy.Remove(woodPile);
+	economy.Remove(foodPile);
+	ASSERT_EQ(economy.GetStock(town).wood, expected.wood);
+	ASSERT_EQ(economy.GetStock(town).food, expected.food);
+}
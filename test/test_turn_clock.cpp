@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <TurnClock.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace std::chrono_literals;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTurnClock, catchesUpOnSlowFrames)
+{
+	TurnClock clock(100ms);
+	clock.SetMaxTurnsPerFrame(3);
+
+	ASSERT_EQ(clock.Advance(60ms), 0);
+	// The time of the frames without a turn is kept
+	ASSERT_EQ(clock.Advance(60ms), 1);
+	clock.ConsumeTurn();
+	ASSERT_EQ(clock.GetLag(), 20ms);
+
+	ASSERT_EQ(clock.Advance(250ms), 2);
+	clock.ConsumeTurn();
+	clock.ConsumeTurn();
+	ASSERT_EQ(clock.GetLag(), 70ms);
+
+	// Past the cap the game slows down instead of owing more turns
+	ASSERT_EQ(clock.Advance(1s), 3);
+	clock.ConsumeTurn();
+	ASSERT_EQ(clock.GetLag(), 200ms);
+
+	clock.SetSpeed(0.5f);
+	ASSERT_EQ(clock.GetTurnDuration(), 50ms);
+	ASSERT_EQ(clock.Advance(0ms), 3);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTurnClock, fastForwardIgnoresTime)
+{
+	TurnClock clock(100ms);
+	clock.SetFastForward(20);
+	ASSERT_EQ(clock.Advance(1ms), 20);
+	ASSERT_EQ(clock.Advance(10s), 20);
+	ASSERT_EQ(clock.GetLag(), 0ms);
+
+	clock.SetFastForward(0);
+	ASSERT_EQ(clock.Advance(150ms), 1);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestTurnClock, progressesThroughTurn)
+{
+	TurnClock clock(100ms);
+	ASSERT_EQ(clock.Advance(25ms), 0);
+	ASSERT_FLOAT_EQ(clock.GetProgress(), 0.25f);
+	ASSERT_EQ(clock.Advance(100ms), 1);
+	clock.ConsumeTurn();
+	ASSERT_FLOAT_EQ(clock.GetProgress(), 0.25f);
+
+	// Running behind draws the last turn
+	ASSERT_EQ(clock.Advance(1s), TurnClock::k_DefaultMaxTurnsPerFrame);
+	ASSERT_FLOAT_EQ(clock.GetProgress(), 1.0f);
+
+	clock.SetFastForward(20);
+	clock.Reset();
+	ASSERT_FLOAT_EQ(clock.GetProgress(), 1.0f);
+}
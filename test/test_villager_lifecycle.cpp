@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright (c) 2018-2023 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ECS/Archetypes/VillagerArchetype.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/VillagerLifecycleSystemInterface.h>
+#include <ECS/VillagerLifecycle.h>
+#include <Game.h>
+#include <LHScriptX/Script.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestVillagerLifecycle, advancesTensOfThousandsOfVillagers)
+{
+	constexpr uint32_t k_VillagerCount = 50000;
+	constexpr uint32_t k_TurnCount = 100;
+	constexpr VillagerLifecycle::Rates k_Rates {1.0f, 50.0f, 20.0f, 0.5f, 5.0f, 18};
+
+	std::vector<VillagerNeeds> needs(k_VillagerCount, {100.0f, 100.0f, 0, VillagerInfo::CelticHousewifeFemale});
+	std::vector<Villager::LifeStage> lifeStages(k_VillagerCount, Villager::LifeStage::Child);
+	for (uint32_t i = 0; i < k_VillagerCount; ++i)
+	{
+		needs[i].age = i % 20;
+	}
+
+	std::array<uint32_t, 3> eventCounts {};
+	for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+	{
+		for (auto& villager : needs)
+		{
+			if (const auto event = VillagerLifecycle::AdvanceTurn(villager, k_Rates))
+			{
+				++eventCounts.at(static_cast<size_t>(*event));
+			}
+		}
+	}
+	for (uint32_t i = 0; i < k_VillagerCount; ++i)
+	{
+		if (const auto event = VillagerLifecycle::AdvanceYear(needs[i], lifeStages[i], k_Rates))
+		{
+			++eventCounts.at(static_cast<size_t>(*event));
+		}
+	}
+
+	// Hungry from turn 51, starving from turn 81 and dead on turn 97
+	ASSERT_EQ(eventCounts[static_cast<size_t>(VillagerLifecycle::Event::Starving)], k_VillagerCount);
+	ASSERT_EQ(eventCounts[static_cast<size_t>(VillagerLifecycle::Event::Died)], k_VillagerCount);
+	ASSERT_FLOAT_EQ(needs[0].hunger, 0.0f);
+	ASSERT_FLOAT_EQ(needs[0].health, 0.0f);
+	// Every villager starts as a child, those aged 17 to 19 are old enough after a year
+	ASSERT_EQ(eventCounts[static_cast<size_t>(VillagerLifecycle::Event::GrewUp)], k_VillagerCount / 20 * 3);
+	ASSERT_EQ(lifeStages[17], Villager::LifeStage::Adult);
+	ASSERT_EQ(lifeStages[16], Villager::LifeStage::Child);
+}
+
+class VillagerLifecycleOnMockLevel: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+		openblack::lhscriptx::Script script;
+		script.Load(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+)"""");
+	}
+	void TearDown() override { _game.reset(); }
+
+	std::unique_ptr<openblack::Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(VillagerLifecycleOnMockLevel, updatesTensOfThousandsOfRegistryVillagers)
+{
+	constexpr uint32_t k_VillagerCount = 50'000;
+	constexpr uint32_t k_StarvedEvery = 10;
+	// Fed villagers are still at half their food by the end
+	constexpr uint32_t k_TurnCount = 50;
+
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& lifecycle = Locator::villagerLifecycleSystem::value();
+
+	std::vector<entt::entity> villagers(k_VillagerCount);
+	for (uint32_t i = 0; i < k_VillagerCount; ++i)
+	{
+		const auto position = glm::vec3(static_cast<float>(i % 256) * 10.0f, 0.0f, static_cast<float>(i / 256) * 10.0f);
+		villagers[i] = archetypes::VillagerArchetype::Create(position, position, VillagerInfo::CelticHousewifeFemale, i % 60);
+		// Starved villagers die on the first turn
+		if (i % k_StarvedEvery == 0)
+		{
+			auto& needs = registry.Get<VillagerNeeds>(villagers[i]);
+			needs.hunger = 0.0f;
+			needs.health = 1.0f;
+		}
+	}
+
+	std::array<uint32_t, 3> eventCounts {};
+	int64_t totalTime = 0;
+	int64_t firstTurnTime = 0;
+	for (uint32_t turn = 0; turn < k_TurnCount; ++turn)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		lifecycle.Update();
+		const auto time =
+		    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		totalTime += time;
+		if (turn == 0)
+		{
+			firstTurnTime = time;
+		}
+		for (const auto& event : lifecycle.GetEvents())
+		{
+			++eventCounts.at(static_cast<size_t>(event.type));
+		}
+	}
+	RecordProperty("villagers", std::to_string(k_VillagerCount));
+	RecordProperty("first_turn_us", std::to_string(firstTurnTime));
+	RecordProperty("mean_turn_us", std::to_string(totalTime / k_TurnCount));
+
+	// Only the starved villagers died, and they are gone from the registry
+	ASSERT_EQ(eventCounts[static_cast<size_t>(VillagerLifecycle::Event::Died)], k_VillagerCount / k_StarvedEvery);
+	ASSERT_EQ(registry.Size<VillagerNeeds>(), k_VillagerCount - k_VillagerCount / k_StarvedEvery);
+	for (uint32_t i = 0; i < k_VillagerCount; ++i)
+	{
+		ASSERT_EQ(registry.Valid(villagers[i]), i % k_StarvedEvery != 0);
+	}
+	// The others lose a unit of food a turn without going hungry
+	ASSERT_EQ(eventCounts[static_cast<size_t>(VillagerLifecycle::Event::Starving)], 0u);
+	ASSERT_FLOAT_EQ(registry.Get<VillagerNeeds>(villagers[1]).hunger, 50.0f);
+	ASSERT_FLOAT_EQ(registry.Get<VillagerNeeds>(villagers[1]).health, 100.0f);
+}